@@ -130,18 +130,20 @@ void    ImGuiTestContext::LogExV(ImGuiTestVerboseLevel level, ImGuiTestLogFlags
         return;
 
     ImGuiTestLog* log = &ctx->TestOutput->Log;
-    const int prev_size = log->Buffer.size();
 
-    //const char verbose_level_char = ImGuiTestEngine_GetVerboseLevelName(level)[0];
-    //if (flags & ImGuiTestLogFlags_NoHeader)
-    //    log->Buffer.appendf("[%c] ", verbose_level_char);
-    //else
-    //    log->Buffer.appendf("[%c] [%04d] ", verbose_level_char, ctx->FrameCount);
-    if ((flags & ImGuiTestLogFlags_NoHeader) == 0)
-        log->Buffer.appendf("[%04d] ", ctx->FrameCount);
+    // Messages which are not output right now may be formatted later, if ever (see ConfigLogDeferredFormatting)
+    if (EngineIO->ConfigLogDeferredFormatting)
+    {
+        const bool output_to_tty = EngineIO->ConfigLogToTTY && (EngineIO->ConfigVerboseLevel >= level || TestOutput->Status == ImGuiTestStatus_Error);
+        const bool output_to_debugger = EngineIO->ConfigLogToDebugger && EngineIO->ConfigVerboseLevel >= level;
+        if (!output_to_tty && !output_to_debugger)
+            if (log->AddDeferred(level, flags, ctx->FrameCount, ctx->ActionDepth, fmt, args))
+                return;
+        log->FlushDeferred();
+    }
 
-    if (level >= ImGuiTestVerboseLevel_Debug)
-        log->Buffer.appendf("-- %*s", ImMax(0, (ctx->ActionDepth - 1) * 2), "");
+    const int prev_size = log->Buffer.size();
+    log->AppendLineHeader(level, flags, ctx->FrameCount, ctx->ActionDepth);
     log->Buffer.appendfv(fmt, args);
     log->Buffer.append("\n");
 
@@ -222,6 +224,13 @@ void    ImGuiTestContext::LogToTTY(ImGuiTestVerboseLevel level, const char* mess
         return;
     }
 
+    // Let log output thread do the actual writing
+    if (EngineIO->ConfigLogAsyncOutput)
+    {
+        ImGuiTestEngine_PushLogOutput(Engine, ImGuiTestLogOutputTarget_TTY, level, nullptr, message, message_end);
+        return;
+    }
+
     switch (level)
     {
     case ImGuiTestVerboseLevel_Warning:
@@ -252,27 +261,37 @@ void        ImGuiTestContext::LogToDebugger(ImGuiTestVerboseLevel level, const c
     if (EngineIO->ConfigVerboseLevel < level)
         return;
 
+    const char* prefix = nullptr;
     switch (level)
     {
     default:
         break;
     case ImGuiTestVerboseLevel_Error:
-        ImOsOutputDebugString("[error] ");
+        prefix = "[error] ";
         break;
     case ImGuiTestVerboseLevel_Warning:
-        ImOsOutputDebugString("[warn.] ");
+        prefix = "[warn.] ";
         break;
     case ImGuiTestVerboseLevel_Info:
-        ImOsOutputDebugString("[info ] ");
+        prefix = "[info ] ";
         break;
     case ImGuiTestVerboseLevel_Debug:
-        ImOsOutputDebugString("[debug] ");
+        prefix = "[debug] ";
         break;
     case ImGuiTestVerboseLevel_Trace:
-        ImOsOutputDebugString("[trace] ");
+        prefix = "[trace] ";
         break;
     }
 
+    // Let log output thread do the actual writing
+    if (EngineIO->ConfigLogAsyncOutput)
+    {
+        ImGuiTestEngine_PushLogOutput(Engine, ImGuiTestLogOutputTarget_Debugger, level, prefix, message);
+        return;
+    }
+
+    if (prefix)
+        ImOsOutputDebugString(prefix);
     ImOsOutputDebugString(message);
 }
 
@@ -850,20 +869,14 @@ bool ImGuiTestContext::CaptureEndVideo()
     return ret;
 }
 
-// Handle wildcard search on the TestFunc side.
-// Results will be resolved on the Gui side via the following call-chain:
-//   IMGUI_TEST_ENGINE_ITEM_INFO() -> ImGuiTestEngineHook_ItemInfo() -> ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel()
-ImGuiID ImGuiTestContext::ItemInfoHandleWildcardSearch(const char* wildcard_prefix_start, const char* wildcard_prefix_end, const char* wildcard_suffix_start)
+// Setup a FindByLabel task for a "prefix/**/suffix" wildcard path
+static void ItemInfoSetupWildcardTask(ImGuiTestContext* ctx, ImGuiTestFindByLabelTask* task, const char* wildcard_prefix_start, const char* wildcard_prefix_end, const char* wildcard_suffix_start)
 {
-    LogDebug("Wildcard matching..");
-
-    // Wildcard matching
     // Note that task->InPrefixId may be 0 as well (= we don't know the window)
-    ImGuiTestFindByLabelTask* task = &Engine->FindByLabelTask;
     if (wildcard_prefix_start < wildcard_prefix_end)
-        task->InPrefixId = ImHashDecoratedPath(wildcard_prefix_start, wildcard_prefix_end, RefID);
+        task->InPrefixId = ImHashDecoratedPath(wildcard_prefix_start, wildcard_prefix_end, ctx->RefID);
     else
-        task->InPrefixId = RefID;
+        task->InPrefixId = ctx->RefID;
     task->OutItemId = 0;
 
     // Advance pointer to point it to the last label
@@ -878,6 +891,27 @@ ImGuiID ImGuiTestContext::ItemInfoHandleWildcardSearch(const char* wildcard_pref
     for (const char* c = wildcard_suffix_start; *c; c++)
         if (*c == '/')
             task->InSuffixDepth++;
+}
+
+// Handle wildcard search on the TestFunc side.
+// Results will be resolved on the Gui side via the following call-chain:
+//   IMGUI_TEST_ENGINE_ITEM_INFO() -> ImGuiTestEngineHook_ItemInfo() -> ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel()
+ImGuiID ImGuiTestContext::ItemInfoHandleWildcardSearch(const char* wildcard_prefix_start, const char* wildcard_prefix_end, const char* wildcard_suffix_start)
+{
+    LogDebug("Wildcard matching..");
+
+    // Wildcard matching
+    ImGuiTestFindByLabelTask* task = ImGuiTestEngine_AddFindByLabelTask(Engine);
+    IM_ASSERT(task != nullptr && "All FindByLabel tasks are in use!");
+    ItemInfoSetupWildcardTask(this, task, wildcard_prefix_start, wildcard_prefix_end, wildcard_suffix_start);
+
+    // Try to resolve from recently submitted labels without yielding
+    if (Engine->IO.ConfigLabelIndex)
+        if (ImGuiID full_id = ImGuiTestEngine_LabelIndexFind(Engine, task))
+        {
+            ImGuiTestEngine_RemoveFindByLabelTask(Engine, task);
+            return full_id;
+        }
 
     int retries = 0;
     while (retries < 2 && task->OutItemId == 0)
@@ -886,11 +920,24 @@ ImGuiID ImGuiTestContext::ItemInfoHandleWildcardSearch(const char* wildcard_pref
         retries++;
     }
 
-    // Wildcard matching requires item to be visible, because clipped items are unaware of their labels. Try panning through entire window, searching for target item.
+    // Wildcard matching requires item to be visible, because clipped items are unaware of their labels.
+    // Ask engine to disable clipping for a few frames: clipped items and ImGuiListClipper ranges will be submitted and report their labels, without touching scrolling.
+    if (task->OutItemId == 0)
+    {
+        LogDebug("Wildcard matching with clipping disabled..");
+        task->InNoClip = true;
+        retries = 0;
+        while (retries < 2 && task->OutItemId == 0)
+        {
+            ImGuiTestEngine_Yield(Engine);
+            retries++;
+        }
+        task->InNoClip = false;
+    }
+
+    // Fallback for code doing its own clipping: try panning through entire window, searching for target item.
     // (Scrollbar position restoration in theory may be desirable, however it interferes with typical use of found item)
     // FIXME-TESTS: This doesn't recurse properly into each child..
-    // FIXME: Down the line if we refactor ItemAdd() return value to distinguish render-clipping vs logic-clipping etc, we should instead temporarily enable a "no clip"
-    // mode without the need for scrolling.
     if (task->OutItemId == 0)
     {
         ImGuiTestItemInfo base_item = ItemInfo(task->InPrefixId, ImGuiTestOpFlags_NoError);
@@ -921,12 +968,8 @@ ImGuiID ImGuiTestContext::ItemInfoHandleWildcardSearch(const char* wildcard_pref
     }
     ImGuiID full_id = task->OutItemId;
 
-    // FIXME: InFilterItemStatusFlags is intentionally not cleared here, because it is set in ItemAction() and reused in later calls to ItemInfo() to resolve ambiguities.
-    task->InPrefixId = 0;
-    task->InSuffix = task->InSuffixLastItem = nullptr;
-    task->InSuffixLastItemHash = 0;
-    task->InSuffixDepth = 0;
-    task->OutItemId = 0;    // -V1048   // Variable 'OutItemId' was assigned the same value. False-positive, because value of OutItemId could be modified from other thread during ImGuiTestEngine_Yield() call.
+    // Note that InFilterItemStatusFlags is not owned by the task: it is copied from Engine->FindByLabelFilterItemStatusFlags which is set in ItemAction().
+    ImGuiTestEngine_RemoveFindByLabelTask(Engine, task);
 
     return full_id;
 }
@@ -1010,6 +1053,137 @@ ImGuiTestItemInfo ImGuiTestContext::ItemInfo(ImGuiTestRef ref, ImGuiTestOpFlags
     return ItemInfoNull();
 }
 
+// Same as calling ItemInfo() on each ref, but all queries are submitted together so they are resolved over the same frames,
+// instead of yielding up to 2 frames per ref. Items not found are set to ItemInfoNull().
+// - Wildcard refs ("**/") are searched concurrently. Those which are not visible fall back to an individual ItemInfo() call.
+// Supported values for ImGuiTestOpFlags:
+// - ImGuiTestOpFlags_NoError
+int ImGuiTestContext::ItemInfoBatch(const ImGuiTestRef* refs, int count, ImGuiTestItemInfo* out_items, ImGuiTestOpFlags flags)
+{
+    IM_ASSERT(count >= 0);
+    for (int n = 0; n < count; n++)
+        out_items[n] = ItemInfoNull();
+    if (IsError())
+        return 0;
+
+    const ImGuiTestOpFlags SUPPORTED_FLAGS = ImGuiTestOpFlags_NoError;
+    IM_ASSERT((flags & ~SUPPORTED_FLAGS) == 0);
+
+    IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
+    int found_count = 0;
+
+    // Compute IDs. Resolved entries are marked by setting their full_ids[] to 0.
+    const ImGuiTestArenaMarker arena_marker = Arena->GetMarker();
+    ImGuiID* full_ids = Arena->AllocArray<ImGuiID>(count);
+    for (int n = 0; n < count; n++)
+        full_ids[n] = (refs[n].Path && strstr(refs[n].Path, "**/") != nullptr) ? 0 : GetID(refs[n]);
+
+    // Wildcard refs: run searches concurrently (up to IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS at a time).
+    // Refs not found without scrolling fall back to a regular ItemInfo() call.
+    for (int n = 0; n < count; )
+    {
+        ImGuiTestFindByLabelTask* tasks[IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS];
+        int tasks_refs[IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS];
+        int tasks_count = 0;
+        for (; n < count && tasks_count < IM_ARRAYSIZE(tasks); n++)
+        {
+            const char* p = (full_ids[n] == 0 && refs[n].Path) ? strstr(refs[n].Path, "**/") : nullptr;
+            if (p == nullptr)
+                continue;
+            ImGuiTestFindByLabelTask* task = ImGuiTestEngine_AddFindByLabelTask(Engine);
+            if (task == nullptr)
+                break;
+            ItemInfoSetupWildcardTask(this, task, refs[n].Path, p, p + 3);
+            if (Engine->IO.ConfigLabelIndex)
+                if ((full_ids[n] = ImGuiTestEngine_LabelIndexFind(Engine, task)) != 0)
+                {
+                    ImGuiTestEngine_RemoveFindByLabelTask(Engine, task);
+                    continue;
+                }
+            tasks[tasks_count] = task;
+            tasks_refs[tasks_count++] = n;
+        }
+        if (tasks_count == 0)
+        {
+            IM_ASSERT(n == count && "All FindByLabel tasks are in use!");
+            break;
+        }
+
+        LogDebug("Wildcard matching %d refs..", tasks_count);
+        for (int retries = 0; retries < 2; retries++)
+        {
+            bool all_found = true;
+            for (int task_n = 0; task_n < tasks_count && all_found; task_n++)
+                all_found = (tasks[task_n]->OutItemId != 0);
+            if (all_found)
+                break;
+            ImGuiTestEngine_Yield(Engine);
+        }
+        for (int task_n = 0; task_n < tasks_count; task_n++)
+        {
+            const int ref_n = tasks_refs[task_n];
+            full_ids[ref_n] = tasks[task_n]->OutItemId;
+            ImGuiTestEngine_RemoveFindByLabelTask(Engine, tasks[task_n]);
+            if (full_ids[ref_n] == 0)
+            {
+                out_items[ref_n] = ItemInfo(refs[ref_n], flags);
+                if (out_items[ref_n].ID != 0)
+                    found_count++;
+            }
+        }
+        if (IsError())
+        {
+            Arena->ResetToMarker(arena_marker);
+            return found_count;
+        }
+    }
+
+    // Same retry policy as ItemInfo() for each ref, while sharing frames: a ref is looked up at most 2 times
+    // (3 times if its window was appearing) with a yield after each miss, and no lookup after the last yield.
+    bool* appearing_retried = Arena->AllocArray<bool>(count);
+    for (int n = 0; n < count; n++)
+        appearing_retried[n] = false;
+    for (int retries = 0; ; retries++)
+    {
+        int pending_count = 0;
+        for (int n = 0; n < count; n++)
+        {
+            const int max_retries = appearing_retried[n] ? 3 : 2;
+            if (full_ids[n] == 0 || retries >= max_retries)
+                continue;
+            ImGuiTestItemInfo* item = ImGuiTestEngine_FindItemInfo(Engine, full_ids[n], refs[n].Path);
+
+            // While a window is appearing it is likely to be resizing and items moving. Wait an extra frame for things to settle.
+            if (item && item->Window && item->Window->Appearing && !appearing_retried[n])
+            {
+                item = nullptr;
+                appearing_retried[n] = true;
+            }
+            if (item)
+            {
+                out_items[n] = *item;
+                full_ids[n] = 0;
+                found_count++;
+            }
+            else
+            {
+                pending_count++;
+            }
+        }
+        if (pending_count == 0)
+            break;
+        ImGuiTestEngine_Yield(Engine);
+    }
+
+    // Refs still pending have run out of retries
+    for (int n = 0; n < count; n++)
+        if (full_ids[n] != 0)
+            ItemInfoErrorLog(this, refs[n], full_ids[n], flags);
+
+    Arena->ResetToMarker(arena_marker);
+    return found_count;
+}
+
 // Supported values for ImGuiTestOpFlags:
 // - ImGuiTestOpFlags_NoError
 ImGuiTestItemInfo ImGuiTestContext::ItemInfoOpenFullPath(ImGuiTestRef ref, ImGuiTestOpFlags flags)
@@ -2528,7 +2702,7 @@ void    ImGuiTestContext::KeyDown(ImGuiKeyChord key_chord)
     if (EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Cinematic)
         SleepShort();
 
-    Inputs->Queue.push_back(ImGuiTestInput::ForKeyChord(key_chord, true));
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForKeyChord(key_chord, true));
     Yield();
     Yield();
 }
@@ -2549,7 +2723,7 @@ void    ImGuiTestContext::KeyUp(ImGuiKeyChord key_chord)
     if (EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Cinematic)
         SleepShort();
 
-    Inputs->Queue.push_back(ImGuiTestInput::ForKeyChord(key_chord, false));
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForKeyChord(key_chord, false));
     Yield();
     Yield();
 }
@@ -2573,12 +2747,12 @@ void    ImGuiTestContext::KeyPress(ImGuiKeyChord key_chord, int count)
     while (count > 0)
     {
         count--;
-        Inputs->Queue.push_back(ImGuiTestInput::ForKeyChord(key_chord, true));
+        ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForKeyChord(key_chord, true));
         if (EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Cinematic)
             SleepShort();
         else
             Yield();
-        Inputs->Queue.push_back(ImGuiTestInput::ForKeyChord(key_chord, false));
+        ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForKeyChord(key_chord, false));
         Yield();
 
         // Give a frame for items to react
@@ -2602,9 +2776,9 @@ void    ImGuiTestContext::KeyHold(ImGuiKeyChord key_chord, float time)
     if (EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Cinematic)
         SleepStandard();
 
-    Inputs->Queue.push_back(ImGuiTestInput::ForKeyChord(key_chord, true));
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForKeyChord(key_chord, true));
     SleepNoSkip(time, 1 / 100.0f);
-    Inputs->Queue.push_back(ImGuiTestInput::ForKeyChord(key_chord, false));
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForKeyChord(key_chord, false));
     Yield(); // Give a frame for items to react
 }
 
@@ -2622,7 +2796,7 @@ void    ImGuiTestContext::KeySetEx(ImGuiKeyChord key_chord, bool is_down, float
     ImGui::GetKeyChordName(key_chord, chord_desc, IM_ARRAYSIZE(chord_desc));
 #endif
     LogDebug("KeySetEx(%s, is_down=%d, time=%.f)", chord_desc, is_down, time);
-    Inputs->Queue.push_back(ImGuiTestInput::ForKeyChord(key_chord, is_down));
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForKeyChord(key_chord, is_down));
     if (time > 0.0f)
         SleepNoSkip(time, 1.0f / 100.0f);
 }
@@ -2633,21 +2807,62 @@ void    ImGuiTestContext::KeyChars(const char* chars)
         return;
 
     IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
-    LogDebug("KeyChars('%s')", chars);
+    const int log_len_max = 256;
+    const int chars_len = (int)strlen(chars);
+    if (chars_len > log_len_max)
+        LogDebug("KeyChars('%.*s'.. %d bytes)", log_len_max, chars, chars_len);
+    else
+        LogDebug("KeyChars('%s')", chars);
     if (EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Cinematic)
         SleepStandard();
 
+    // Fast mode: hand the whole UTF-8 buffer to Dear ImGui in one go (like a paste), so large inputs don't cost one queued input per character.
+    // Text is copied into the test arena as the input is applied on a later frame.
+    // Codepoints which don't fit in ImWchar are dropped while copying, as they are when typing characters one by one.
+    if (EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Fast)
+    {
+        if (chars_len > 0)
+        {
+            char* chars_copy = (char*)Arena->Alloc((size_t)chars_len + 1, 1);
+            char* chars_copy_end = chars_copy;
+            for (const char* p = chars; *p; )
+            {
+                unsigned int c = 0;
+                int bytes_count = ImTextCharFromUtf8(&c, p, nullptr);
+                if (c <= IM_UNICODE_CODEPOINT_MAX)
+                {
+                    memcpy(chars_copy_end, p, (size_t)bytes_count);
+                    chars_copy_end += bytes_count;
+                }
+                p += bytes_count;
+            }
+            *chars_copy_end = 0;
+            ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForText(chars_copy));
+        }
+        Yield();
+        return;
+    }
+
+    // Queue all characters at once, timestamped at typing speed.
+    // Characters are applied on the frame reaching their timestamp, so more than one may be typed per frame.
+    const float typing_delay = 1.0f / EngineIO->TypingSpeed;
+    double time = UiContext->Time;
+    int chars_count = 0;
     while (*chars)
     {
         unsigned int c = 0;
         int bytes_count = ImTextCharFromUtf8(&c, chars, nullptr);
         chars += bytes_count;
-        if (c > 0 && c <= 0xFFFF)
-            Inputs->Queue.push_back(ImGuiTestInput::ForChar((ImWchar)c));
-
-        if (EngineIO->ConfigRunSpeed != ImGuiTestRunSpeed_Fast)
-            Sleep(1.0f / EngineIO->TypingSpeed);
+        if (c > 0 && c <= IM_UNICODE_CODEPOINT_MAX)
+        {
+            ImGuiTestInput input = ImGuiTestInput::ForChar(c);
+            input.Time = time;
+            ImGuiTestEngine_PushInput(Engine, input);
+        }
+        time += typing_delay;
+        chars_count++;
     }
+    Sleep(typing_delay * chars_count);
     Yield();
 }
 
@@ -2716,45 +2931,75 @@ void    ImGuiTestContext::KeyCharsReplaceEnter(const char* chars)
 void    ImGuiTestContext::GatherItems(ImGuiTestItemList* out_list, ImGuiTestRef parent, int depth)
 {
     IM_ASSERT(out_list != nullptr);
+    GatherItemsBatch(out_list, &parent, 1, depth);
+}
+
+// Gather items from multiple parents during the same frames: out_lists[n] receives items of parents[n].
+void    ImGuiTestContext::GatherItemsBatch(ImGuiTestItemList* out_lists, const ImGuiTestRef* parents, int count, int depth)
+{
+    IM_ASSERT(out_lists != nullptr && count >= 0);
     IM_ASSERT(depth > 0 || depth == -1);
 
     if (IsError())
         return;
 
-    ImGuiTestGatherTask* task = &Engine->GatherTask;
-    IM_ASSERT(task->InParentID == 0);
-    IM_ASSERT(task->LastItemInfo == nullptr);
-
-    // Register gather tasks
+    IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
     if (depth == -1)
         depth = 99;
-    if (parent.ID == 0)
-        parent.ID = GetID(parent);
-    task->InParentID = parent.ID;
-    task->InMaxDepth = depth;
-    task->InLayerMask = (1 << ImGuiNavLayer_Main);
-    task->OutList = out_list;
-
-    // Keep running while gathering
-    // The corresponding hook is ItemAdd() -> ImGuiTestEngineHook_ItemAdd() -> ImGuiTestEngineHook_ItemAdd_GatherTask()
-    const int begin_gather_size = out_list->GetSize();
-    while (true)
+
+    // Process in chunks if there are more parents than available tasks
+    for (int chunk_start = 0; chunk_start < count; )
     {
-        const int begin_gather_size_for_frame = out_list->GetSize();
-        Yield();
-        const int end_gather_size_for_frame = out_list->GetSize();
-        if (begin_gather_size_for_frame == end_gather_size_for_frame)
-            break;
-    }
-    const int end_gather_size = out_list->GetSize();
+        // Register gather tasks
+        ImGuiTestGatherTask* tasks[IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS];
+        int begin_gather_sizes[IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS];
+        int tasks_count = 0;
+        while (chunk_start + tasks_count < count && tasks_count < IM_ARRAYSIZE(tasks))
+        {
+            ImGuiTestGatherTask* task = ImGuiTestEngine_AddGatherTask(Engine);
+            if (task == nullptr)
+                break;
+            const int n = chunk_start + tasks_count;
+            task->InParentID = parents[n].ID ? parents[n].ID : GetID(parents[n]);
+            task->InMaxDepth = depth;
+            task->InLayerMask = (1 << ImGuiNavLayer_Main);
+            task->OutList = &out_lists[n];
+            begin_gather_sizes[tasks_count] = out_lists[n].GetSize();
+            tasks[tasks_count++] = task;
+        }
+        IM_ASSERT(tasks_count > 0 && "All Gather tasks are in use!");
 
-    // FIXME-TESTS: To support filter we'd need to process the list here,
-    // Because ImGuiTestItemList is a pool (ImVector + map ID->index) we'll need to filter, rewrite, rebuild map
+        // Keep running while gathering
+        // The corresponding hook is ItemAdd() -> ImGuiTestEngineHook_ItemAdd() -> ImGuiTestEngineHook_ItemAdd_GatherTask()
+        while (true)
+        {
+            int begin_gather_size_for_frame = 0;
+            for (int task_n = 0; task_n < tasks_count; task_n++)
+                begin_gather_size_for_frame += tasks[task_n]->OutList->GetSize();
+            Yield();
+            int end_gather_size_for_frame = 0;
+            for (int task_n = 0; task_n < tasks_count; task_n++)
+                end_gather_size_for_frame += tasks[task_n]->OutList->GetSize();
+            if (begin_gather_size_for_frame == end_gather_size_for_frame)
+                break;
+        }
+        for (int task_n = 0; task_n < tasks_count; task_n++)
+            ImGuiTestEngine_RemoveGatherTask(Engine, tasks[task_n]);
 
-    ImGuiTestItemInfo parent_item = ItemInfo(parent, ImGuiTestOpFlags_NoError);
-    LogDebug("GatherItems from %s, %d deep: found %d items.", ImGuiTestRefDesc(parent, parent_item).c_str(), depth, end_gather_size - begin_gather_size);
+        // FIXME-TESTS: To support filter we'd need to process the list here,
+        // Because ImGuiTestItemList is a pool (ImVector + map ID->index) we'll need to filter, rewrite, rebuild map
 
-    task->Clear();
+        const ImGuiTestArenaMarker arena_marker = Arena->GetMarker();
+        ImGuiTestItemInfo* parent_items = Arena->AllocArray<ImGuiTestItemInfo>(tasks_count);
+        ItemInfoBatch(parents + chunk_start, tasks_count, parent_items, ImGuiTestOpFlags_NoError);
+        for (int task_n = 0; task_n < tasks_count; task_n++)
+        {
+            const int n = chunk_start + task_n;
+            LogDebug("GatherItems from %s, %d deep: found %d items.", ImGuiTestRefDesc(parents[n], parent_items[task_n]).c_str(), depth, out_lists[n].GetSize() - begin_gather_sizes[task_n]);
+        }
+        Arena->ResetToMarker(arena_marker);
+        chunk_start += tasks_count;
+    }
 }
 
 // Supported values for ImGuiTestOpFlags:
@@ -2779,9 +3024,9 @@ void    ImGuiTestContext::ItemAction(ImGuiTestAction action, ImGuiTestRef ref, I
         // These flags are not cleared by ItemInfo() because ItemAction() may call ItemInfo() again to get same item and thus it
         // needs these flags to remain in place.
         if (action == ImGuiTestAction_Check || action == ImGuiTestAction_Uncheck)
-            Engine->FindByLabelTask.InFilterItemStatusFlags = ImGuiItemStatusFlags_Checkable;
+            Engine->FindByLabelFilterItemStatusFlags = ImGuiItemStatusFlags_Checkable;
         else if (action == ImGuiTestAction_Open || action == ImGuiTestAction_Close)
-            Engine->FindByLabelTask.InFilterItemStatusFlags = ImGuiItemStatusFlags_Openable;
+            Engine->FindByLabelFilterItemStatusFlags = ImGuiItemStatusFlags_Openable;
     }
 
     // Find item
@@ -2912,7 +3157,7 @@ void    ImGuiTestContext::ItemAction(ImGuiTestAction action, ImGuiTestRef ref, I
     }
 
     //if (is_wildcard)
-        Engine->FindByLabelTask.InFilterItemStatusFlags = ImGuiItemStatusFlags_None;
+        Engine->FindByLabelFilterItemStatusFlags = ImGuiItemStatusFlags_None;
 }
 
 void    ImGuiTestContext::ItemActionAll(ImGuiTestAction action, ImGuiTestRef ref_parent, const ImGuiTestActionFilter* filter)
@@ -3958,7 +4203,7 @@ void    ImGuiTestContext::ViewportPlatform_SetWindowPos(ImGuiViewport* viewport,
 
     IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
     LogDebug("ViewportPlatform_SetWindowPos(0x%08X, {%.2f,%.2f)", viewport->ID, pos.x, pos.y);
-    Inputs->Queue.push_back(ImGuiTestInput::ForViewportSetPos(viewport->ID, pos)); // Queued since this will poke into backend, best to do in main thread.
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForViewportSetPos(viewport->ID, pos)); // Queued since this will poke into backend, best to do in main thread.
     Yield(); // Submit to Platform
     Yield(); // Let Dear ImGui next frame see it
 }
@@ -3970,7 +4215,7 @@ void    ImGuiTestContext::ViewportPlatform_SetWindowSize(ImGuiViewport* viewport
 
     IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
     LogDebug("ViewportPlatform_SetWindowSize(0x%08X, {%.2f,%.2f)", viewport->ID, size.x, size.y);
-    Inputs->Queue.push_back(ImGuiTestInput::ForViewportSetSize(viewport->ID, size)); // Queued since this will poke into backend, best to do in main thread.
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForViewportSetSize(viewport->ID, size)); // Queued since this will poke into backend, best to do in main thread.
     Yield(); // Submit to Platform
     Yield(); // Let Dear ImGui next frame see it
 }
@@ -3983,7 +4228,7 @@ void    ImGuiTestContext::ViewportPlatform_SetWindowFocus(ImGuiViewport* viewpor
 
     IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
     LogDebug("ViewportPlatform_SetWindowFocus(0x%08X)", viewport->ID);
-    Inputs->Queue.push_back(ImGuiTestInput::ForViewportFocus(viewport->ID)); // Queued since this will poke into backend, best to do in main thread.
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForViewportFocus(viewport->ID)); // Queued since this will poke into backend, best to do in main thread.
     Yield(); // Submit to Platform
     Yield(); // Let Dear ImGui next frame see it
 }
@@ -3996,7 +4241,7 @@ void    ImGuiTestContext::ViewportPlatform_CloseWindow(ImGuiViewport* viewport)
 
     IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
     LogDebug("ViewportPlatform_CloseWindow(0x%08X)", viewport->ID);
-    Inputs->Queue.push_back(ImGuiTestInput::ForViewportClose(viewport->ID)); // Queued since this will poke into backend, best to do in main thread.
+    ImGuiTestEngine_PushInput(Engine, ImGuiTestInput::ForViewportClose(viewport->ID)); // Queued since this will poke into backend, best to do in main thread.
     Yield(); // Submit to Platform
     Yield(3); // Let Dear ImGui next frame see it
 }
@@ -4241,22 +4486,78 @@ void    ImGuiTestContext::UndockWindow(const char* window_name)
 // ImGuiTestContext - Performance Tools
 //-------------------------------------------------------------------------
 
-// Calculate the reference DeltaTime, averaged over PerfIterations/500 frames, with GuiFunc disabled.
+// Measure DeltaTime of PerfIterations frames into 'out_samples'.
+// When IO.ConfigPerfCounters is set, CPU time and hardware counters of the same frames are stored into 'out_counter_samples'.
+static void PerfMeasureFrames(ImGuiTestContext* ctx, ImVector<double>* out_samples, ImVector<ImGuiTestPerfCounterSample>* out_counter_samples)
+{
+    ImGuiTestPerfCounters* counters = &ctx->Engine->PerfCounters;
+    const bool measure_counters = ctx->EngineIO->ConfigPerfCounters;
+    out_samples->reserve(ctx->PerfIterations);
+    out_samples->resize(0);
+    out_counter_samples->reserve(measure_counters ? ctx->PerfIterations : 0);
+    out_counter_samples->resize(0);
+    counters->Frame = ImGuiTestPerfCounterSample();
+    ctx->PerfMeasuring = true;
+    for (int n = 0; n < ctx->PerfIterations && !ctx->Abort; n++)
+    {
+        ctx->Yield();
+        out_samples->push_back(ctx->UiContext->IO.DeltaTime);
+        if (measure_counters)
+        {
+            out_counter_samples->push_back(counters->Frame);
+            counters->Frame = ImGuiTestPerfCounterSample();
+        }
+    }
+    ctx->PerfMeasuring = false;
+}
+
+// Calculate statistics of 'samples' without reordering them (sorting is done on a copy in ctx->Arena)
+static void PerfCalcStats(ImGuiTestContext* ctx, const ImVector<double>& samples, ImStatsSummary* out_stats)
+{
+    ImGuiTestArenaMarker marker = ctx->Arena->GetMarker();
+    double* sorted_samples = ctx->Arena->AllocArray<double>(samples.Size);
+    memcpy(sorted_samples, samples.Data, (size_t)samples.Size * sizeof(double));
+    ImStatsCalcSummary(sorted_samples, samples.Size, out_stats);
+    ctx->Arena->ResetToMarker(marker);
+}
+
+// Calculate the reference DeltaTime over PerfIterations frames, with GuiFunc disabled.
+// Frames rejected as outliers (e.g. scheduler hiccups) are not included in the mean.
 void    ImGuiTestContext::PerfCalcRef()
 {
     LogDebug("Measuring ref dt...");
     RunFlags |= ImGuiTestRunFlags_GuiFuncDisable;
+    PerfMeasureFrames(this, &PerfRefSamples, &Engine->PerfCounters.RefSamples);
+    RunFlags &= ~ImGuiTestRunFlags_GuiFuncDisable;
+
+    ImStatsSummary stats;
+    PerfCalcStats(this, PerfRefSamples, &stats);
+    PerfRefDt = stats.Mean;
+}
 
-    ImMovingAverage<double> delta_times;
-    delta_times.Init(PerfIterations);
-    for (int n = 0; n < PerfIterations && !Abort; n++)
+// Per-frame value of one metric of counter samples: 0 = CPU time (ns), 1 + ImPerfCounter_XXX = hardware counter.
+// - Hardware counters use the median.
+// - CPU time uses total time divided by number of frames: on Windows GetThreadTimes() only advances on scheduler ticks (~15.6 ms),
+//   so most per-frame values are 0 and their median would be meaningless.
+static double PerfCalcCounterPerFrame(ImGuiTestContext* ctx, const ImVector<ImGuiTestPerfCounterSample>& samples, int metric)
+{
+    if (samples.Size == 0)
+        return 0.0;
+    if (metric == 0)
     {
-        Yield();
-        delta_times.AddSample(UiContext->IO.DeltaTime);
+        ImU64 total = 0;
+        for (const ImGuiTestPerfCounterSample& sample : samples)
+            total += sample.CpuTimeNs;
+        return (double)total / samples.Size;
     }
-
-    PerfRefDt = delta_times.GetAverage();
-    RunFlags &= ~ImGuiTestRunFlags_GuiFuncDisable;
+    ImGuiTestArenaMarker marker = ctx->Arena->GetMarker();
+    double* values = ctx->Arena->AllocArray<double>(samples.Size);
+    for (int n = 0; n < samples.Size; n++)
+        values[n] = (double)samples[n].Values[metric - 1];
+    ImStatsSummary stats;
+    ImStatsCalcSummary(values, samples.Size, &stats);
+    ctx->Arena->ResetToMarker(marker);
+    return stats.Median;
 }
 
 void    ImGuiTestContext::PerfCapture(const char* category, const char* test_name, const char* csv_file)
@@ -4269,21 +4570,44 @@ void    ImGuiTestContext::PerfCapture(const char* category, const char* test_nam
         PerfCalcRef();
     IM_ASSERT(PerfRefDt >= 0.0);
 
-    // Yield for the average to stabilize
+    // Keep every frame sample
     LogDebug("Measuring GUI dt...");
-    ImMovingAverage<double> delta_times;
-    delta_times.Init(PerfIterations);
-    for (int n = 0; n < PerfIterations && !Abort; n++)
-    {
-        Yield();
-        delta_times.AddSample(UiContext->IO.DeltaTime);
-    }
-    if (Abort)
+    PerfMeasureFrames(this, &PerfSamples, &Engine->PerfCounters.Samples);
+    if (Abort || PerfSamples.empty())
         return;
 
-    double dt_curr = delta_times.GetAverage();
+    // Reference statistics (PerfRefDt may have been set without calling PerfCalcRef())
+    ImStatsSummary stats_ref;
+    if (PerfRefSamples.Size > 0)
+        PerfCalcStats(this, PerfRefSamples, &stats_ref);
+    else
+        stats_ref.Mean = stats_ref.Median = PerfRefDt;
+    ImStatsSummary stats;
+    PerfCalcStats(this, PerfSamples, &stats);
+
     double dt_ref_ms = PerfRefDt * 1000;
-    double dt_delta_ms = (dt_curr - PerfRefDt) * 1000;
+    double dt_delta_ms = (stats.Mean - PerfRefDt) * 1000;
+    double dt_ci95_ms = sqrt(stats.CI95 * stats.CI95 + stats_ref.CI95 * stats_ref.CI95) * 1000; // Both means are independent
+
+    // CPU time and hardware counters: per-frame values relative to reference values
+    // (requires reference to be measured by PerfCalcRef() with IO.ConfigPerfCounters set)
+    ImGuiTestPerfCounters* counters = &Engine->PerfCounters;
+    double counters_delta[1 + ImPerfCounter_COUNT] = {};
+    const bool has_counters = counters->Samples.Size > 0 && counters->RefSamples.Size > 0;
+    const bool has_hw_counters = has_counters && counters->Group.IsOpen();
+    if (has_counters)
+        for (int metric = 0; metric < IM_ARRAYSIZE(counters_delta); metric++)
+            counters_delta[metric] = PerfCalcCounterPerFrame(this, counters->Samples, metric) - PerfCalcCounterPerFrame(this, counters->RefSamples, metric);
+
+    // A CPU clock which didn't advance over all measured frames (shorter than a scheduler tick) didn't measure anything
+    bool has_cpu_time = has_counters && counters->HasCpuTime;
+    if (has_cpu_time && PerfCalcCounterPerFrame(this, counters->Samples, 0) == 0.0)
+    {
+        LogWarning("[PERF] CPU time not recorded: thread CPU time didn't advance during measured frames.");
+        has_cpu_time = false;
+    }
+    else if (EngineIO->ConfigPerfCounters)
+        LogWarning("[PERF] CPU time and hardware counters not recorded: reference was not measured by PerfCalcRef().");
 
     const ImBuildInfo* build_info = ImBuildGetCompilationInfo();
 
@@ -4291,13 +4615,34 @@ void    ImGuiTestContext::PerfCapture(const char* category, const char* test_nam
     // FIXME-TESTS: Would be nice if we could submit a custom marker (e.g. branch/feature name)
     LogInfo("[PERF] Conditions: Stress x%d, %s, %s, %s, %s, %s",
         PerfStressAmount, build_info->Type, build_info->Cpu, build_info->OS, build_info->Compiler, build_info->Date);
-    LogInfo("[PERF] Result: %+6.3f ms (from ref %+6.3f)", dt_delta_ms, dt_ref_ms);
+    LogInfo("[PERF] Result: %+6.3f ms +/- %.3f (from ref %+6.3f)", dt_delta_ms, dt_ci95_ms, dt_ref_ms);
+    LogInfo("[PERF] Median: %+6.3f ms, P90: %+6.3f ms, P99: %+6.3f ms, %d/%d frames rejected as outliers",
+        (stats.Median - stats_ref.Median) * 1000, (stats.P90 - stats_ref.Median) * 1000, (stats.P99 - stats_ref.Median) * 1000, stats.OutlierCount, stats.Count);
+    if (has_hw_counters)
+        LogInfo("[PERF] Cycles: %+.0f, Instructions: %+.0f, Cache misses: %+.0f, Branch misses: %+.0f (median per frame)",
+            counters_delta[1 + ImPerfCounter_Cycles], counters_delta[1 + ImPerfCounter_Instructions],
+            counters_delta[1 + ImPerfCounter_CacheMisses], counters_delta[1 + ImPerfCounter_BranchMisses]);
+    if (has_cpu_time)
+        LogInfo("[PERF] CPU: %+6.3f ms (mean per frame)", counters_delta[0] / 1000000);
 
     ImGuiPerfToolEntry entry;
     entry.Timestamp = Engine->BatchStartTime;
     entry.Category = category ? category : Test->Category;
     entry.TestName = test_name ? test_name : Test->Name;
     entry.DtDeltaMs = dt_delta_ms;
+    entry.DtDeltaMsMedian = (stats.Median - stats_ref.Median) * 1000;
+    entry.DtDeltaMsP90 = (stats.P90 - stats_ref.Median) * 1000;
+    entry.DtDeltaMsP99 = (stats.P99 - stats_ref.Median) * 1000;
+    entry.DtDeltaMsCI95 = dt_ci95_ms;
+    entry.NumFrames = stats.Count;
+    entry.NumOutliers = stats.OutlierCount;
+    entry.CpuDeltaMs = has_cpu_time ? counters_delta[0] / 1000000 : 0.0;
+    entry.CyclesDelta = has_hw_counters ? counters_delta[1 + ImPerfCounter_Cycles] : 0.0;
+    entry.InstructionsDelta = has_hw_counters ? counters_delta[1 + ImPerfCounter_Instructions] : 0.0;
+    entry.CacheMissesDelta = has_hw_counters ? counters_delta[1 + ImPerfCounter_CacheMisses] : 0.0;
+    entry.BranchMissesDelta = has_hw_counters ? counters_delta[1 + ImPerfCounter_BranchMisses] : 0.0;
+    entry.NumCpuFrames = has_cpu_time ? counters->Samples.Size : 0;
+    entry.NumCounterFrames = has_hw_counters ? counters->Samples.Size : 0;
     entry.PerfStressAmount = PerfStressAmount;
     entry.GitBranchName = EngineIO->GitBranchName;
     entry.BuildType = build_info->Type;
@@ -4307,6 +4652,10 @@ void    ImGuiTestContext::PerfCapture(const char* category, const char* test_nam
     entry.Date = build_info->Date;
     ImGuiTestEngine_PerfToolAppendToCSV(Engine->PerfTool, &entry, csv_file);
 
+    // Mirror default log in binary format: import this entry, and any entry written to .csv log without updating binary log
+    if (csv_file == nullptr && EngineIO->ConfigPerfLogUpdateBinary)
+        ImGuiTestEngine_PerfToolUpdateBinaryLog();
+
     // Disable the "Success" message
     RunFlags |= ImGuiTestRunFlags_NoSuccessMsg;
 }
@@ -63,6 +63,7 @@ struct ImGuiTestEngineIO;           // Test Engine IO structure (configuration f
 struct ImGuiTestItemInfo;           // Information gathered about an item: label, status, bounding box etc.
 struct ImGuiTestItemList;           // Result of an GatherItems() query
 struct ImGuiTestInputs;             // Test Engine Simulated Inputs structure (opaque)
+struct ImGuiTestArena;              // Test Engine Arena allocator for transient per-test allocations (opaque)
 struct ImGuiTestGatherTask;         // Test Engine task for scanning/finding items
 struct ImGuiCaptureArgs;            // Parameters for ctx->CaptureXXX functions
 enum ImGuiTestVerboseLevel : int;
@@ -239,6 +240,7 @@ struct IMGUI_API ImGuiTestContext
 
     ImGuiTestEngine*        Engine = nullptr;
     ImGuiTestInputs*        Inputs = nullptr;
+    ImGuiTestArena*         Arena = nullptr;                        // Transient allocations, released in one step at the end of the test (== &engine->TestArena)
     ImGuiTestRunFlags       RunFlags = ImGuiTestRunFlags_None;
     ImGuiTestActiveFunc     ActiveFunc = ImGuiTestActiveFunc_None;  // None/GuiFunc/TestFunc
     double                  RunningTime = 0.0;                      // Amount of wall clock time the Test has been running. Used by safety watchdog.
@@ -246,8 +248,11 @@ struct IMGUI_API ImGuiTestContext
     int                     CaptureCounter = 0;                     // Number of captures
     int                     ErrorCounter = 0;                       // Number of errors (generally this maxxes at 1 as most functions will early out)
     bool                    Abort = false;
-    double                  PerfRefDt = -1.0;
+    double                  PerfRefDt = -1.0;                       // Reference DeltaTime (mean of PerfRefSamples excluding outliers)
     int                     PerfIterations = 400;                   // Number of frames for PerfCapture() measurements
+    ImVector<double>        PerfRefSamples;                         // DeltaTime of every frame measured by PerfCalcRef()
+    ImVector<double>        PerfSamples;                            // DeltaTime of every frame measured by last PerfCapture()
+    bool                    PerfMeasuring = false;                  // Set during PerfCalcRef()/PerfCapture() measurements (rendering is never skipped while measuring)
     char                    RefStr[256] = { 0 };                    // Reference window/path over which all named references are based
     ImGuiID                 RefID = 0;                              // Reference ID over which all named references are based
     ImGuiID                 RefWindowID = 0;                        // ID of a window that contains RefID item
@@ -412,9 +417,11 @@ struct IMGUI_API ImGuiTestContext
     // - You can use ImGuiTestOpFlags_NoError to do a query without marking context as errored. This is what ItemExists() does.
     ImGuiTestItemInfo   ItemInfo(ImGuiTestRef ref, ImGuiTestOpFlags flags = ImGuiTestOpFlags_None);
     ImGuiTestItemInfo   ItemInfoOpenFullPath(ImGuiTestRef ref, ImGuiTestOpFlags flags = ImGuiTestOpFlags_None);
+    int                 ItemInfoBatch(const ImGuiTestRef* refs, int count, ImGuiTestItemInfo* out_items, ImGuiTestOpFlags flags = ImGuiTestOpFlags_None); // Resolve 'count' refs in the same frames, return number of items found.
     ImGuiID             ItemInfoHandleWildcardSearch(const char* wildcard_prefix_start, const char* wildcard_prefix_end, const char* wildcard_suffix_start);
     ImGuiTestItemInfo   ItemInfoNull() { return ImGuiTestItemInfo(); }
     void                GatherItems(ImGuiTestItemList* out_list, ImGuiTestRef parent, int depth = -1);
+    void                GatherItemsBatch(ImGuiTestItemList* out_lists, const ImGuiTestRef* parents, int count, int depth = -1); // Gather from 'count' parents in the same frames.
 
     // Item/Widgets manipulation
     void        ItemAction(ImGuiTestAction action, ImGuiTestRef ref, ImGuiTestOpFlags flags = 0, void* action_arg = nullptr);
@@ -21,23 +21,120 @@
 
 #include "imgui_te_utils.h"
 #include "thirdparty/Str/Str.h"
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64))
+#include <intrin.h>     // _mm_pause(), __yield()
+#endif
+
+#ifndef IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_HANDOFF_POLICY
+#define IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_HANDOFF_POLICY    ImGuiTestCoroutineHandoffPolicy_Park
+#endif
+#ifndef IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_SPIN_COUNT
+#define IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_SPIN_COUNT        4096    // Iterations of cpu "pause" before parking. Roughly 10~100 us depending on CPU.
+#endif
+
+enum Coroutine_ImplStdThreadState
+{
+    Coroutine_ImplStdThreadState_Idle,          // Coroutine is not running: thread which called Run() owns execution
+    Coroutine_ImplStdThreadState_Running,       // Coroutine is running: coroutine thread owns execution
+    Coroutine_ImplStdThreadState_Terminated,    // Coroutine function returned
+};
 
 struct Coroutine_ImplStdThreadData
 {
     std::thread*            Thread;                 // The thread this coroutine is using
-    std::condition_variable StateChange;            // Condition variable notified when the coroutine state changes
-    std::mutex              StateMutex;             // Mutex to protect coroutine state
-    bool                    CoroutineRunning;       // Is the coroutine currently running? Lock StateMutex before access and notify StateChange on change
-    bool                    CoroutineTerminated;    // Has the coroutine terminated? Lock StateMutex before access and notify StateChange on change
+    std::atomic<int>        State;                  // Coroutine_ImplStdThreadState_XXX. The side owning execution changes it to hand execution to the other side.
+    std::atomic<bool>       CallerParked;           // Is the thread which called Run() blocked on StateChange? Write under StateMutex
+    std::atomic<bool>       CoroutineParked;        // Is the coroutine thread blocked on StateChange? Write under StateMutex
+    std::condition_variable StateChange;            // Condition variable notified when State changes and waiting side is parked
+    std::mutex              StateMutex;             // Mutex used with StateChange
+    int                     SpinCount;              // Number of spin iterations before parking (0 with ImGuiTestCoroutineHandoffPolicy_Park)
+    ImU64                   HandoffTimeNs;          // Time of last State change. Written before State by side releasing execution.
+    ImGuiTestCoroutineHandoffStats Stats;           // Written by side owning execution
     Str64                   Name;                   // The name of this coroutine
 };
 
 // The coroutine executing on the current thread (if it is a coroutine thread)
 static thread_local Coroutine_ImplStdThreadData* GThreadCoroutine = nullptr;
 
+// Handoff policy applied to new coroutines
+static ImGuiTestCoroutineHandoffPolicy GThreadCoroutineHandoffPolicy = IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_HANDOFF_POLICY;
+static int GThreadCoroutineSpinCount = IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_SPIN_COUNT;
+
+static inline ImU64 CoroutineThreadGetTimeNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Hint the CPU that we are in a spin-wait loop (lower power usage, leave resources to the other hyper-thread)
+static inline void CoroutineThreadCpuRelax()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+    __yield();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Hand execution to the other side (must be called by side owning execution)
+static void CoroutineThreadSetState(Coroutine_ImplStdThreadData* data, Coroutine_ImplStdThreadState state)
+{
+    data->HandoffTimeNs = CoroutineThreadGetTimeNs();
+    data->State.store(state);
+
+    // Parked flag is set by the waiting side before it checks State for the last time: one of us will see the other's write.
+    std::atomic<bool>& other_parked = (state == Coroutine_ImplStdThreadState_Running) ? data->CoroutineParked : data->CallerParked;
+    if (other_parked.load())
+    {
+        std::lock_guard<std::mutex> lock(data->StateMutex);
+        data->StateChange.notify_all();
+    }
+}
+
+// Wait until the other side changes State from 'state_from' (spin first, then park). Returns new state.
+static int CoroutineThreadWaitStateChange(Coroutine_ImplStdThreadData* data, Coroutine_ImplStdThreadState state_from)
+{
+    int state = state_from;
+    bool parked = false;
+    for (int n = 0; n < data->SpinCount; n++)
+    {
+        state = data->State.load(std::memory_order_acquire);
+        if (state != state_from)
+            break;
+        CoroutineThreadCpuRelax();
+    }
+    if (state == state_from)
+    {
+        std::atomic<bool>& parked_flag = (state_from == Coroutine_ImplStdThreadState_Idle) ? data->CoroutineParked : data->CallerParked;
+        std::unique_lock<std::mutex> lock(data->StateMutex);
+        parked_flag.store(true);
+        while ((state = data->State.load()) == state_from)
+            data->StateChange.wait(lock);
+        parked_flag.store(false);
+        parked = true;
+    }
+
+    // We now own execution
+    ImGuiTestCoroutineHandoffStats& stats = data->Stats;
+    const ImU64 latency_ns = CoroutineThreadGetTimeNs() - data->HandoffTimeNs;
+    stats.HandoffCount++;
+    if (parked)
+        stats.ParkHandoffCount++;
+    else
+        stats.SpinHandoffCount++;
+    stats.LatencyTotalNs += latency_ns;
+    stats.LatencyMaxNs = ImMax(stats.LatencyMaxNs, latency_ns);
+    return state;
+}
+
 // The main function for a coroutine thread
 static void CoroutineThreadMain(Coroutine_ImplStdThreadData* data, ImGuiTestCoroutineMainFunc func, void* ctx)
 {
@@ -48,25 +145,13 @@ static void CoroutineThreadMain(Coroutine_ImplStdThreadData* data, ImGuiTestCoro
     GThreadCoroutine = data;
 
     // Wait for initial Run()
-    while (1)
-    {
-        std::unique_lock<std::mutex> lock(data->StateMutex);
-        if (data->CoroutineRunning)
-            break;
-        data->StateChange.wait(lock);
-    }
+    CoroutineThreadWaitStateChange(data, Coroutine_ImplStdThreadState_Idle);
 
     // Run user code, which will then call Yield() when it wants to yield control
     func(ctx);
 
     // Mark as terminated
-    {
-        std::lock_guard<std::mutex> lock(data->StateMutex);
-
-        data->CoroutineTerminated = true;
-        data->CoroutineRunning = false;
-        data->StateChange.notify_all();
-    }
+    CoroutineThreadSetState(data, Coroutine_ImplStdThreadState_Terminated);
 }
 
 
@@ -75,8 +160,13 @@ static ImGuiTestCoroutineHandle Coroutine_ImplStdThread_Create(ImGuiTestCoroutin
     Coroutine_ImplStdThreadData* data = new Coroutine_ImplStdThreadData();
 
     data->Name = name;
-    data->CoroutineRunning = false;
-    data->CoroutineTerminated = false;
+    data->State = Coroutine_ImplStdThreadState_Idle;
+    data->CallerParked = false;
+    data->CoroutineParked = false;
+    data->SpinCount = (GThreadCoroutineHandoffPolicy == ImGuiTestCoroutineHandoffPolicy_SpinThenPark) ? GThreadCoroutineSpinCount : 0;
+    if (std::thread::hardware_concurrency() == 1)
+        data->SpinCount = 0; // Spinning on a single core only delays the other side
+    data->HandoffTimeNs = 0;
     data->Thread = new std::thread(CoroutineThreadMain, data, func, ctx);
 
     return (ImGuiTestCoroutineHandle)data;
@@ -86,7 +176,7 @@ static void Coroutine_ImplStdThread_Destroy(ImGuiTestCoroutineHandle handle)
 {
     Coroutine_ImplStdThreadData* data = (Coroutine_ImplStdThreadData*)handle;
 
-    IM_ASSERT(data->CoroutineTerminated); // The coroutine needs to run to termination otherwise it may leak all sorts of things and this will deadlock
+    IM_ASSERT(data->State == Coroutine_ImplStdThreadState_Terminated); // The coroutine needs to run to termination otherwise it may leak all sorts of things and this will deadlock
     if (data->Thread)
     {
         data->Thread->join();
@@ -104,30 +194,16 @@ static bool Coroutine_ImplStdThread_Run(ImGuiTestCoroutineHandle handle)
 {
     Coroutine_ImplStdThreadData* data = (Coroutine_ImplStdThreadData*)handle;
 
-    // Wake up coroutine thread
-    {
-        std::lock_guard<std::mutex> lock(data->StateMutex);
-
-        if (data->CoroutineTerminated)
-            return false; // Coroutine has already finished
+    if (data->State.load(std::memory_order_acquire) == Coroutine_ImplStdThreadState_Terminated)
+        return false; // Coroutine has already finished
 
-        data->CoroutineRunning = true;
-        data->StateChange.notify_all();
-    }
+    // Wake up coroutine thread, then wait for coroutine to stop
+    CoroutineThreadSetState(data, Coroutine_ImplStdThreadState_Running);
+    const int state = CoroutineThreadWaitStateChange(data, Coroutine_ImplStdThreadState_Running);
 
-    // Wait for coroutine to stop
-    while (1)
-    {
-        std::unique_lock<std::mutex> lock(data->StateMutex);
-        if (!data->CoroutineRunning)
-        {
-            // Breakpoint here to catch the point where we return from the coroutine
-            if (data->CoroutineTerminated)
-                return false; // Coroutine finished
-            break;
-        }
-        data->StateChange.wait(lock);
-    }
+    // Breakpoint here to catch the point where we return from the coroutine
+    if (state == Coroutine_ImplStdThreadState_Terminated)
+        return false; // Coroutine finished
 
     return true;
 }
@@ -140,21 +216,12 @@ static void Coroutine_ImplStdThread_Yield()
     Coroutine_ImplStdThreadData* data = GThreadCoroutine;
 
     // Flag that we are not running any more
-    {
-        std::lock_guard<std::mutex> lock(data->StateMutex);
-        data->CoroutineRunning = false;
-        data->StateChange.notify_all();
-    }
-
     // At this point the thread that called RunCoroutine() will leave the "Wait for coroutine to stop" loop
+    CoroutineThreadSetState(data, Coroutine_ImplStdThreadState_Idle);
+
     // Wait until we get started up again
-    while (1)
-    {
-        std::unique_lock<std::mutex> lock(data->StateMutex);
-        if (data->CoroutineRunning)
-            break; // Breakpoint here if you want to catch the point where execution of this coroutine resumes
-        data->StateChange.wait(lock);
-    }
+    CoroutineThreadWaitStateChange(data, Coroutine_ImplStdThreadState_Idle);
+    // Breakpoint here if you want to catch the point where execution of this coroutine resumes
 }
 
 ImGuiTestCoroutineInterface* Coroutine_ImplStdThread_GetInterface()
@@ -167,4 +234,150 @@ ImGuiTestCoroutineInterface* Coroutine_ImplStdThread_GetInterface()
     return &intf;
 }
 
+void Coroutine_ImplStdThread_SetHandoffPolicy(ImGuiTestCoroutineHandoffPolicy policy, int spin_count)
+{
+    GThreadCoroutineHandoffPolicy = policy;
+    if (spin_count >= 0)
+        GThreadCoroutineSpinCount = spin_count;
+}
+
+// Call from the thread calling Run(), while coroutine is not running
+void Coroutine_ImplStdThread_GetHandoffStats(ImGuiTestCoroutineHandle handle, ImGuiTestCoroutineHandoffStats* out_stats)
+{
+    Coroutine_ImplStdThreadData* data = (Coroutine_ImplStdThreadData*)handle;
+    IM_ASSERT(data->State.load(std::memory_order_acquire) != Coroutine_ImplStdThreadState_Running);
+    *out_stats = data->Stats;
+}
+
 #endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+
+//------------------------------------------------------------------------
+// Coroutine implementation using ucontext
+// Each coroutine owns a stack allocated with mmap() (with a guard page to catch overflows) and runs on the thread calling Run().
+// Coroutines may be nested: a coroutine may itself Run() another coroutine.
+//------------------------------------------------------------------------
+
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+
+#if !defined(__linux__)
+#error "IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL is only supported on Linux."
+#endif
+
+#include "thirdparty/Str/Str.h"
+#include <stdint.h>     // uintptr_t
+#include <ucontext.h>   // getcontext(), makecontext(), swapcontext()
+#include <sys/mman.h>   // mmap(), mprotect()
+#include <unistd.h>     // sysconf()
+
+#ifndef IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE
+#define IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE (8 * 1024 * 1024)   // Same as default thread stack size on most Linux distributions
+#endif
+
+struct Coroutine_ImplUContextData
+{
+    ucontext_t                  CoroutineContext;       // Saved coroutine state while it is not running
+    ucontext_t                  CallerContext;          // Saved caller state while coroutine is running
+    Coroutine_ImplUContextData* Parent;                 // Coroutine which was running on this thread when Run() was called
+    void*                       Stack;                  // Stack memory, including guard page at the bottom
+    size_t                      StackSize;
+    ImGuiTestCoroutineMainFunc* Func;
+    void*                       FuncData;
+    bool                        CoroutineRunning;       // Is the coroutine currently running?
+    bool                        CoroutineTerminated;    // Has the coroutine terminated?
+    Str64                       Name;                   // The name of this coroutine
+};
+
+// The coroutine executing on the current thread (if any)
+static thread_local Coroutine_ImplUContextData* GUContextCoroutine = nullptr;
+
+// makecontext() only passes int arguments, so we split our pointer in two
+static void CoroutineUContextMain(unsigned int data_lo, unsigned int data_hi)
+{
+    Coroutine_ImplUContextData* data = (Coroutine_ImplUContextData*)(uintptr_t)(((unsigned long long)data_hi << 32) | (unsigned long long)data_lo);
+
+    // Run user code, which will then call Yield() when it wants to yield control
+    data->Func(data->FuncData);
+
+    // Mark as terminated. Returning resumes CallerContext via uc_link.
+    data->CoroutineTerminated = true;
+    data->CoroutineRunning = false;
+}
+
+static ImGuiTestCoroutineHandle Coroutine_ImplUContext_Create(ImGuiTestCoroutineMainFunc* func, const char* name, void* ctx)
+{
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t stack_size = ((IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE + page_size - 1) / page_size + 1) * page_size;
+    void* stack = mmap(nullptr, stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (stack == MAP_FAILED)
+        return nullptr;
+    mprotect(stack, page_size, PROT_NONE); // Guard page
+
+    Coroutine_ImplUContextData* data = new Coroutine_ImplUContextData();
+    data->Name = name;
+    data->Parent = nullptr;
+    data->Stack = stack;
+    data->StackSize = stack_size;
+    data->Func = func;
+    data->FuncData = ctx;
+    data->CoroutineRunning = false;
+    data->CoroutineTerminated = false;
+
+    getcontext(&data->CoroutineContext);
+    data->CoroutineContext.uc_stack.ss_sp = (char*)stack + page_size;
+    data->CoroutineContext.uc_stack.ss_size = stack_size - page_size;
+    data->CoroutineContext.uc_link = &data->CallerContext;
+    const unsigned long long data_bits = (unsigned long long)(uintptr_t)data;
+    makecontext(&data->CoroutineContext, (void (*)())CoroutineUContextMain, 2, (unsigned int)(data_bits & 0xFFFFFFFF), (unsigned int)(data_bits >> 32));
+
+    return (ImGuiTestCoroutineHandle)data;
+}
+
+static void Coroutine_ImplUContext_Destroy(ImGuiTestCoroutineHandle handle)
+{
+    Coroutine_ImplUContextData* data = (Coroutine_ImplUContextData*)handle;
+
+    IM_ASSERT(data->CoroutineTerminated); // The coroutine needs to run to termination otherwise it may leak all sorts of things
+    munmap(data->Stack, data->StackSize);
+    delete data;
+}
+
+// Run the coroutine until the next call to Yield(). Returns TRUE if the coroutine yielded, FALSE if it terminated (or had previously terminated)
+static bool Coroutine_ImplUContext_Run(ImGuiTestCoroutineHandle handle)
+{
+    Coroutine_ImplUContextData* data = (Coroutine_ImplUContextData*)handle;
+    if (data->CoroutineTerminated)
+        return false; // Coroutine has already finished
+    IM_ASSERT(!data->CoroutineRunning);
+
+    data->Parent = GUContextCoroutine;
+    data->CoroutineRunning = true;
+    GUContextCoroutine = data;
+    swapcontext(&data->CallerContext, &data->CoroutineContext);
+    GUContextCoroutine = data->Parent;
+
+    // Breakpoint here to catch the point where we return from the coroutine
+    return !data->CoroutineTerminated;
+}
+
+// Yield the current coroutine (can only be called from a coroutine)
+static void Coroutine_ImplUContext_Yield()
+{
+    IM_ASSERT(GUContextCoroutine); // This can only be called from a coroutine
+
+    Coroutine_ImplUContextData* data = GUContextCoroutine;
+    data->CoroutineRunning = false;
+    swapcontext(&data->CoroutineContext, &data->CallerContext);
+    // Breakpoint here if you want to catch the point where execution of this coroutine resumes
+}
+
+ImGuiTestCoroutineInterface* Coroutine_ImplUContext_GetInterface()
+{
+    static ImGuiTestCoroutineInterface intf;
+    intf.CreateFunc = Coroutine_ImplUContext_Create;
+    intf.DestroyFunc = Coroutine_ImplUContext_Destroy;
+    intf.RunFunc = Coroutine_ImplUContext_Run;
+    intf.YieldFunc = Coroutine_ImplUContext_Yield;
+    return &intf;
+}
+
+#endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
@@ -54,6 +54,38 @@ struct IMGUI_API ImGuiTestCoroutineInterface
 
 #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
 
+// How a thread waits for the other side to hand execution back (in Run() and Yield())
+// The default may be changed with '#define IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_HANDOFF_POLICY' and '#define IMGUI_TEST_ENGINE_COROUTINE_STDTHREAD_SPIN_COUNT'.
+enum ImGuiTestCoroutineHandoffPolicy : int
+{
+    ImGuiTestCoroutineHandoffPolicy_Park = 0,           // Block on a condition variable right away. Lowest CPU usage, but each handoff pays for a futex wake-up + OS scheduler latency.
+    ImGuiTestCoroutineHandoffPolicy_SpinThenPark = 1,   // Spin on an atomic flag for a bounded number of iterations before blocking. Much lower latency on multi-core machines (e.g. -nothrottle runs). Behave as _Park on single-core machines.
+};
+
+// Handoff statistics of a coroutine (both directions). Latency is measured from the time a side releases execution to the time the other side resumes.
+struct ImGuiTestCoroutineHandoffStats
+{
+    ImU64   HandoffCount = 0;       // Total number of handoffs
+    ImU64   SpinHandoffCount = 0;   // Number of handoffs observed while spinning
+    ImU64   ParkHandoffCount = 0;   // Number of handoffs which had to block on the condition variable
+    ImU64   LatencyTotalNs = 0;     // Sum of handoff latencies (divide by HandoffCount for average)
+    ImU64   LatencyMaxNs = 0;       // Worst handoff latency
+};
+
 IMGUI_API ImGuiTestCoroutineInterface*    Coroutine_ImplStdThread_GetInterface();
+IMGUI_API void                            Coroutine_ImplStdThread_SetHandoffPolicy(ImGuiTestCoroutineHandoffPolicy policy, int spin_count = -1); // Applies to coroutines created afterward. spin_count < 0 keeps current value.
+IMGUI_API void                            Coroutine_ImplStdThread_GetHandoffStats(ImGuiTestCoroutineHandle handle, ImGuiTestCoroutineHandoffStats* out_stats);
 
 #endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+
+//------------------------------------------------------------------------
+// Coroutine implementation using ucontext (Linux only)
+// Stackful coroutines running on the caller thread: Run() and Yield() are a plain context switch, without any OS thread handover.
+// The stack size may be configured with '#define IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE' (default 8 MB, reserved but only committed on use).
+//------------------------------------------------------------------------
+
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+
+IMGUI_API ImGuiTestCoroutineInterface*    Coroutine_ImplUContext_GetInterface();
+
+#endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
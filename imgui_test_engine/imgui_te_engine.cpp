@@ -20,6 +20,10 @@
 #include "imgui_te_perftool.h"
 #include "imgui_te_exporters.h"
 #include "thirdparty/Str/Str.h"
+#include <chrono>       // std::chrono::milliseconds
+#include <condition_variable>
+#include <mutex>
+#include <thread>       // std::thread for ImGuiTestLogOutputQueue
 #if _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -50,7 +54,9 @@ Index of this file:
 // [SECTION] HOOKS FOR CORE LIBRARY
 // [SECTION] CHECK/ERROR FUNCTIONS FOR TESTS
 // [SECTION] SETTINGS
+// [SECTION] TIMING HISTORY
 // [SECTION] ImGuiTestLog
+// [SECTION] LOG OUTPUT THREAD
 // [SECTION] ImGuiTest
 
 */
@@ -59,7 +65,19 @@ Index of this file:
 // [SECTION] DATA
 //-------------------------------------------------------------------------
 
-static ImGuiTestEngine* GImGuiTestEngine = nullptr;
+// Engine running a test on the current thread (set on the thread executing the test coroutine).
+// There is no process-wide engine: hooks resolve their engine via ui_ctx->TestEngine, so multiple engines may run on separate threads.
+// (Running Dear ImGui contexts on multiple threads requires a thread-local GImGui, see imconfig.h)
+static thread_local ImGuiTestEngine* GImGuiTestEngineCurrent = nullptr;
+
+// Return engine running a test on current thread, or engine bound to current Dear ImGui context
+static ImGuiTestEngine* ImGuiTestEngine_GetCurrentEngine()
+{
+    if (GImGuiTestEngineCurrent != nullptr)
+        return GImGuiTestEngineCurrent;
+    ImGuiContext* ui_ctx = GImGui;
+    return ui_ctx ? (ImGuiTestEngine*)ui_ctx->TestEngine : nullptr;
+}
 
 //-------------------------------------------------------------------------
 // [SECTION] FORWARD DECLARATIONS
@@ -82,12 +100,17 @@ static void ImGuiTestEngine_RunTestFunc(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_ErrorRecoverySetup(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_ErrorRecoveryRun(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_TestQueueCoroutineMain(void* engine_opaque);
+static void ImGuiTestEngine_FlushLogOutputEx(ImGuiTestEngine* engine, int timeout_ms);
 
 // Settings
 static void* ImGuiTestEngine_SettingsReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
 static void  ImGuiTestEngine_SettingsReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line);
 static void  ImGuiTestEngine_SettingsWriteAll(ImGuiContext* imgui_ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf);
 
+// Timing History
+static void ImGuiTestEngine_SaveTimingHistory(ImGuiTestEngine* engine);
+static void ImGuiTestEngine_ScheduleTests(ImGuiTestEngine* engine, int queue_start);
+
 //-------------------------------------------------------------------------
 // [SECTION] TEST ENGINE FUNCTIONS
 //-------------------------------------------------------------------------
@@ -106,6 +129,7 @@ static void  ImGuiTestEngine_SettingsWriteAll(ImGuiContext* imgui_ctx, ImGuiSett
 // - ImGuiTestEngine_PreNewFrame()
 // - ImGuiTestEngine_PostNewFrame()
 // - ImGuiTestEngine_Yield()
+// - ImGuiTestEngine_PushInput()
 // - ImGuiTestEngine_ProcessTestQueue()
 // - ImGuiTestEngine_QueueTest()
 // - ImGuiTestEngine_RunTest()
@@ -120,8 +144,11 @@ ImGuiTestEngine::ImGuiTestEngine()
     UiFilterTests = IM_NEW(Str256); // We bite the bullet of adding an extra alloc/indirection in order to avoid including Str.h in our header
     UiFilterPerfs = IM_NEW(Str256);
 
-    // Initialize std::thread based coroutine implementation if requested
-#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+    // Initialize ucontext or std::thread based coroutine implementation if requested
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+    IM_ASSERT(IO.CoroutineFuncs == nullptr && "IO.CoroutineFuncs already setup elsewhere!");
+    IO.CoroutineFuncs = Coroutine_ImplUContext_GetInterface();
+#elif IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
     IM_ASSERT(IO.CoroutineFuncs == nullptr && "IO.CoroutineFuncs already setup elsewhere!");
     IO.CoroutineFuncs = Coroutine_ImplStdThread_GetInterface();
 #endif
@@ -193,8 +220,6 @@ void ImGuiTestEngine_BindImGuiContext(ImGuiTestEngine* engine, ImGuiContext* ui_
     ImGui::AddContextHook(ui_ctx, &hook);
 
     // Install custom test engine hook data
-    if (GImGuiTestEngine == nullptr)
-        GImGuiTestEngine = engine;
     IM_ASSERT(ui_ctx->TestEngine == nullptr);
     ui_ctx->TestEngine = engine;
 }
@@ -221,9 +246,6 @@ void    ImGuiTestEngine_UnbindImGuiContext(ImGuiTestEngine* engine, ImGuiContext
         ImGui::RemoveSettingsHandler("TestEnginePerfTool");
     }
 
-    // Remove hook
-    if (GImGuiTestEngine == engine)
-        GImGuiTestEngine = nullptr;
     engine->UiContextTarget = engine->UiContextActive = nullptr;
 }
 
@@ -244,6 +266,7 @@ void    ImGuiTestEngine_DestroyContext(ImGuiTestEngine* engine)
 
     // Shutdown coroutine
     ImGuiTestEngine_CoroutineStopAndJoin(engine);
+    ImGuiTestEngine_StopLogOutputThread(engine);
     if (engine->UiContextTarget != nullptr)
         ImGuiTestEngine_UnbindImGuiContext(engine, engine->UiContextTarget);
 
@@ -251,13 +274,16 @@ void    ImGuiTestEngine_DestroyContext(ImGuiTestEngine* engine)
 
     for (int n = 0; n < engine->InfoTasks.Size; n++)
         IM_DELETE(engine->InfoTasks[n]);
+    for (int n = 0; n < engine->InfoTasksPool.Size; n++)
+        IM_DELETE(engine->InfoTasksPool[n]);
     engine->InfoTasks.clear();
+    engine->InfoTasksPool.clear();
+    engine->InfoTasksMap.Clear();
 
     IM_DELETE(engine);
 
-    // Release hook
-    if (GImGuiTestEngine == engine)
-        GImGuiTestEngine = nullptr;
+    if (GImGuiTestEngineCurrent == engine)
+        GImGuiTestEngineCurrent = nullptr;
 }
 
 void    ImGuiTestEngine_Start(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -286,8 +312,10 @@ void    ImGuiTestEngine_Stop(ImGuiTestEngine* engine)
 
     engine->Abort = true;
     ImGuiTestEngine_CoroutineStopAndJoin(engine);
+    ImGuiTestEngine_StopLogOutputThread(engine);
     //ImGuiTestEngine_UnbindImGuiContext(engine, engine->UiContextTarget);
     ImGuiTestEngine_Export(engine);
+    ImGuiTestEngine_SaveTimingHistory(engine);
     engine->Started = false;
 }
 
@@ -438,16 +466,81 @@ ImGuiTest* ImGuiTestEngine_FindTestByName(ImGuiTestEngine* engine, const char* c
     return nullptr;
 }
 
-// FIXME-OPT
-static ImGuiTestInfoTask* ImGuiTestEngine_FindInfoTask(ImGuiTestEngine* engine, ImGuiID id)
+ImGuiTestInfoTask* ImGuiTestInfoTaskMap::Find(ImGuiID id) const
 {
-    for (int task_n = 0; task_n < engine->InfoTasks.Size; task_n++)
+    if (Count == 0)
+        return nullptr;
+    const int mask = Slots.Size - 1;
+    for (int slot_n = (int)(id & mask); ; slot_n = (slot_n + 1) & mask)
     {
-        ImGuiTestInfoTask* task = engine->InfoTasks[task_n];
-        if (task->ID == id)
-            return task;
+        const Slot& slot = Slots.Data[slot_n];
+        if (slot.ID == id)
+            return slot.Task;
+        if (slot.ID == 0)
+            return nullptr;
     }
-    return nullptr;
+}
+
+void ImGuiTestInfoTaskMap::Add(ImGuiTestInfoTask* task)
+{
+    IM_ASSERT(task->ID != 0);
+
+    // Keep load factor <= 50%
+    if ((Count + 1) * 2 > Slots.Size)
+    {
+        ImVector<Slot> old_slots;
+        old_slots.swap(Slots);
+        Slots.resize(old_slots.Size ? old_slots.Size * 2 : 32);
+        memset(Slots.Data, 0, (size_t)Slots.size_in_bytes());
+        Count = 0;
+        for (const Slot& old_slot : old_slots)
+            if (old_slot.ID != 0)
+                Add(old_slot.Task);
+    }
+
+    const int mask = Slots.Size - 1;
+    int slot_n = (int)(task->ID & mask);
+    while (Slots.Data[slot_n].ID != 0)
+    {
+        IM_ASSERT(Slots.Data[slot_n].ID != task->ID);
+        slot_n = (slot_n + 1) & mask;
+    }
+    Slots.Data[slot_n].ID = task->ID;
+    Slots.Data[slot_n].Task = task;
+    Count++;
+}
+
+void ImGuiTestInfoTaskMap::Remove(ImGuiID id)
+{
+    if (Slots.Size == 0)
+        return;
+    const int mask = Slots.Size - 1;
+    int slot_n = (int)(id & mask);
+    while (Slots.Data[slot_n].ID != id)
+    {
+        if (Slots.Data[slot_n].ID == 0)
+            return;
+        slot_n = (slot_n + 1) & mask;
+    }
+
+    // Backward-shift following entries so lookups never need tombstones
+    for (int next_n = (slot_n + 1) & mask; Slots.Data[next_n].ID != 0; next_n = (next_n + 1) & mask)
+    {
+        const int home_n = (int)(Slots.Data[next_n].ID & mask);
+        const bool can_move = (slot_n <= next_n) ? (home_n <= slot_n || home_n > next_n) : (home_n <= slot_n && home_n > next_n);
+        if (!can_move)
+            continue;
+        Slots.Data[slot_n] = Slots.Data[next_n];
+        slot_n = next_n;
+    }
+    Slots.Data[slot_n].ID = 0;
+    Slots.Data[slot_n].Task = nullptr;
+    Count--;
+}
+
+static ImGuiTestInfoTask* ImGuiTestEngine_FindInfoTask(ImGuiTestEngine* engine, ImGuiID id)
+{
+    return engine->InfoTasksMap.Find(id);
 }
 
 // Request information about one item.
@@ -467,8 +560,18 @@ ImGuiTestItemInfo* ImGuiTestEngine_FindItemInfo(ImGuiTestEngine* engine, ImGuiID
         return nullptr;
     }
 
-    // Create task
-    ImGuiTestInfoTask* task = IM_NEW(ImGuiTestInfoTask)();
+    // Create task (reusing a recycled one when available)
+    ImGuiTestInfoTask* task;
+    if (engine->InfoTasksPool.Size > 0)
+    {
+        task = engine->InfoTasksPool.back();
+        engine->InfoTasksPool.pop_back();
+        *task = ImGuiTestInfoTask();
+    }
+    else
+    {
+        task = IM_NEW(ImGuiTestInfoTask)();
+    }
     task->ID = id;
     task->FrameCount = engine->FrameCount;
     if (debug_id)
@@ -487,10 +590,177 @@ ImGuiTestItemInfo* ImGuiTestEngine_FindItemInfo(ImGuiTestEngine* engine, ImGuiID
         }
     }
     engine->InfoTasks.push_back(task);
+    engine->InfoTasksMap.Add(task);
+    if (engine->UiContextTarget != nullptr)
+        engine->UiContextTarget->TestEngineHookItems = true; // Don't wait for next ImGuiTestEngine_UpdateHooks() call
+
+    return nullptr;
+}
+
+// Gather and FindByLabel tasks are allocated from small fixed pools so multiple queries can be resolved during the same frames.
+// Tasks need to be filled by caller before yielding, and removed once done.
+ImGuiTestGatherTask* ImGuiTestEngine_AddGatherTask(ImGuiTestEngine* engine)
+{
+    for (int task_n = 0; task_n < IM_ARRAYSIZE(engine->GatherTasks); task_n++)
+        if ((engine->GatherTasksUsedMask & (1u << task_n)) == 0)
+        {
+            engine->GatherTasksUsedMask |= (1u << task_n);
+            engine->GatherTasks[task_n].Clear();
+            return &engine->GatherTasks[task_n];
+        }
+    return nullptr;
+}
+
+void ImGuiTestEngine_RemoveGatherTask(ImGuiTestEngine* engine, ImGuiTestGatherTask* task)
+{
+    const int task_n = (int)(task - engine->GatherTasks);
+    IM_ASSERT(task_n >= 0 && task_n < IM_ARRAYSIZE(engine->GatherTasks));
+    IM_ASSERT(engine->GatherTasksUsedMask & (1u << task_n));
+    engine->GatherTasksUsedMask &= ~(1u << task_n);
+    task->Clear();
+}
 
+ImGuiTestFindByLabelTask* ImGuiTestEngine_AddFindByLabelTask(ImGuiTestEngine* engine)
+{
+    for (int task_n = 0; task_n < IM_ARRAYSIZE(engine->FindByLabelTasks); task_n++)
+        if ((engine->FindByLabelTasksUsedMask & (1u << task_n)) == 0)
+        {
+            engine->FindByLabelTasksUsedMask |= (1u << task_n);
+            ImGuiTestFindByLabelTask* task = &engine->FindByLabelTasks[task_n];
+            *task = ImGuiTestFindByLabelTask();
+            task->InFilterItemStatusFlags = engine->FindByLabelFilterItemStatusFlags;
+            return task;
+        }
     return nullptr;
 }
 
+void ImGuiTestEngine_RemoveFindByLabelTask(ImGuiTestEngine* engine, ImGuiTestFindByLabelTask* task)
+{
+    const int task_n = (int)(task - engine->FindByLabelTasks);
+    IM_ASSERT(task_n >= 0 && task_n < IM_ARRAYSIZE(engine->FindByLabelTasks));
+    IM_ASSERT(engine->FindByLabelTasksUsedMask & (1u << task_n));
+    engine->FindByLabelTasksUsedMask &= ~(1u << task_n);
+    *task = ImGuiTestFindByLabelTask();
+}
+
+// Record an item label into the label index. Called from ImGuiTestEngineHook_ItemInfo() for every labelled item.
+static void ImGuiTestEngine_LabelIndexAdd(ImGuiTestEngine* engine, ImGuiWindow* window, ImGuiID id, ImGuiID label_hash, ImGuiItemStatusFlags flags)
+{
+    const int ENTRIES_COUNT = 4096;
+    const int BUCKETS_COUNT = 1024;
+    ImGuiTestLabelIndex* index = &engine->LabelIndex;
+    if (index->Entries.Size == 0)
+    {
+        index->Entries.resize(ENTRIES_COUNT);
+        index->Buckets.resize(BUCKETS_COUNT);
+        memset(index->Entries.Data, 0, (size_t)index->Entries.size_in_bytes());
+        memset(index->Buckets.Data, 0, (size_t)index->Buckets.size_in_bytes());
+    }
+
+    // Refresh existing entry if item was already recorded recently
+    int* p_bucket = &index->Buckets[(int)(label_hash & (index->Buckets.Size - 1))];
+    ImGuiTestLabelIndexEntry* entry = nullptr;
+    for (int seq = *p_bucket, steps = 0; seq != 0 && steps < 8; steps++)
+    {
+        ImGuiTestLabelIndexEntry* e = &index->Entries[seq & (index->Entries.Size - 1)];
+        if (e->Seq != seq)
+            break; // Overwritten: older entries of this chain are gone too
+        if (e->ID == id && e->LabelHash == label_hash)
+        {
+            entry = e;
+            break;
+        }
+        seq = e->PrevSeqInBucket;
+    }
+
+    // Otherwise add new entry, overwriting oldest one
+    if (entry == nullptr)
+    {
+        const int seq = index->NextSeq++;
+        entry = &index->Entries[seq & (index->Entries.Size - 1)];
+        entry->Seq = seq;
+        entry->PrevSeqInBucket = *p_bucket;
+        entry->ID = id;
+        entry->LabelHash = label_hash;
+        *p_bucket = seq;
+    }
+    entry->FrameCount = engine->FrameCount;
+    entry->StatusFlags = flags;
+
+    // Store top of ID stack and window chain
+    const int id_stack_size = window->IDStack.Size;
+    entry->IDStackSize = (ImS8)ImMin(id_stack_size, IMGUI_TEST_ENGINE_LABEL_INDEX_STACK_DEPTH);
+    for (int n = 0; n < entry->IDStackSize; n++)
+        entry->IDStack[n] = window->IDStack.Data[id_stack_size - 1 - n];
+    entry->WindowIDsCount = 0;
+    for (ImGuiWindow* curr_window = window; curr_window != nullptr && entry->WindowIDsCount < IMGUI_TEST_ENGINE_LABEL_INDEX_WINDOW_DEPTH; curr_window = curr_window->ParentWindow)
+        entry->WindowIDs[entry->WindowIDsCount++] = curr_window->ID;
+    entry->IsComplete = (id_stack_size <= IMGUI_TEST_ENGINE_LABEL_INDEX_STACK_DEPTH) && (window->ParentWindow == nullptr);
+}
+
+static void ImGuiTestEngine_LabelIndexInvalidateWindow(ImGuiTestEngine* engine, ImGuiID window_id)
+{
+    for (ImGuiTestLabelIndexEntry& entry : engine->LabelIndex.Entries)
+        if (entry.Seq != 0 && entry.WindowIDsCount > 0 && entry.WindowIDs[0] == window_id)
+            entry.ID = 0; // Keep Seq so chains stay valid
+}
+
+// Resolve a wildcard query from recently submitted labels, applying the same rules as ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel().
+// Only items submitted during current or previous frame are considered. Return 0 if unknown or ambiguous, in which case caller needs to do a regular search.
+ImGuiID ImGuiTestEngine_LabelIndexFind(ImGuiTestEngine* engine, const ImGuiTestFindByLabelTask* task)
+{
+    ImGuiTestLabelIndex* index = &engine->LabelIndex;
+    if (index->Entries.Size == 0 || task->InSuffixLastItem == nullptr)
+        return 0;
+
+    ImGuiID result_id = 0;
+    for (int seq = index->Buckets[(int)(task->InSuffixLastItemHash & (index->Buckets.Size - 1))]; seq != 0; )
+    {
+        const ImGuiTestLabelIndexEntry* entry = &index->Entries[seq & (index->Entries.Size - 1)];
+        if (entry->Seq != seq)
+            break;
+        seq = entry->PrevSeqInBucket;
+        if (entry->ID == 0 || entry->LabelHash != task->InSuffixLastItemHash || entry->FrameCount < engine->FrameCount - 1)
+            continue;
+        if (task->InFilterItemStatusFlags != 0 && (task->InFilterItemStatusFlags & entry->StatusFlags) == 0)
+            continue;
+
+        // Test for matching PREFIX
+        bool match_prefix = (task->InPrefixId == 0);
+        for (int n = 0; n < entry->WindowIDsCount && !match_prefix; n++)
+            match_prefix = (entry->WindowIDs[n] == task->InPrefixId);
+        for (int n = 0; n < entry->IDStackSize && !match_prefix; n++)
+            match_prefix = (entry->IDStack[n] == task->InPrefixId);
+        if (!match_prefix)
+        {
+            if (!entry->IsComplete)
+                return 0; // Prefix may be in a part of the ID stack we didn't store
+            continue;
+        }
+
+        // Test for full matching SUFFIX
+        if (task->InSuffixDepth > 1)
+        {
+            // Same as IDStack.Data[id_stack_size - InSuffixDepth] and the "Try with parent" variant
+            const int depth = task->InSuffixDepth;
+            if (depth >= IMGUI_TEST_ENGINE_LABEL_INDEX_STACK_DEPTH && !entry->IsComplete)
+                return 0;
+            ImGuiID base_id = (depth - 1 < entry->IDStackSize) ? entry->IDStack[depth - 1] : 0;
+            if (entry->ID != ImHashDecoratedPath(task->InSuffix, nullptr, base_id))
+            {
+                base_id = (depth < entry->IDStackSize) ? entry->IDStack[depth] : 0;
+                if (entry->ID != ImHashDecoratedPath(task->InSuffix, nullptr, base_id))
+                    continue;
+            }
+        }
+
+        if (result_id != 0 && result_id != entry->ID)
+            return 0; // Ambiguous: regular search will pick first submitted item
+        result_id = entry->ID;
+    }
+    return result_id;
+}
+
 static void ImGuiTestEngine_ClearTests(ImGuiTestEngine* engine)
 {
     for (int n = 0; n < engine->TestsAll.Size; n++)
@@ -507,7 +777,7 @@ void ImGuiTestEngine_ClearInput(ImGuiTestEngine* engine)
     ImGuiContext& g = *engine->UiContextTarget;
 
     engine->Inputs.MouseButtonsValue = 0;
-    engine->Inputs.Queue.clear();
+    engine->Inputs.Queue.Clear();
     engine->Inputs.MouseWheel = ImVec2(0, 0);
 
     // FIXME: Necessary?
@@ -531,6 +801,161 @@ bool ImGuiTestEngine_IsUsingSimulatedInputs(ImGuiTestEngine* engine)
     return false;
 }
 
+// Apply one queued input (key/char/viewport request)
+static void ImGuiTestEngine_ApplyInput(ImGuiTestEngine* engine, const ImGuiTestInput& input)
+{
+    ImGuiContext& g = *engine->UiContextTarget;
+    ImGuiIO& io = g.IO;
+#ifdef IMGUI_HAS_VIEWPORT
+    ImGuiPlatformIO& platform_io = g.PlatformIO;
+#endif
+
+    switch (input.Type)
+    {
+    case ImGuiTestInputType_Key:
+    {
+        ImGuiKeyChord key_chord = input.KeyChord;
+#if IMGUI_VERSION_NUM >= 19016 && IMGUI_VERSION_NUM < 19063
+        key_chord = ImGui::FixupKeyChord(&g, key_chord); // This will add ImGuiMod_Alt when pressing ImGuiKey_LeftAlt or ImGuiKey_LeftRight
+#endif
+#if IMGUI_VERSION_NUM >= 19063
+        key_chord = ImGui::FixupKeyChord(key_chord);     // This will add ImGuiMod_Alt when pressing ImGuiKey_LeftAlt or ImGuiKey_LeftRight
+#endif
+        ImGuiKey key = (ImGuiKey)(key_chord & ~ImGuiMod_Mask_);
+        ImGuiKeyChord mods = (key_chord & ImGuiMod_Mask_);
+        if (mods != 0x00)
+        {
+            // OSX conversion
+#if IMGUI_VERSION_NUM >= 18912 && IMGUI_VERSION_NUM < 19063
+            if (mods & ImGuiMod_Shortcut)
+                mods = (mods & ~ImGuiMod_Shortcut) | (g.IO.ConfigMacOSXBehaviors ? ImGuiMod_Super : ImGuiMod_Ctrl);
+#endif
+#if IMGUI_VERSION_NUM >= 19063
+            // MacOS: swap Cmd(Super) and Ctrl WILL BE SWAPPED BACK BY io.AddKeyEvent()
+            if (g.IO.ConfigMacOSXBehaviors)
+            {
+                if ((mods & (ImGuiMod_Ctrl | ImGuiMod_Super)) == ImGuiMod_Super)
+                    mods = (mods & ~ImGuiMod_Super) | ImGuiMod_Ctrl;
+                else if ((mods & (ImGuiMod_Ctrl | ImGuiMod_Super)) == ImGuiMod_Ctrl)
+                    mods = (mods & ~ImGuiMod_Ctrl) | ImGuiMod_Super;
+                if (key == ImGuiKey_LeftSuper)      { key = ImGuiKey_LeftCtrl; }
+                else if (key == ImGuiKey_LeftSuper) { key = ImGuiKey_RightCtrl; }
+                else if (key == ImGuiKey_LeftCtrl)  { key = ImGuiKey_LeftSuper; }
+                else if (key == ImGuiKey_LeftCtrl)  { key = ImGuiKey_RightSuper; }
+            }
+#endif
+            // Submitting a ImGuiMod_XXX without associated key needs to add at least one of the key.
+            if (mods & ImGuiMod_Ctrl)
+            {
+                io.AddKeyEvent(ImGuiMod_Ctrl, input.Down);
+                if (key != ImGuiKey_LeftCtrl && key != ImGuiKey_RightCtrl)
+                    io.AddKeyEvent(ImGuiKey_LeftCtrl, input.Down);
+            }
+            if (mods & ImGuiMod_Shift)
+            {
+                io.AddKeyEvent(ImGuiMod_Shift, input.Down);
+                if (key != ImGuiKey_LeftShift && key != ImGuiKey_RightShift)
+                    io.AddKeyEvent(ImGuiKey_LeftShift, input.Down);
+            }
+            if (mods & ImGuiMod_Alt)
+            {
+                io.AddKeyEvent(ImGuiMod_Alt, input.Down);
+                if (key != ImGuiKey_LeftAlt && key != ImGuiKey_RightAlt)
+                    io.AddKeyEvent(ImGuiKey_LeftAlt, input.Down);
+            }
+            if (mods & ImGuiMod_Super)
+            {
+                io.AddKeyEvent(ImGuiMod_Super, input.Down);
+                if (key != ImGuiKey_LeftSuper && key != ImGuiKey_RightSuper)
+                    io.AddKeyEvent(ImGuiKey_LeftSuper, input.Down);
+            }
+        }
+
+        if (key != ImGuiKey_None)
+            io.AddKeyEvent(key, input.Down);
+        break;
+    }
+    case ImGuiTestInputType_Char:
+    {
+        IM_ASSERT(input.Char != 0);
+        io.AddInputCharacter(input.Char);
+        break;
+    }
+    case ImGuiTestInputType_Text:
+    {
+        IM_ASSERT(input.Text != nullptr);
+        io.AddInputCharactersUTF8(input.Text);
+        break;
+    }
+#ifdef IMGUI_HAS_VIEWPORT
+    case ImGuiTestInputType_ViewportFocus:
+    {
+        if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
+            break;
+        IM_ASSERT(engine->TestContext != nullptr);
+        ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
+        if (viewport == nullptr)
+            engine->TestContext->LogError("ViewportPlatform_SetWindowFocus(%08X): cannot find viewport anymore!", input.ViewportId);
+        else if (platform_io.Platform_SetWindowFocus == nullptr)
+            engine->TestContext->LogError("ViewportPlatform_SetWindowFocus(%08X): backend's Platform_SetWindowFocus() is not set", input.ViewportId);
+        else
+            platform_io.Platform_SetWindowFocus(viewport);
+        break;
+    }
+    case ImGuiTestInputType_ViewportSetPos:
+    {
+        if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
+            break;
+        IM_ASSERT(engine->TestContext != nullptr);
+        ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
+        if (viewport == nullptr)
+            engine->TestContext->LogError("ViewportPlatform_SetWindowPos(%08X): cannot find viewport anymore!", input.ViewportId);
+        else if (platform_io.Platform_SetWindowPos == nullptr)
+            engine->TestContext->LogError("ViewportPlatform_SetWindowPos(%08X): backend's Platform_SetWindowPos() is not set", input.ViewportId);
+        else
+            platform_io.Platform_SetWindowPos(viewport, input.ViewportPosSize);
+        break;
+    }
+    case ImGuiTestInputType_ViewportSetSize:
+    {
+        if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
+            break;
+        IM_ASSERT(engine->TestContext != nullptr);
+        ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
+        if (viewport == nullptr)
+            engine->TestContext->LogError("ViewportPlatform_SetWindowSize(%08X): cannot find viewport anymore!", input.ViewportId);
+        else if (platform_io.Platform_SetWindowPos == nullptr)
+            engine->TestContext->LogError("ViewportPlatform_SetWindowSize(%08X): backend's Platform_SetWindowSize() is not set", input.ViewportId);
+        else
+            platform_io.Platform_SetWindowSize(viewport, input.ViewportPosSize);
+        break;
+    }
+    case ImGuiTestInputType_ViewportClose:
+    {
+        if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
+            break;
+        IM_ASSERT(engine->TestContext != nullptr);
+        ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
+        if (viewport == nullptr)
+            engine->TestContext->LogError("ViewportPlatform_CloseWindow(%08X): cannot find viewport anymore!", input.ViewportId);
+        else
+            viewport->PlatformRequestClose = true;
+        // FIXME: doesn't apply to actual backend
+        break;
+    }
+#else
+    case ImGuiTestInputType_ViewportFocus:
+    case ImGuiTestInputType_ViewportSetPos:
+    case ImGuiTestInputType_ViewportSetSize:
+    case ImGuiTestInputType_ViewportClose:
+        break;
+#endif
+    case ImGuiTestInputType_None:
+    default:
+        break;
+    }
+}
+
 // Setup inputs in the tested Dear ImGui context. Essentially we override the work of the backend here.
 void ImGuiTestEngine_ApplyInputToImGuiContext(ImGuiTestEngine* engine)
 {
@@ -560,7 +985,6 @@ void ImGuiTestEngine_ApplyInputToImGuiContext(ImGuiTestEngine* engine)
 
     // Apply mouse viewport
 #ifdef IMGUI_HAS_VIEWPORT
-    ImGuiPlatformIO& platform_io = g.PlatformIO;
     ImGuiViewport* mouse_hovered_viewport;
     if (engine->Inputs.MouseHoveredViewport != 0)
         mouse_hovered_viewport = ImGui::FindViewportByID(engine->Inputs.MouseHoveredViewport); // Common case
@@ -572,6 +996,7 @@ void ImGuiTestEngine_ApplyInputToImGuiContext(ImGuiTestEngine* engine)
         if (io.BackendFlags & ImGuiBackendFlags_HasMouseHoveredViewport)
             io.AddMouseViewportEvent(mouse_hovered_viewport ? mouse_hovered_viewport->ID : 0);
     bool mouse_hovered_viewport_focused = mouse_hovered_viewport && (mouse_hovered_viewport->Flags & ImGuiViewportFlags_IsFocused) != 0;
+    bool mouse_hovered_viewport_focus_request = false;
 #endif
 
     // Apply mouse
@@ -587,7 +1012,7 @@ void ImGuiTestEngine_ApplyInputToImGuiContext(ImGuiTestEngine* engine)
             if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
             {
                 mouse_hovered_viewport_focused = true;
-                engine->Inputs.Queue.push_back(ImGuiTestInput::ForViewportFocus(mouse_hovered_viewport->ID));
+                mouse_hovered_viewport_focus_request = true; // Applied after queued inputs. Not pushed in queue: we are the consumer side.
             }
 #endif
     }
@@ -602,154 +1027,20 @@ void ImGuiTestEngine_ApplyInputToImGuiContext(ImGuiTestEngine* engine)
         io.AddMouseWheelEvent(wheel.x, wheel.y);
     engine->Inputs.MouseWheel = ImVec2(0, 0);
 
-    // Process input requests/queues
-    if (engine->Inputs.Queue.Size > 0)
+    // Process input queue, in order, up to the time of the frame about to start.
+    // Multiple inputs may be due in a same frame (e.g. KeyChars() typing faster than framerate).
+    const double frame_time = g.Time + io.DeltaTime;
+    while (const ImGuiTestInput* input = engine->Inputs.Queue.Front())
     {
-        for (int n = 0; n < engine->Inputs.Queue.Size; n++)
-        {
-            const ImGuiTestInput& input = engine->Inputs.Queue[n];
-            switch (input.Type)
-            {
-            case ImGuiTestInputType_Key:
-            {
-                ImGuiKeyChord key_chord = input.KeyChord;
-#if IMGUI_VERSION_NUM >= 19016 && IMGUI_VERSION_NUM < 19063
-                key_chord = ImGui::FixupKeyChord(&g, key_chord); // This will add ImGuiMod_Alt when pressing ImGuiKey_LeftAlt or ImGuiKey_LeftRight
-#endif
-#if IMGUI_VERSION_NUM >= 19063
-                key_chord = ImGui::FixupKeyChord(key_chord);     // This will add ImGuiMod_Alt when pressing ImGuiKey_LeftAlt or ImGuiKey_LeftRight
-#endif
-                ImGuiKey key = (ImGuiKey)(key_chord & ~ImGuiMod_Mask_);
-                ImGuiKeyChord mods = (key_chord & ImGuiMod_Mask_);
-                if (mods != 0x00)
-                {
-                    // OSX conversion
-#if IMGUI_VERSION_NUM >= 18912 && IMGUI_VERSION_NUM < 19063
-                    if (mods & ImGuiMod_Shortcut)
-                        mods = (mods & ~ImGuiMod_Shortcut) | (g.IO.ConfigMacOSXBehaviors ? ImGuiMod_Super : ImGuiMod_Ctrl);
-#endif
-#if IMGUI_VERSION_NUM >= 19063
-                    // MacOS: swap Cmd(Super) and Ctrl WILL BE SWAPPED BACK BY io.AddKeyEvent()
-                    if (g.IO.ConfigMacOSXBehaviors)
-                    {
-                        if ((mods & (ImGuiMod_Ctrl | ImGuiMod_Super)) == ImGuiMod_Super)
-                            mods = (mods & ~ImGuiMod_Super) | ImGuiMod_Ctrl;
-                        else if ((mods & (ImGuiMod_Ctrl | ImGuiMod_Super)) == ImGuiMod_Ctrl)
-                            mods = (mods & ~ImGuiMod_Ctrl) | ImGuiMod_Super;
-                        if (key == ImGuiKey_LeftSuper)      { key = ImGuiKey_LeftCtrl; }
-                        else if (key == ImGuiKey_LeftSuper) { key = ImGuiKey_RightCtrl; }
-                        else if (key == ImGuiKey_LeftCtrl)  { key = ImGuiKey_LeftSuper; }
-                        else if (key == ImGuiKey_LeftCtrl)  { key = ImGuiKey_RightSuper; }
-                    }
-#endif
-                    // Submitting a ImGuiMod_XXX without associated key needs to add at least one of the key.
-                    if (mods & ImGuiMod_Ctrl)
-                    {
-                        io.AddKeyEvent(ImGuiMod_Ctrl, input.Down);
-                        if (key != ImGuiKey_LeftCtrl && key != ImGuiKey_RightCtrl)
-                            io.AddKeyEvent(ImGuiKey_LeftCtrl, input.Down);
-                    }
-                    if (mods & ImGuiMod_Shift)
-                    {
-                        io.AddKeyEvent(ImGuiMod_Shift, input.Down);
-                        if (key != ImGuiKey_LeftShift && key != ImGuiKey_RightShift)
-                            io.AddKeyEvent(ImGuiKey_LeftShift, input.Down);
-                    }
-                    if (mods & ImGuiMod_Alt)
-                    {
-                        io.AddKeyEvent(ImGuiMod_Alt, input.Down);
-                        if (key != ImGuiKey_LeftAlt && key != ImGuiKey_RightAlt)
-                            io.AddKeyEvent(ImGuiKey_LeftAlt, input.Down);
-                    }
-                    if (mods & ImGuiMod_Super)
-                    {
-                        io.AddKeyEvent(ImGuiMod_Super, input.Down);
-                        if (key != ImGuiKey_LeftSuper && key != ImGuiKey_RightSuper)
-                            io.AddKeyEvent(ImGuiKey_LeftSuper, input.Down);
-                    }
-                }
-
-                if (key != ImGuiKey_None)
-                    io.AddKeyEvent(key, input.Down);
-                break;
-            }
-            case ImGuiTestInputType_Char:
-            {
-                IM_ASSERT(input.Char != 0);
-                io.AddInputCharacter(input.Char);
-                break;
-            }
+        if (input->Time > frame_time)
+            break;
+        ImGuiTestEngine_ApplyInput(engine, *input);
+        engine->Inputs.Queue.PopFront();
+    }
 #ifdef IMGUI_HAS_VIEWPORT
-            case ImGuiTestInputType_ViewportFocus:
-            {
-                if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
-                    break;
-                IM_ASSERT(engine->TestContext != nullptr);
-                ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
-                if (viewport == nullptr)
-                    engine->TestContext->LogError("ViewportPlatform_SetWindowFocus(%08X): cannot find viewport anymore!", input.ViewportId);
-                else if (platform_io.Platform_SetWindowFocus == nullptr)
-                    engine->TestContext->LogError("ViewportPlatform_SetWindowFocus(%08X): backend's Platform_SetWindowFocus() is not set", input.ViewportId);
-                else
-                    platform_io.Platform_SetWindowFocus(viewport);
-                break;
-            }
-            case ImGuiTestInputType_ViewportSetPos:
-            {
-                if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
-                    break;
-                IM_ASSERT(engine->TestContext != nullptr);
-                ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
-                if (viewport == nullptr)
-                    engine->TestContext->LogError("ViewportPlatform_SetWindowPos(%08X): cannot find viewport anymore!", input.ViewportId);
-                else if (platform_io.Platform_SetWindowPos == nullptr)
-                    engine->TestContext->LogError("ViewportPlatform_SetWindowPos(%08X): backend's Platform_SetWindowPos() is not set", input.ViewportId);
-                else
-                    platform_io.Platform_SetWindowPos(viewport, input.ViewportPosSize);
-                break;
-            }
-            case ImGuiTestInputType_ViewportSetSize:
-            {
-                if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
-                    break;
-                IM_ASSERT(engine->TestContext != nullptr);
-                ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
-                if (viewport == nullptr)
-                    engine->TestContext->LogError("ViewportPlatform_SetWindowSize(%08X): cannot find viewport anymore!", input.ViewportId);
-                else if (platform_io.Platform_SetWindowPos == nullptr)
-                    engine->TestContext->LogError("ViewportPlatform_SetWindowSize(%08X): backend's Platform_SetWindowSize() is not set", input.ViewportId);
-                else
-                    platform_io.Platform_SetWindowSize(viewport, input.ViewportPosSize);
-                break;
-            }
-            case ImGuiTestInputType_ViewportClose:
-            {
-                if ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
-                    break;
-                IM_ASSERT(engine->TestContext != nullptr);
-                ImGuiViewport* viewport = ImGui::FindViewportByID(input.ViewportId);
-                if (viewport == nullptr)
-                    engine->TestContext->LogError("ViewportPlatform_CloseWindow(%08X): cannot find viewport anymore!", input.ViewportId);
-                else
-                    viewport->PlatformRequestClose = true;
-                // FIXME: doesn't apply to actual backend
-                break;
-            }
-#else
-            case ImGuiTestInputType_ViewportFocus:
-            case ImGuiTestInputType_ViewportSetPos:
-            case ImGuiTestInputType_ViewportSetSize:
-            case ImGuiTestInputType_ViewportClose:
-                break;
+    if (mouse_hovered_viewport_focus_request)
+        ImGuiTestEngine_ApplyInput(engine, ImGuiTestInput::ForViewportFocus(mouse_hovered_viewport->ID));
 #endif
-            case ImGuiTestInputType_None:
-            default:
-                break;
-            }
-        }
-
-        engine->Inputs.Queue.resize(0);
-    }
 
     const int input_event_count_curr = g.InputEventsQueue.Size;
     for (int n = input_event_count_prev; n < input_event_count_curr; n++)
@@ -808,6 +1099,17 @@ static void ImGuiTestEngine_PreNewFrame(ImGuiTestEngine* engine, ImGuiContext* u
         engine->ToolDebugRebootUiContext = false;
     }
 
+    // Restore snapshot requested at the end of a test, while no window is being submitted
+    if (engine->UiContextSnapshotToRestore != nullptr)
+    {
+        ImGuiTestEngine_UiContextSnapshotRestore(ui_ctx, engine->UiContextSnapshotToRestore);
+        engine->UiContextSnapshotToRestore = nullptr;
+    }
+
+    // Virtual clock replaces wall clock time measured by backend (explicit SetDeltaTime() calls have priority)
+    if (engine->IO.IsUsingVirtualClock && engine->OverrideDeltaTime < 0.0f)
+        engine->OverrideDeltaTime = engine->IO.ConfigVirtualClockDeltaTime;
+
     // Inject extra time into the Dear ImGui context
     if (engine->OverrideDeltaTime >= 0.0f)
     {
@@ -856,6 +1158,42 @@ static void ImGuiTestEngine_PreNewFrame(ImGuiTestEngine* engine, ImGuiContext* u
     ImGuiTestEngine_UpdateHooks(engine);
 }
 
+// Scoped CPU time/hardware counters around GuiFunc and ImGui::Render(), accumulated into engine->PerfCounters.Frame.
+// Samples are collected by PerfMeasureFrames() after each yield, so one sample covers Render(N) + GuiFunc(N+1).
+static void ImGuiTestEngine_PerfCountersScopeBegin(ImGuiTestEngine* engine)
+{
+    ImGuiTestContext* ctx = engine->TestContext;
+    if (!engine->IO.ConfigPerfCounters || ctx == nullptr || !ctx->PerfMeasuring)
+        return;
+
+    ImGuiTestPerfCounters* counters = &engine->PerfCounters;
+    if (!counters->Group.IsOpen() && !counters->GroupOpenFailed && !counters->Group.Open())
+    {
+        counters->GroupOpenFailed = true;
+        ctx->LogWarning("Hardware performance counters are not available, only measuring CPU time.");
+    }
+    counters->ScopeActive = true;
+    counters->ScopeStart.CpuTimeNs = ImThreadGetCpuTimeInNanoseconds();
+    counters->HasCpuTime = (counters->ScopeStart.CpuTimeNs != 0);
+    if (!counters->Group.Read(counters->ScopeStart.Values))
+        memset(counters->ScopeStart.Values, 0, sizeof(counters->ScopeStart.Values));
+}
+
+static void ImGuiTestEngine_PerfCountersScopeEnd(ImGuiTestEngine* engine)
+{
+    ImGuiTestPerfCounters* counters = &engine->PerfCounters;
+    if (!counters->ScopeActive)
+        return;
+    counters->ScopeActive = false;
+
+    ImGuiTestPerfCounterSample end;
+    end.CpuTimeNs = ImThreadGetCpuTimeInNanoseconds();
+    counters->Frame.CpuTimeNs += end.CpuTimeNs - counters->ScopeStart.CpuTimeNs;
+    if (counters->Group.Read(end.Values))
+        for (int n = 0; n < ImPerfCounter_COUNT; n++)
+            counters->Frame.Values[n] += end.Values[n] - counters->ScopeStart.Values[n];
+}
+
 static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
 {
     if (engine->UiContextTarget != ui_ctx)
@@ -868,30 +1206,110 @@ static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext*
 
     engine->IO.IsCapturing = engine->CaptureContext.IsCapturing();
 
-    // Garbage collect unused tasks
+    // Garbage collect unused tasks (compacting the active list in place, recycling task storage)
     const int LOCATION_TASK_ELAPSE_FRAMES = 20;
+    int tasks_kept = 0;
     for (int task_n = 0; task_n < engine->InfoTasks.Size; task_n++)
     {
         ImGuiTestInfoTask* task = engine->InfoTasks[task_n];
         if (task->FrameCount < engine->FrameCount - LOCATION_TASK_ELAPSE_FRAMES)
         {
-            IM_DELETE(task);
-            engine->InfoTasks.erase(engine->InfoTasks.Data + task_n);
-            task_n--;
+            engine->InfoTasksMap.Remove(task->ID);
+            engine->InfoTasksPool.push_back(task);
+        }
+        else
+        {
+            engine->InfoTasks[tasks_kept++] = task;
         }
     }
+    engine->InfoTasks.resize(tasks_kept);
+
+    // Disable clipping for this frame if requested by a FindByLabel task (see ItemInfoHandleWildcardSearch()).
+    // Logging already disables clipping in ItemAdd(), ImGuiListClipper and child windows, so we log into a buffer which is discarded
+    // in ImGuiTestEngine_PreEndFrame(). Auto-open depth of 0 ensures tree nodes are not opened by logging.
+    // Skipped while the application/test is logging (LogBegin() would assert), clipping is already disabled in that case.
+    if (engine->FindByLabelTasksUsedMask != 0 && !ui_ctx->LogEnabled)
+        for (const ImGuiTestFindByLabelTask& label_task : engine->FindByLabelTasks)
+            if (label_task.InNoClip && label_task.InSuffix != nullptr)
+            {
+#if IMGUI_VERSION_NUM >= 19150
+                ImGui::LogBegin(ImGuiLogFlags_OutputBuffer, 0);
+#else
+                ImGui::LogBegin(ImGuiLogType_Buffer, 0);
+#endif
+                engine->NoClipActive = true;
+                break;
+            }
 
     // Slow down whole app
     if (engine->ToolSlowDown)
         ImThreadSleepInMilliseconds(engine->ToolSlowDownMs);
 
     // Call user GUI function
+    ImGuiTestEngine_PerfCountersScopeBegin(engine);
     ImGuiTestEngine_RunGuiFunc(engine);
+    ImGuiTestEngine_PerfCountersScopeEnd(engine);
 }
 
-static void ImGuiTestEngine_PreEndFrame(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
+// Virtual clock is only used while running test functions at normal/cinematic speed. Perf measurements need real time.
+static bool ImGuiTestEngine_CanUseVirtualClock(ImGuiTestEngine* engine)
+{
+    ImGuiTestContext* ctx = engine->TestContext;
+    if (!engine->IO.ConfigVirtualClock || !engine->IO.IsRunningTests || engine->IO.ConfigRunSpeed == ImGuiTestRunSpeed_Fast || ctx == nullptr)
+        return false;
+    if ((ctx->RunFlags & ImGuiTestRunFlags_GuiFuncOnly) || ctx->PerfMeasuring)
+        return false;
+    return engine->IO.ConfigVirtualClockDeltaTime > 0.0f;
+}
+
+// Rendering is required by captures, GUI func only runs, perf measurements and platform windows.
+// Pending texture requests are processed by the renderer, so we render until they are serviced.
+// When checking draw data integrity, we still render regularly so the check keeps running.
+static bool ImGuiTestEngine_CanSkipRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
 {
     IM_UNUSED(ui_ctx);
+    ImGuiTestContext* ctx = engine->TestContext;
+    if (!engine->IO.ConfigSkipRender || !engine->IO.IsRunningTests || engine->IO.ConfigRunSpeed != ImGuiTestRunSpeed_Fast || ctx == nullptr)
+        return false;
+    if ((ctx->RunFlags & (ImGuiTestRunFlags_GuiFuncOnly | ImGuiTestRunFlags_GuiFuncDisable)) || ctx->PerfMeasuring)
+        return false;
+    if (engine->CaptureCurrentArgs != nullptr || engine->CaptureContext.IsCapturing() || engine->CaptureTool._StateIsCapturing)
+        return false;
+    if (engine->IO.CheckDrawDataIntegrity && (engine->FrameCount % 16) == 0)
+        return false;
+#ifdef IMGUI_HAS_VIEWPORT
+    if (ui_ctx->IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+        return false;
+#endif
+#ifdef IMGUI_HAS_TEXTURES
+    for (ImTextureData* tex : ui_ctx->IO.Fonts->TexList)
+        if (tex->Status != ImTextureStatus_OK && tex->Status != ImTextureStatus_Destroyed)
+            return false;
+#endif
+    return true;
+}
+
+static void ImGuiTestEngine_PreEndFrame(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
+{
+    // Restore clipping
+    // (GuiFunc may have called LogFinish() during the frame, in which case there's nothing left to finish)
+    if (engine->NoClipActive)
+    {
+#if IMGUI_VERSION_NUM >= 19150
+        const bool log_to_buffer = (ui_ctx->LogFlags & ImGuiLogFlags_OutputBuffer) != 0;
+#else
+        const bool log_to_buffer = ui_ctx->LogType == ImGuiLogType_Buffer;
+#endif
+        if (ui_ctx->LogEnabled && log_to_buffer)
+            ImGui::LogFinish();
+        engine->NoClipActive = false;
+    }
+
+    // Invalidate label index for windows which were closed
+    if (engine->LabelIndex.Entries.Size > 0)
+        for (ImGuiWindow* window : ui_ctx->Windows)
+            if (window->WasActive && !window->Active)
+                ImGuiTestEngine_LabelIndexInvalidateWindow(engine, window->ID);
 
     // Call user Test Function
     // (process on-going queues in a coroutine)
@@ -900,11 +1318,13 @@ static void ImGuiTestEngine_PreEndFrame(ImGuiTestEngine* engine, ImGuiContext* u
     // Update hooks and output flags
     ImGuiTestEngine_UpdateHooks(engine);
 
-    // Disable vsync
-    engine->IO.IsRequestingMaxAppSpeed = engine->IO.ConfigNoThrottle;
+    // Disable vsync (no need to wait on wall clock when using virtual clock)
+    engine->IO.IsUsingVirtualClock = ImGuiTestEngine_CanUseVirtualClock(engine);
+    engine->IO.IsRequestingMaxAppSpeed = engine->IO.ConfigNoThrottle || engine->IO.IsUsingVirtualClock;
     if (engine->IO.ConfigRunSpeed == ImGuiTestRunSpeed_Fast && engine->IO.IsRunningTests)
         if (engine->TestContext && (engine->TestContext->RunFlags & ImGuiTestRunFlags_GuiFuncOnly) == 0)
             engine->IO.IsRequestingMaxAppSpeed = true;
+    engine->IO.IsRequestingSkipRender = engine->IO.IsRequestingMaxAppSpeed && ImGuiTestEngine_CanSkipRender(engine, ui_ctx);
 }
 
 static void ImGuiTestEngine_PreRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -914,6 +1334,7 @@ static void ImGuiTestEngine_PreRender(ImGuiTestEngine* engine, ImGuiContext* ui_
     IM_ASSERT(ui_ctx == GImGui);
 
     engine->CaptureContext.PreRender();
+    ImGuiTestEngine_PerfCountersScopeBegin(engine);
 }
 
 static void ImGuiTestEngine_PostRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -921,6 +1342,7 @@ static void ImGuiTestEngine_PostRender(ImGuiTestEngine* engine, ImGuiContext* ui
     if (engine->UiContextTarget != ui_ctx)
         return;
     IM_ASSERT(ui_ctx == GImGui);
+    ImGuiTestEngine_PerfCountersScopeEnd(engine);
 
     // When test are running make sure real backend doesn't pick mouse cursor shape from tests.
     // (If were to instead set io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange in ImGuiTestEngine_RunTest() that would get us 99% of the way,
@@ -971,8 +1393,12 @@ static void ImGuiTestEngine_RunTestFunc(ImGuiTestEngine* engine)
     // Run the test coroutine. This will resume the test queue from either the last point the test called YieldFromCoroutine(),
     // or the loop in ImGuiTestEngine_TestQueueCoroutineMain that does so if no test is running.
     // If you want to breakpoint the point execution continues in the test code, breakpoint the exit condition in YieldFromCoroutine()
+    // (coroutine may run on this thread, backup current engine in case another engine is running a test on this thread)
     const int input_queue_size_before = ui_ctx->InputEventsQueue.Size;
+    ImGuiTestEngine* backup_current_engine = GImGuiTestEngineCurrent;
+    GImGuiTestEngineCurrent = engine;
     engine->IO.CoroutineFuncs->RunFunc(engine->TestQueueCoroutine);
+    GImGuiTestEngineCurrent = backup_current_engine;
 
     // Events added by TestFunc() marked automaticaly to not be deleted
     if (engine->TestContext && (engine->TestContext->RunFlags & ImGuiTestRunFlags_EnableRawInputs))
@@ -980,14 +1406,34 @@ static void ImGuiTestEngine_RunTestFunc(ImGuiTestEngine* engine)
             ui_ctx->InputEventsQueue[n].AddedByTestEngine = true;
 }
 
+// Called on coroutine side when starting or resuming.
+// Coroutine may run on its own thread: set current engine and Dear ImGui context for this thread (GImGui may be thread-local).
+// Context is the one which was current on coroutine side when it yielded, so test code switching contexts finds it unchanged.
+static void ImGuiTestEngine_CoroutineResumed(ImGuiTestEngine* engine)
+{
+    GImGuiTestEngineCurrent = engine;
+    if (engine->TestQueueCoroutineUiContext != nullptr)
+        ImGui::SetCurrentContext(engine->TestQueueCoroutineUiContext);
+}
+
+// Called on coroutine side
+static void ImGuiTestEngine_CoroutineYield(ImGuiTestEngine* engine)
+{
+    engine->TestQueueCoroutineUiContext = ImGui::GetCurrentContext();
+    engine->IO.CoroutineFuncs->YieldFunc();
+    ImGuiTestEngine_CoroutineResumed(engine);
+}
+
 // Main function for the test coroutine
 static void ImGuiTestEngine_TestQueueCoroutineMain(void* engine_opaque)
 {
     ImGuiTestEngine* engine = (ImGuiTestEngine*)engine_opaque;
+    engine->TestQueueCoroutineUiContext = engine->UiContextTarget;
+    ImGuiTestEngine_CoroutineResumed(engine);
     while (!engine->TestQueueCoroutineShouldExit)
     {
         ImGuiTestEngine_ProcessTestQueue(engine);
-        engine->IO.CoroutineFuncs->YieldFunc();
+        ImGuiTestEngine_CoroutineYield(engine);
     }
 }
 
@@ -1014,7 +1460,17 @@ void ImGuiTestEngine_Yield(ImGuiTestEngine* engine)
         }
     }
 
-    engine->IO.CoroutineFuncs->YieldFunc();
+    ImGuiTestEngine_CoroutineYield(engine);
+}
+
+// Called from the test coroutine. Queue is drained by ImGuiTestEngine_ApplyInputToImGuiContext().
+void ImGuiTestEngine_PushInput(ImGuiTestEngine* engine, const ImGuiTestInput& input)
+{
+    while (!engine->Inputs.Queue.Push(input))
+    {
+        IM_ASSERT(engine->TestContext != nullptr && "Input queue is full!");
+        ImGuiTestEngine_Yield(engine);
+    }
 }
 
 void ImGuiTestEngine_SetDeltaTime(ImGuiTestEngine* engine, float delta_time)
@@ -1231,10 +1687,34 @@ void ImGuiTestEngine_QueueTest(ImGuiTestEngine* engine, ImGuiTest* test, ImGuiTe
     ImGuiTestRunTask run_task;
     run_task.Test = test;
     run_task.RunFlags = run_flags;
+    if (ImGuiTestTimingHistoryEntry* history = ImGuiTestEngine_GetTestHistory(engine, test))
+        if (history->Duration >= 0.0f)
+            run_task.PredictedDuration = history->Duration;
     engine->TestsQueue.push_back(run_task);
 }
 
-// Called by IM_REGISTER_TEST(). Prefer calling IM_REGISTER_TEST() in your code so src_file/src_line are automatically passed.
+void ImGuiTestEngine_ClearTestQueue(ImGuiTestEngine* engine)
+{
+    IM_ASSERT(engine->IO.IsRunningTests == false);
+    for (ImGuiTestRunTask& run_task : engine->TestsQueue)
+        if (run_task.Test->Output.Status == ImGuiTestStatus_Queued)
+            run_task.Test->Output.Status = ImGuiTestStatus_Unknown;
+    engine->TestsQueue.clear();
+}
+
+// Batch time range is extended to cover merged outputs (used by exporters).
+void ImGuiTestEngine_MergeTestOutput(ImGuiTestEngine* engine, ImGuiTest* test, const ImGuiTestOutput* output)
+{
+    IM_ASSERT(!ImGuiTestEngine_IsRunningTest(engine, test));
+    IM_ASSERT(output->Status != ImGuiTestStatus_Running && output->Status != ImGuiTestStatus_Queued);
+    test->Output = *output;
+    if (output->StartTime != 0 && (engine->BatchStartTime == 0 || output->StartTime < engine->BatchStartTime))
+        engine->BatchStartTime = output->StartTime;
+    engine->BatchEndTime = ImMax(engine->BatchEndTime, output->EndTime);
+    ImGuiTestEngine_RecordTestHistory(engine, test, -1);
+}
+
+// Called by IM_REGISTER_TEST(). Prefer calling IM_REGISTER_TEST() in your code so src_file/src_line are automatically passed.
 ImGuiTest* ImGuiTestEngine_RegisterTest(ImGuiTestEngine* engine, const char* category, const char* name, const char* src_file, int src_line)
 {
     ImGuiTestGroup group = ImGuiTestGroup_Tests;
@@ -1411,6 +1891,7 @@ bool ImGuiTestEngine_PassFilter(ImGuiTest* test, const char* filter_specs)
 void ImGuiTestEngine_QueueTests(ImGuiTestEngine* engine, ImGuiTestGroup group, const char* filter_str, ImGuiTestRunFlags run_flags)
 {
     IM_ASSERT(group >= ImGuiTestGroup_Unknown && group < ImGuiTestGroup_COUNT);
+    const int queue_start = engine->TestsQueue.Size;
     for (int n = 0; n < engine->TestsAll.Size; n++)
     {
         ImGuiTest* test = engine->TestsAll[n];
@@ -1423,6 +1904,7 @@ void ImGuiTestEngine_QueueTests(ImGuiTestEngine* engine, ImGuiTestGroup group, c
 
         ImGuiTestEngine_QueueTest(engine, test, run_flags);
     }
+    ImGuiTestEngine_ScheduleTests(engine, queue_start);
 }
 
 void ImGuiTestEngine_UpdateTestsSourceLines(ImGuiTestEngine* engine)
@@ -1491,9 +1973,23 @@ void ImGuiTestEngine_GetTestList(ImGuiTestEngine* engine, ImVector<ImGuiTest*>*
 }
 
 // Get a copy of the test queue
-void ImGuiTestEngine_GetTestQueue(ImGuiTestEngine* engine, ImVector<ImGuiTestRunTask>* out_tests)
+void ImGuiTestEngine_GetTestQueue(ImGuiTestEngine* engine, ImVector<ImGuiTestRunTask>* out_tests, float* out_predicted_total_duration)
 {
     *out_tests = engine->TestsQueue;
+    if (out_predicted_total_duration == nullptr)
+        return;
+
+    // Tests without history are estimated using the average of known ones
+    float total_known = 0.0f;
+    int count_known = 0;
+    for (const ImGuiTestRunTask& run_task : engine->TestsQueue)
+        if (run_task.PredictedDuration >= 0.0f)
+        {
+            total_known += run_task.PredictedDuration;
+            count_known++;
+        }
+    const int count_unknown = engine->TestsQueue.Size - count_known;
+    *out_predicted_total_duration = total_known + (count_known > 0 ? total_known / count_known * count_unknown : 0.0f);
 }
 
 static void ImGuiTestEngine_UpdateHooks(ImGuiTestEngine* engine)
@@ -1507,9 +2003,11 @@ static void ImGuiTestEngine_UpdateHooks(ImGuiTestEngine* engine)
 
     if (engine->InfoTasks.Size > 0)
         want_hooking = true;
-    if (engine->FindByLabelTask.InSuffix != nullptr)
+    if (engine->FindByLabelTasksUsedMask != 0)
+        want_hooking = true;
+    if (engine->GatherTasksUsedMask != 0)
         want_hooking = true;
-    if (engine->GatherTask.InParentID != 0)
+    if (engine->IO.ConfigLabelIndex && engine->TestContext != nullptr)
         want_hooking = true;
 
     // Update test engine specific hooks
@@ -1589,6 +2087,95 @@ struct ImGuiTestContextUiContextBackup
     }
 };
 
+static int IMGUI_CDECL ImGuiTestUiWindowSnapshot_Compare(const void* lhs, const void* rhs)
+{
+    const ImGuiID a = ((const ImGuiTestUiWindowSnapshot*)lhs)->WindowID;
+    const ImGuiID b = ((const ImGuiTestUiWindowSnapshot*)rhs)->WindowID;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+void ImGuiTestEngine_UiContextSnapshotCapture(ImGuiContext* ui_ctx, ImGuiTestUiContextSnapshot* snapshot)
+{
+    ImGuiContext& g = *ui_ctx;
+    snapshot->FrameCount = g.FrameCount;
+    snapshot->NavWindowID = g.NavWindow ? g.NavWindow->ID : 0;
+    snapshot->OpenPopupCount = g.OpenPopupStack.Size;
+
+    snapshot->Windows.resize(g.Windows.Size);
+    for (int n = 0; n < g.Windows.Size; n++)
+    {
+        ImGuiWindow* window = g.Windows[n];
+        ImGuiTestUiWindowSnapshot* window_snapshot = &snapshot->Windows[n];
+        window_snapshot->WindowID = window->ID;
+        window_snapshot->Pos = window->Pos;
+        window_snapshot->SizeFull = window->SizeFull;
+        window_snapshot->Collapsed = window->Collapsed;
+        window_snapshot->WasActive = (window->LastFrameActive == g.FrameCount); // Snapshot is taken from TestFunc, after application submitted its windows for the frame
+    }
+    ImQsort(snapshot->Windows.Data, (size_t)snapshot->Windows.Size, sizeof(ImGuiTestUiWindowSnapshot), ImGuiTestUiWindowSnapshot_Compare);
+
+    snapshot->ActiveTables.resize(0);
+#ifdef IMGUI_HAS_TABLE
+    for (int n = 0; n < g.Tables.GetMapSize(); n++)
+        if (ImGuiTable* table = g.Tables.TryGetMapData(n))
+            if (table->LastFrameActive >= g.FrameCount - 1)
+                snapshot->ActiveTables.push_back(table->ID);
+#endif
+}
+
+// Called between frames (from ImGuiTestEngine_PreNewFrame()) after a test ended. Only windows and tables submitted since the snapshot are processed.
+// If the context was recreated since the snapshot, none of its windows/tables are recent enough to be processed.
+void ImGuiTestEngine_UiContextSnapshotRestore(ImGuiContext* ui_ctx, ImGuiTestUiContextSnapshot* snapshot)
+{
+    ImGuiContext& g = *ui_ctx;
+    if (snapshot->FrameCount < 0)
+        return;
+
+    // Identifiers and popups
+    if (g.ActiveId != 0)
+        ImGui::ClearActiveID();
+    if (g.OpenPopupStack.Size > snapshot->OpenPopupCount)
+        ImGui::ClosePopupToLevel(snapshot->OpenPopupCount, false);
+
+    // Windows submitted by the test: restore position/size and make them 'Appearing' on their next Begin()
+    for (ImGuiWindow* window : g.Windows)
+    {
+        if (window->LastFrameActive < snapshot->FrameCount)
+            continue;
+        ImGuiTestUiWindowSnapshot key;
+        key.WindowID = window->ID;
+        ImGuiTestUiWindowSnapshot* window_snapshot = (ImGuiTestUiWindowSnapshot*)bsearch(&key, snapshot->Windows.Data, (size_t)snapshot->Windows.Size, sizeof(ImGuiTestUiWindowSnapshot), ImGuiTestUiWindowSnapshot_Compare);
+        if (window_snapshot && window_snapshot->WasActive)
+            continue;
+        if (window_snapshot != nullptr)
+        {
+            if (window->Pos.x != window_snapshot->Pos.x || window->Pos.y != window_snapshot->Pos.y)
+                ImGui::SetWindowPos(window, window_snapshot->Pos, ImGuiCond_Always);
+            if (window->SizeFull.x != window_snapshot->SizeFull.x || window->SizeFull.y != window_snapshot->SizeFull.y)
+                ImGui::SetWindowSize(window, window_snapshot->SizeFull, ImGuiCond_Always);
+            if (window->Collapsed != window_snapshot->Collapsed)
+                ImGui::SetWindowCollapsed(window, window_snapshot->Collapsed, ImGuiCond_Always);
+        }
+        window->LastFrameActive = ImMin(window->LastFrameActive, g.FrameCount - 1);
+    }
+
+    // Tables submitted by the test
+#ifdef IMGUI_HAS_TABLE
+    ImVector<ImGuiID> tables_to_discard;
+    for (int n = 0; n < g.Tables.GetMapSize(); n++)
+        if (ImGuiTable* table = g.Tables.TryGetMapData(n))
+            if (table->LastFrameActive >= snapshot->FrameCount && !snapshot->ActiveTables.contains(table->ID))
+                tables_to_discard.push_back(table->ID);
+    for (ImGuiID table_id : tables_to_discard)
+        TableDiscardInstanceAndSettings(table_id);
+#endif
+
+    // Focus
+    ImGuiWindow* nav_window = snapshot->NavWindowID ? ImGui::FindWindowByID(snapshot->NavWindowID) : nullptr;
+    if (g.NavWindow != nav_window)
+        ImGui::FocusWindow(nav_window);
+}
+
 // FIXME: Work toward simplifying this function?
 void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_ctx, ImGuiTest* test, ImGuiTestRunFlags run_flags)
 {
@@ -1609,6 +2196,7 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
         ctx->Engine = engine;
         ctx->EngineIO = &engine->IO;
         ctx->Inputs = &engine->Inputs;
+        ctx->Arena = &engine->TestArena;
         ctx->CaptureArgs = &stack_capture_args;
         ctx->UserVars = nullptr;
         ctx->PerfStressAmount = engine->IO.PerfStressAmount;
@@ -1644,6 +2232,15 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
 
     test_output->Status = ImGuiTestStatus_Running;
 
+    // Transient allocations are released in one step when the test ends.
+    // Child tests rewind to where the parent was, top-level tests reset the whole arena.
+    ImGuiTestArenaMarker backup_arena_marker = engine->TestArena.GetMarker();
+    if (parent_ctx == nullptr)
+    {
+        engine->TestArena.Reset();
+        engine->TestArena.ResetCounters();
+    }
+
     ctx->RunFlags = run_flags;
     ctx->UiContext = engine->UiContextActive;
 
@@ -1678,7 +2275,7 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
         ctx->GenericVars.Clear();
         if (test->VarsConstructor != nullptr)
         {
-            ctx->UserVars = IM_ALLOC(test->VarsSize);
+            ctx->UserVars = engine->TestArena.Alloc(test->VarsSize);
             memset(ctx->UserVars, 0, test->VarsSize);
             test->VarsConstructor(ctx->UserVars);
             if (test->VarsPostConstructor != nullptr && test->VarsPostConstructorUserFn != nullptr)
@@ -1702,9 +2299,20 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
     // Clear ImGui inputs to avoid key/mouse leaks from one test to another
     ImGuiTestEngine_ClearInput(engine);
 
+    // Labels recorded by previous test are likely to refer to different items (e.g. many tests use a "Test Window")
+    // Reference perf counters are only meaningful for the test which measured them (same as ctx->PerfRefSamples)
+    if (parent_ctx == nullptr)
+    {
+        engine->LabelIndex.Clear();
+        engine->PerfCounters.RefSamples.resize(0);
+    }
+
     // Backup entire IO and style. Allows tests modifying them and not caring about restoring state.
     ImGuiTestContextUiContextBackup backup_ui_context;
     backup_ui_context.Backup(*ctx->UiContext);
+    const bool use_ui_context_snapshot = (parent_ctx == nullptr && engine->IO.ConfigUiContextSnapshot);
+    if (use_ui_context_snapshot)
+        ImGuiTestEngine_UiContextSnapshotCapture(ctx->UiContext, &engine->UiContextSnapshot);
 
     // Setup IO: software mouse cursor, viewport support
     ImGuiIO& io = ctx->UiContext->IO;
@@ -1885,10 +2493,21 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
         ctx->LogError("%s test failed.", test->Name);
     else
         ctx->LogWarning("Unknown status.");
+    if (parent_ctx == nullptr)
+        ImGuiTestEngine_RecordTestHistory(engine, test, ctx->FrameCount - ctx->FirstTestFrameCount);
 
     // Additional yields to avoid consecutive tests who may share identifiers from missing their window/item activation.
+    // With a snapshot, we restore the state those yields are waiting for directly (windows not appearing, active id, popups).
     ctx->RunFlags |= ImGuiTestRunFlags_GuiFuncDisable;
-    ctx->Yield(2);
+    if (use_ui_context_snapshot)
+    {
+        engine->UiContextSnapshotToRestore = &engine->UiContextSnapshot;
+        ctx->Yield();
+    }
+    else
+    {
+        ctx->Yield(2);
+    }
 
     // Restore active func
     ctx->ActiveFunc = backup_active_func;
@@ -1910,9 +2529,7 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
         if (test->VarsConstructor != nullptr)
         {
             test->VarsDestructor(ctx->UserVars);
-            if (ctx->UserVars)
-                IM_FREE(ctx->UserVars);
-            ctx->UserVars = nullptr;
+            ctx->UserVars = nullptr;   // Storage is owned by engine->TestArena
         }
         if (run_flags & ImGuiTestRunFlags_ShareTestContext)
         {
@@ -1921,6 +2538,22 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
         }
     }
 
+    // Release transient allocations
+    ImGuiTestArena* arena = &engine->TestArena;
+    if (parent_ctx == nullptr)
+    {
+        test_output->ArenaAllocCount = arena->AllocCount;
+        test_output->ArenaChunkAllocCount = arena->ChunkAllocCount;
+        test_output->ArenaPeakBytes = arena->PeakBytes;
+        ctx->LogDebug("Arena: %d allocations, %d heap allocations, %d bytes peak.", arena->AllocCount, arena->ChunkAllocCount, (int)arena->PeakBytes);
+        arena->Reset();
+        arena->Trim();  // Don't hold on to large one-off buffers (e.g. KeyChars() text) between tests
+    }
+    else
+    {
+        arena->ResetToMarker(backup_arena_marker);
+    }
+
     IM_ASSERT(engine->TestContext == ctx);
     engine->TestContext = parent_ctx;
 }
@@ -2013,10 +2646,14 @@ void ImGuiTestEngine_ErrorRecoveryRun(ImGuiTestEngine* engine)
 
 void ImGuiTestEngine_CrashHandler()
 {
-    ImGuiContext& g = *GImGui;
-    ImGuiTestEngine* engine = (ImGuiTestEngine*)g.TestEngine;
+    ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine();
+    if (engine == nullptr)
+        return;
     ImGuiTest* crashed_test = (engine->TestContext && engine->TestContext->Test) ? engine->TestContext->Test : nullptr;
 
+    // Write pending asynchronous log output first (bounded wait: writer thread may be the one which crashed)
+    ImGuiTestEngine_FlushLogOutputEx(engine, 500);
+
     ImOsConsoleSetTextColor(ImOsConsoleStream_StandardError, ImOsConsoleTextColor_BrightRed);
     if (crashed_test != nullptr)
         fprintf(stderr, "**ImGuiTestEngine_CrashHandler()** Crashed while running \"%s\" :(\n", crashed_test->Name);
@@ -2087,11 +2724,10 @@ void ImGuiTestEngine_InstallDefaultCrashHandler()
 //-------------------------------------------------------------------------
 
 // This is rather slow at it runs on all items but only during a GatherItems() operations.
-static void ImGuiTestEngineHook_ItemAdd_GatherTask(ImGuiContext* ui_ctx, ImGuiTestEngine* engine, ImGuiID id, const ImRect& bb, const ImGuiLastItemData* item_data)
+static void ImGuiTestEngineHook_ItemAdd_GatherTask(ImGuiContext* ui_ctx, ImGuiTestEngine* engine, ImGuiTestGatherTask* task, ImGuiID id, const ImRect& bb, const ImGuiLastItemData* item_data)
 {
     ImGuiContext& g = *ui_ctx;
     ImGuiWindow* window = g.CurrentWindow;
-    ImGuiTestGatherTask* task = &engine->GatherTask;
 
     if ((task->InLayerMask & (1 << window->DC.NavLayerCurrent)) == 0)
         return;
@@ -2161,11 +2797,14 @@ void ImGuiTestEngineHook_ItemAdd(ImGuiContext* ui_ctx, ImGuiID id, const ImRect&
     ImGuiTestEngine* engine = (ImGuiTestEngine*)ui_ctx->TestEngine;
 
     IM_ASSERT(id != 0);
+
+    // Early out if there are no active Info/Gather tasks (see ImGuiTestEngine_UpdateHooks())
+    if (!ui_ctx->TestEngineHookItems)
+        return;
+
     ImGuiContext& g = *ui_ctx;
     ImGuiWindow* window = g.CurrentWindow;
 
-    // FIXME-OPT: Early out if there are no active Info/Gather tasks.
-
     // Info Tasks
     if (ImGuiTestInfoTask* task = ImGuiTestEngine_FindInfoTask(engine, id))
     {
@@ -2187,9 +2826,11 @@ void ImGuiTestEngineHook_ItemAdd(ImGuiContext* ui_ctx, ImGuiID id, const ImRect&
         item->StatusFlags = item_data ? item_data->StatusFlags : ImGuiItemStatusFlags_None;
     }
 
-    // Gather Task (only 1 can be active)
-    if (engine->GatherTask.InParentID != 0)
-        ImGuiTestEngineHook_ItemAdd_GatherTask(ui_ctx, engine, id, bb, item_data);
+    // Gather Tasks
+    if (engine->GatherTasksUsedMask != 0)
+        for (ImGuiTestGatherTask& gather_task : engine->GatherTasks)
+            if (gather_task.InParentID != 0)
+                ImGuiTestEngineHook_ItemAdd_GatherTask(ui_ctx, engine, &gather_task, id, bb, item_data);
 }
 
 #if IMGUI_VERSION_NUM < 18934
@@ -2201,18 +2842,16 @@ void    ImGuiTestEngineHook_ItemAdd(ImGuiContext* ui_ctx, const ImRect& bb, ImGu
 
 // Task is submitted in TestFunc by ItemInfo() -> ItemInfoHandleWildcardSearch()
 #ifdef IMGUI_HAS_IMSTR
-static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiID id, const ImStrv label, ImGuiItemStatusFlags flags)
+static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiTestFindByLabelTask* label_task, ImGuiID id, const ImStrv label, ImGuiItemStatusFlags flags)
 #else
-static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiID id, const char* label, ImGuiItemStatusFlags flags)
+static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiTestFindByLabelTask* label_task, ImGuiID id, const char* label, ImGuiItemStatusFlags flags)
 #endif
 {
     // At this point "label" is a match for the right-most name in user wildcard (e.g. the "bar" of "**/foo/bar"
     ImGuiContext& g = *ui_ctx;
-    ImGuiTestEngine* engine = (ImGuiTestEngine*)ui_ctx->TestEngine;
     IM_UNUSED(label); // Match ABI of caller function (faster call)
 
     // Test for matching status flags
-    ImGuiTestFindByLabelTask* label_task = &engine->FindByLabelTask;
     if (ImGuiItemStatusFlags filter_flags = label_task->InFilterItemStatusFlags)
         if (!(filter_flags & flags))
             return;
@@ -2288,6 +2927,9 @@ void ImGuiTestEngineHook_ItemInfo(ImGuiContext* ui_ctx, ImGuiID id, const char*
     ImGuiTestEngine* engine = (ImGuiTestEngine*)ui_ctx->TestEngine;
 
     IM_ASSERT(id != 0);
+    if (!ui_ctx->TestEngineHookItems)
+        return;
+
     ImGuiContext& g = *ui_ctx;
     //ImGuiWindow* window = g.CurrentWindow;
     //IM_ASSERT(window->DC.LastItemId == id || window->DC.LastItemId == 0); // Need _ItemAdd() to be submitted before _ItemInfo()
@@ -2302,27 +2944,34 @@ void ImGuiTestEngineHook_ItemInfo(ImGuiContext* ui_ctx, ImGuiID id, const char*
             ImStrncpy(item->DebugLabel, label, IM_ARRAYSIZE(item->DebugLabel));
     }
 
-    // Update Gather Task status flags
-    if (engine->GatherTask.LastItemInfo && engine->GatherTask.LastItemInfo->ID == id)
-    {
-        ImGuiTestItemInfo* item = engine->GatherTask.LastItemInfo;
-        item->TimestampStatus = g.FrameCount;
-        item->StatusFlags = flags;
-        if (label)
-            ImStrncpy(item->DebugLabel, label, IM_ARRAYSIZE(item->DebugLabel));
-    }
+    // Update Gather Tasks status flags
+    if (engine->GatherTasksUsedMask != 0)
+        for (ImGuiTestGatherTask& gather_task : engine->GatherTasks)
+            if (gather_task.LastItemInfo && gather_task.LastItemInfo->ID == id)
+            {
+                ImGuiTestItemInfo* item = gather_task.LastItemInfo;
+                item->TimestampStatus = g.FrameCount;
+                item->StatusFlags = flags;
+                if (label)
+                    ImStrncpy(item->DebugLabel, label, IM_ARRAYSIZE(item->DebugLabel));
+            }
 
-    // Update Find by Label Task
+    // Update Find by Label Tasks and label index (label is hashed once for all active tasks)
     // FIXME-TESTS FIXME-OPT: Compare by hashes instead of strcmp to support "###" operator.
     // Perhaps we could use strcmp() if we detect that ### is not used, that would be faster.
-    ImGuiTestFindByLabelTask* label_task = &engine->FindByLabelTask;
-    if (label && label_task->InSuffixLastItem && label_task->OutItemId == 0)
+    if (label && (engine->FindByLabelTasksUsedMask != 0 || engine->IO.ConfigLabelIndex))
+    {
 #ifdef IMGUI_HAS_IMSTR
-        if (label_task->InSuffixLastItemHash == ImHashStr(label))
+        const ImGuiID label_hash = ImHashStr(label);
 #else
-        if (label_task->InSuffixLastItemHash == ImHashStr(label, 0))
+        const ImGuiID label_hash = ImHashStr(label, 0);
 #endif
-            ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ui_ctx, id, label, flags);
+        if (engine->IO.ConfigLabelIndex && g.CurrentWindow != nullptr)
+            ImGuiTestEngine_LabelIndexAdd(engine, g.CurrentWindow, id, label_hash, flags);
+        for (ImGuiTestFindByLabelTask& label_task : engine->FindByLabelTasks)
+            if (label_task.InSuffixLastItemHash == label_hash && label_task.InSuffixLastItem && label_task.OutItemId == 0)
+                ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ui_ctx, &label_task, id, label, flags);
+    }
 }
 
 // Forward core/user-land text to test log
@@ -2343,23 +2992,26 @@ void ImGuiTestEngineHook_Log(ImGuiContext* ui_ctx, const char* fmt, ...)
 // Your custom assert code may optionally want to call this.
 void ImGuiTestEngine_AssertLog(const char* expr, const char* file, const char* function, int line)
 {
-    if (ImGuiTestEngine* engine = GImGuiTestEngine)
+    if (ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine())
         if (ImGuiTestContext* ctx = engine->TestContext)
         {
             ctx->LogError("Assert: '%s'", expr);
             ctx->LogWarning("In %s:%d, function %s()", file, line, function);
             if (ImGuiTest* test = ctx->Test)
                 ctx->LogWarning("While running test: %s %s", test->Category, test->Name);
+            ImGuiTestEngine_FlushLogOutput(engine); // Caller is about to break/abort
         }
 }
 
 // Used by IM_CHECK_OP() macros
 ImGuiTextBuffer* ImGuiTestEngine_GetTempStringBuilder()
 {
-    static ImGuiTextBuffer builder;
-    builder.Buf.resize(1);
-    builder.Buf[0] = 0;
-    return &builder;
+    ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine();
+    IM_ASSERT(engine != nullptr && "No active tests!");
+    ImGuiTextBuffer* builder = &engine->TempStringBuilder;
+    builder->Buf.resize(1);
+    builder->Buf[0] = 0;
+    return builder;
 }
 
 // Out of convenience for main library we allow this to be called before TestEngine is initialized.
@@ -2382,13 +3034,13 @@ const char* ImGuiTestEngine_FindItemDebugLabel(ImGuiContext* ui_ctx, ImGuiID id)
 // Return true to request a debugger break
 bool ImGuiTestEngine_Check(const char* file, const char* func, int line, ImGuiTestCheckFlags flags, bool result, const char* expr)
 {
-    ImGuiTestEngine* engine = GImGuiTestEngine;
+    ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine();
     (void)func;
 
     // Removed absolute path from output so we have deterministic output (otherwise __FILE__ gives us machine dending output)
     const char* file_without_path = file ? ImPathFindFilename(file) : "";
 
-    if (ImGuiTestContext* ctx = engine->TestContext)
+    if (ImGuiTestContext* ctx = engine ? engine->TestContext : nullptr)
     {
         ImGuiTest* test = ctx->Test;
         //ctx->LogDebug("IM_CHECK(%s)", expr);
@@ -2414,12 +3066,16 @@ bool ImGuiTestEngine_Check(const char* file, const char* func, int line, ImGuiTe
     else
     {
         IM_ASSERT(0 && "No active tests!");
+        return false;
     }
 
     if (result == false && engine->IO.ConfigStopOnError && !engine->Abort)
         engine->Abort = true; //ImGuiTestEngine_Abort(engine);
     if (result == false && engine->IO.ConfigBreakOnError && !engine->Abort)
+    {
+        ImGuiTestEngine_FlushLogOutput(engine); // Caller is about to break
         return true;
+    }
 
     return false;
 }
@@ -2485,7 +3141,7 @@ bool ImGuiTestEngine_Error(const char* file, const char* func, int line, ImGuiTe
     bool ret = ImGuiTestEngine_Check(file, func, line, flags, false, buf.c_str());
     va_end(args);
 
-    ImGuiTestEngine* engine = GImGuiTestEngine;
+    ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine();
     if (engine && engine->Abort)
         return false;
     return ret;
@@ -2572,6 +3228,249 @@ static void     ImGuiTestEngine_SettingsWriteAll(ImGuiContext* ui_ctx, ImGuiSett
     buf->appendf("\n");
 }
 
+//-------------------------------------------------------------------------
+// [SECTION] TIMING HISTORY
+//-------------------------------------------------------------------------
+// - ImGuiTestTimingHistory::Find()
+// - ImGuiTestTimingHistory::GetOrAdd()
+// - ImGuiTestEngine_LoadTimingHistory()
+// - ImGuiTestEngine_SaveTimingHistory()
+// - ImGuiTestEngine_GetTestHistory()
+// - ImGuiTestEngine_RecordTestHistory()
+// - ImGuiTestEngine_ScheduleTests()
+//-------------------------------------------------------------------------
+// File format: header followed by ImGuiTestTimingHistoryEntry[Count] sorted by TestID, native endianness.
+// Files with a different magic/version/size are ignored and overwritten on next save.
+//-------------------------------------------------------------------------
+
+#define IMGUI_TEST_ENGINE_TIMING_HISTORY_MAGIC      0x48544549  // "IETH"
+#define IMGUI_TEST_ENGINE_TIMING_HISTORY_VERSION    1
+
+struct ImGuiTestTimingHistoryFileHeader
+{
+    ImU32   Magic;
+    ImU32   Version;
+    ImU32   EntrySize;
+    ImU32   Count;
+};
+
+static ImGuiID ImGuiTestEngine_GetTestHistoryID(ImGuiTest* test)
+{
+    return ImHashStr(test->Name, 0, ImHashStr(test->Category));
+}
+
+static ImGuiTestTimingHistoryEntry* ImGuiTestTimingHistory_LowerBound(ImVector<ImGuiTestTimingHistoryEntry>& entries, ImGuiID id)
+{
+    ImGuiTestTimingHistoryEntry* first = entries.begin();
+    int count = entries.Size;
+    while (count > 0)
+    {
+        int step = count >> 1;
+        ImGuiTestTimingHistoryEntry* mid = first + step;
+        if (mid->TestID < id)
+        {
+            first = mid + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return first;
+}
+
+ImGuiTestTimingHistoryEntry* ImGuiTestTimingHistory::Find(ImGuiID id)
+{
+    ImGuiTestTimingHistoryEntry* it = ImGuiTestTimingHistory_LowerBound(Entries, id);
+    return (it != Entries.end() && it->TestID == id) ? it : nullptr;
+}
+
+ImGuiTestTimingHistoryEntry* ImGuiTestTimingHistory::GetOrAdd(ImGuiID id)
+{
+    ImGuiTestTimingHistoryEntry* it = ImGuiTestTimingHistory_LowerBound(Entries, id);
+    if (it != Entries.end() && it->TestID == id)
+        return it;
+    ImGuiTestTimingHistoryEntry entry;
+    entry.TestID = id;
+    entry.Duration = -1.0f;
+    entry.FrameCount = -1;
+    entry.RunCount = 0;
+    entry.LastStatus = (ImU8)ImGuiTestStatus_Unknown;
+    entry.Reserved = 0;
+    return Entries.insert(it, entry);
+}
+
+// Timing history may be loaded/saved outside of a test: log to running test when there is one, otherwise directly to TTY/debugger.
+static void ImGuiTestEngine_LogTimingHistoryWarning(ImGuiTestEngine* engine, const char* fmt, ...) IM_FMTARGS(2);
+static void ImGuiTestEngine_LogTimingHistoryWarning(ImGuiTestEngine* engine, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    if (engine->TestContext != nullptr)
+    {
+        engine->TestContext->LogExV(ImGuiTestVerboseLevel_Warning, ImGuiTestLogFlags_None, fmt, args);
+        va_end(args);
+        return;
+    }
+    Str256 msg;
+    msg.setfv(fmt, args);
+    msg.append("\n");
+    va_end(args);
+
+    if (engine->IO.ConfigLogToTTY && engine->IO.ConfigVerboseLevel >= ImGuiTestVerboseLevel_Warning)
+    {
+        if (engine->IO.ConfigLogAsyncOutput)
+        {
+            ImGuiTestEngine_PushLogOutput(engine, ImGuiTestLogOutputTarget_TTY, ImGuiTestVerboseLevel_Warning, nullptr, msg.c_str());
+        }
+        else
+        {
+            ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_BrightYellow);
+            fputs(msg.c_str(), stdout);
+            ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
+            fflush(stdout);
+        }
+    }
+    if (engine->IO.ConfigLogToDebugger)
+        ImOsOutputDebugString(msg.c_str());
+}
+
+static void ImGuiTestEngine_LoadTimingHistory(ImGuiTestEngine* engine)
+{
+    ImGuiTestTimingHistory& history = engine->TimingHistory;
+    history.Loaded = true;
+    history.Entries.clear();
+
+    size_t file_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(engine->IO.TimingHistoryFilename, "rb", &file_size);
+    if (file_data == nullptr)
+        return;
+
+    ImGuiTestTimingHistoryFileHeader header;
+    bool valid = file_size >= sizeof(header);
+    if (valid)
+    {
+        memcpy(&header, file_data, sizeof(header));
+        valid = header.Magic == IMGUI_TEST_ENGINE_TIMING_HISTORY_MAGIC && header.Version == IMGUI_TEST_ENGINE_TIMING_HISTORY_VERSION
+            && header.EntrySize == sizeof(ImGuiTestTimingHistoryEntry) && file_size == sizeof(header) + (size_t)header.Count * sizeof(ImGuiTestTimingHistoryEntry);
+    }
+    if (valid)
+    {
+        history.Entries.resize((int)header.Count);
+        memcpy(history.Entries.Data, file_data + sizeof(header), (size_t)header.Count * sizeof(ImGuiTestTimingHistoryEntry));
+        for (int n = 1; n < history.Entries.Size && valid; n++)
+            valid = history.Entries[n - 1].TestID < history.Entries[n].TestID;
+        if (!valid)
+            history.Entries.clear();
+    }
+    if (!valid)
+        ImGuiTestEngine_LogTimingHistoryWarning(engine, "Ignoring invalid timing history file '%s'.", engine->IO.TimingHistoryFilename);
+    IM_FREE(file_data);
+}
+
+static void ImGuiTestEngine_SaveTimingHistory(ImGuiTestEngine* engine)
+{
+    ImGuiTestTimingHistory& history = engine->TimingHistory;
+    if (engine->IO.TimingHistoryFilename == nullptr || !history.Dirty)
+        return;
+
+    const char* filename = engine->IO.TimingHistoryFilename;
+    FILE* f = ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)) ? fopen(filename, "wb") : nullptr;
+    if (f == nullptr)
+    {
+        ImGuiTestEngine_LogTimingHistoryWarning(engine, "Unable to open '%s' for writing timing history.", filename);
+        return;
+    }
+    ImGuiTestTimingHistoryFileHeader header;
+    header.Magic = IMGUI_TEST_ENGINE_TIMING_HISTORY_MAGIC;
+    header.Version = IMGUI_TEST_ENGINE_TIMING_HISTORY_VERSION;
+    header.EntrySize = sizeof(ImGuiTestTimingHistoryEntry);
+    header.Count = (ImU32)history.Entries.Size;
+    fwrite(&header, sizeof(header), 1, f);
+    fwrite(history.Entries.Data, sizeof(ImGuiTestTimingHistoryEntry), (size_t)history.Entries.Size, f);
+    fclose(f);
+    history.Dirty = false;
+}
+
+ImGuiTestTimingHistoryEntry* ImGuiTestEngine_GetTestHistory(ImGuiTestEngine* engine, ImGuiTest* test)
+{
+    if (engine->IO.TimingHistoryFilename == nullptr)
+        return nullptr;
+    if (!engine->TimingHistory.Loaded)
+        ImGuiTestEngine_LoadTimingHistory(engine);
+    return engine->TimingHistory.Find(ImGuiTestEngine_GetTestHistoryID(test));
+}
+
+// Failed runs tend to stop early: only successful runs update Duration and FrameCount. Failed runs only update LastStatus (for ImGuiTestSchedulePolicy_FailedFirst).
+// frame_count < 0 when unknown (e.g. result merged from another process).
+void ImGuiTestEngine_RecordTestHistory(ImGuiTestEngine* engine, ImGuiTest* test, int frame_count)
+{
+    const ImGuiTestOutput& output = test->Output;
+    if (engine->IO.TimingHistoryFilename == nullptr)
+        return;
+    if (output.Status != ImGuiTestStatus_Success && output.Status != ImGuiTestStatus_Error)
+        return;
+    if (!engine->TimingHistory.Loaded)
+        ImGuiTestEngine_LoadTimingHistory(engine);
+
+    ImGuiTestTimingHistoryEntry* entry = engine->TimingHistory.GetOrAdd(ImGuiTestEngine_GetTestHistoryID(test));
+    if (output.Status == ImGuiTestStatus_Success)
+    {
+        const float duration = (output.EndTime > output.StartTime) ? (float)((double)(output.EndTime - output.StartTime) / 1000000.0) : 0.0f;
+        entry->Duration = (entry->Duration < 0.0f) ? duration : entry->Duration + (duration - entry->Duration) * 0.5f;
+        if (frame_count >= 0)
+            entry->FrameCount = frame_count;
+        if (entry->RunCount < 0xFFFF)
+            entry->RunCount++;
+    }
+    entry->LastStatus = (ImU8)output.Status;
+    engine->TimingHistory.Dirty = true;
+}
+
+// Reorder TestsQueue[queue_start..] according to IO.ConfigSchedulePolicy. Stable: ties keep their queued order.
+static void ImGuiTestEngine_ScheduleTests(ImGuiTestEngine* engine, int queue_start)
+{
+    const ImGuiTestSchedulePolicy policy = engine->IO.ConfigSchedulePolicy;
+    IM_ASSERT(policy >= ImGuiTestSchedulePolicy_None && policy < ImGuiTestSchedulePolicy_COUNT);
+    const int count = engine->TestsQueue.Size - queue_start;
+    if (policy == ImGuiTestSchedulePolicy_None || count < 2 || engine->IO.TimingHistoryFilename == nullptr)
+        return;
+
+    struct ScheduleEntry { int Group; float Key; int Index; ImGuiTestRunTask Task; };
+    ImVector<ScheduleEntry> entries;
+    entries.resize(count);
+    for (int n = 0; n < count; n++)
+    {
+        ScheduleEntry& e = entries[n];
+        e.Task = engine->TestsQueue[queue_start + n];
+        e.Index = n;
+        e.Key = 0.0f;
+        if (policy == ImGuiTestSchedulePolicy_FailedFirst)
+        {
+            ImGuiTestTimingHistoryEntry* history = ImGuiTestEngine_GetTestHistory(engine, e.Task.Test);
+            e.Group = (history && history->LastStatus == ImGuiTestStatus_Error) ? 0 : 1;
+        }
+        else
+        {
+            e.Group = (e.Task.PredictedDuration >= 0.0f) ? 0 : 1;
+            e.Key = (policy == ImGuiTestSchedulePolicy_LongestFirst) ? -e.Task.PredictedDuration : e.Task.PredictedDuration;
+        }
+    }
+    ImQsort(entries.Data, (size_t)entries.Size, sizeof(ScheduleEntry), [](const void* lhs, const void* rhs)
+    {
+        const ScheduleEntry* a = (const ScheduleEntry*)lhs;
+        const ScheduleEntry* b = (const ScheduleEntry*)rhs;
+        if (a->Group != b->Group)
+            return a->Group - b->Group;
+        if (a->Key != b->Key)
+            return (a->Key < b->Key) ? -1 : +1;
+        return a->Index - b->Index;
+    });
+    for (int n = 0; n < count; n++)
+        engine->TestsQueue[queue_start + n] = entries[n].Task;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] ImGuiTestLog
 //-------------------------------------------------------------------------
@@ -2580,9 +3479,303 @@ void ImGuiTestLog::Clear()
 {
     Buffer.clear();
     LineInfo.clear();
+    DeferredData.clear();
     memset(&CountPerLevel, 0, sizeof(CountPerLevel));
 }
 
+void ImGuiTestLog::AppendLineHeader(ImGuiTestVerboseLevel level, ImGuiTestLogFlags flags, int frame_count, int action_depth)
+{
+    //const char verbose_level_char = ImGuiTestEngine_GetVerboseLevelName(level)[0];
+    //if (flags & ImGuiTestLogFlags_NoHeader)
+    //    Buffer.appendf("[%c] ", verbose_level_char);
+    //else
+    //    Buffer.appendf("[%c] [%04d] ", verbose_level_char, frame_count);
+    if ((flags & ImGuiTestLogFlags_NoHeader) == 0)
+        Buffer.appendf("[%04d] ", frame_count);
+    if (level >= ImGuiTestVerboseLevel_Debug)
+        Buffer.appendf("-- %*s", ImMax(0, (action_depth - 1) * 2), "");
+}
+
+// Deferred records (see ImGuiTestEngineIO::ConfigLogDeferredFormatting)
+// - Layout: ImGuiTestLogDeferredHeader, format string (zero-terminated), then arguments.
+// - Arguments are stored in order of consumption, each as a ImGuiTestLogDeferredArgType byte followed by the value.
+// - Strings are copied (zero-terminated), as pointed data is generally not persistent.
+// - Format string is copied as well: it isn't always a literal.
+enum ImGuiTestLogDeferredArgType : ImU8
+{
+    ImGuiTestLogDeferredArgType_Int,
+    ImGuiTestLogDeferredArgType_Long,
+    ImGuiTestLogDeferredArgType_LongLong,
+    ImGuiTestLogDeferredArgType_SizeT,
+    ImGuiTestLogDeferredArgType_Double,
+    ImGuiTestLogDeferredArgType_LongDouble,
+    ImGuiTestLogDeferredArgType_Pointer,
+    ImGuiTestLogDeferredArgType_String,
+    ImGuiTestLogDeferredArgType_StringNull,
+};
+
+struct ImGuiTestLogDeferredHeader
+{
+    int                     RecordSize;         // Including header
+    int                     FrameCount;
+    ImS16                   ActionDepth;
+    ImU8                    Level;
+    ImU8                    Flags;
+};
+
+template<typename T>
+static void ImGuiTestLogDeferred_Write(ImVector<char>* data, ImGuiTestLogDeferredArgType type, T v)
+{
+    const int offset = data->Size;
+    data->resize(offset + 1 + (int)sizeof(T));
+    data->Data[offset] = (char)type;
+    memcpy(data->Data + offset + 1, &v, sizeof(T));
+}
+
+template<typename T>
+static T ImGuiTestLogDeferred_Read(const char** p)
+{
+    T v;
+    memcpy(&v, *p, sizeof(T));
+    *p += sizeof(T);
+    return v;
+}
+
+// Parsed printf() conversion specification
+struct ImGuiTestLogDeferredSpec
+{
+    ImGuiTestLogDeferredArgType ArgTypes[3];    // In order of consumption: up to two '*' fields, then the value
+    int                         ArgCount = 0;
+    int                         Precision = -1; // -1: none
+    bool                        PrecisionStar = false;
+};
+
+// Parse a printf() conversion specification (after the '%'). Return nullptr if unsupported.
+static const char* ImGuiTestLogDeferred_ParseSpec(const char* p, ImGuiTestLogDeferredSpec* spec)
+{
+    while (*p && strchr("-+ #0", *p))
+        p++;
+    if (*p == '*') { spec->ArgTypes[spec->ArgCount++] = ImGuiTestLogDeferredArgType_Int; p++; }
+    while (*p >= '0' && *p <= '9')
+        p++;
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*') { spec->ArgTypes[spec->ArgCount++] = ImGuiTestLogDeferredArgType_Int; spec->PrecisionStar = true; p++; }
+        else { spec->Precision = atoi(p); }
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+    ImGuiTestLogDeferredArgType int_type = ImGuiTestLogDeferredArgType_Int;
+    bool long_double = false;
+    if (p[0] == 'h')                        { p += (p[1] == 'h') ? 2 : 1; }
+    else if (p[0] == 'l' && p[1] == 'l')    { int_type = ImGuiTestLogDeferredArgType_LongLong; p += 2; }
+    else if (p[0] == 'l')                   { int_type = ImGuiTestLogDeferredArgType_Long; p++; }
+    else if (p[0] == 'z')                   { int_type = ImGuiTestLogDeferredArgType_SizeT; p++; }
+    else if (p[0] == 'L')                   { long_double = true; p++; }
+    switch (*p)
+    {
+    case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+        spec->ArgTypes[spec->ArgCount++] = int_type;
+        break;
+    case 'c':
+    case 's':
+        if (int_type != ImGuiTestLogDeferredArgType_Int) // No wide chars/strings
+            return nullptr;
+        spec->ArgTypes[spec->ArgCount++] = (*p == 's') ? ImGuiTestLogDeferredArgType_String : ImGuiTestLogDeferredArgType_Int;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        spec->ArgTypes[spec->ArgCount++] = long_double ? ImGuiTestLogDeferredArgType_LongDouble : ImGuiTestLogDeferredArgType_Double;
+        break;
+    case 'p':
+        spec->ArgTypes[spec->ArgCount++] = ImGuiTestLogDeferredArgType_Pointer;
+        break;
+    default: // %n, %j, %t etc. are not supported
+        return nullptr;
+    }
+    return p + 1;
+}
+
+bool ImGuiTestLog::AddDeferred(ImGuiTestVerboseLevel level, ImGuiTestLogFlags flags, int frame_count, int action_depth, const char* fmt, va_list args)
+{
+    const int record_offset = DeferredData.Size;
+    const int fmt_len = (int)strlen(fmt);
+    DeferredData.resize(record_offset + (int)sizeof(ImGuiTestLogDeferredHeader) + fmt_len + 1);
+    memcpy(DeferredData.Data + record_offset + sizeof(ImGuiTestLogDeferredHeader), fmt, (size_t)fmt_len + 1);
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    bool ok = true;
+    for (const char* p = fmt; *p; )
+    {
+        if (*p++ != '%')
+            continue;
+        if (*p == '%')
+        {
+            p++;
+            continue;
+        }
+        ImGuiTestLogDeferredSpec spec;
+        p = ImGuiTestLogDeferred_ParseSpec(p, &spec);
+        if (p == nullptr)
+        {
+            ok = false;
+            break;
+        }
+        for (int arg_n = 0; arg_n < spec.ArgCount; arg_n++)
+        {
+            const ImGuiTestLogDeferredArgType type = spec.ArgTypes[arg_n];
+            switch (type)
+            {
+            case ImGuiTestLogDeferredArgType_Int:
+            {
+                const int v = va_arg(args_copy, int);
+                if (spec.PrecisionStar && arg_n == spec.ArgCount - 2)
+                    spec.Precision = v;
+                ImGuiTestLogDeferred_Write(&DeferredData, type, v);
+                break;
+            }
+            case ImGuiTestLogDeferredArgType_Long:        ImGuiTestLogDeferred_Write(&DeferredData, type, va_arg(args_copy, long)); break;
+            case ImGuiTestLogDeferredArgType_LongLong:    ImGuiTestLogDeferred_Write(&DeferredData, type, va_arg(args_copy, long long)); break;
+            case ImGuiTestLogDeferredArgType_SizeT:       ImGuiTestLogDeferred_Write(&DeferredData, type, va_arg(args_copy, size_t)); break;
+            case ImGuiTestLogDeferredArgType_Double:      ImGuiTestLogDeferred_Write(&DeferredData, type, va_arg(args_copy, double)); break;
+            case ImGuiTestLogDeferredArgType_LongDouble:  ImGuiTestLogDeferred_Write(&DeferredData, type, va_arg(args_copy, long double)); break;
+            case ImGuiTestLogDeferredArgType_Pointer:     ImGuiTestLogDeferred_Write(&DeferredData, type, va_arg(args_copy, void*)); break;
+            case ImGuiTestLogDeferredArgType_String:
+            {
+                // Copy string, without reading past precision (e.g. "%.*s" with non zero-terminated string)
+                const char* str = va_arg(args_copy, const char*);
+                if (str == nullptr)
+                {
+                    DeferredData.push_back((char)ImGuiTestLogDeferredArgType_StringNull);
+                    break;
+                }
+                int str_len = 0;
+                while ((spec.Precision < 0 || str_len < spec.Precision) && str[str_len] != 0)
+                    str_len++;
+                const int offset = DeferredData.Size;
+                DeferredData.resize(offset + 1 + str_len + 1);
+                DeferredData.Data[offset] = (char)type;
+                memcpy(DeferredData.Data + offset + 1, str, (size_t)str_len);
+                DeferredData.Data[offset + 1 + str_len] = 0;
+                break;
+            }
+            default:
+                IM_ASSERT(0);
+                break;
+            }
+        }
+    }
+    va_end(args_copy);
+
+    if (!ok)
+    {
+        DeferredData.resize(record_offset);
+        return false;
+    }
+
+    ImGuiTestLogDeferredHeader header;
+    header.RecordSize = DeferredData.Size - record_offset;
+    header.FrameCount = frame_count;
+    header.ActionDepth = (ImS16)action_depth;
+    header.Level = (ImU8)level;
+    header.Flags = (ImU8)flags;
+    memcpy(DeferredData.Data + record_offset, &header, sizeof(header));
+    return true;
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wformat-nonliteral"  // Format strings are rebuilt from deferred records
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+
+void ImGuiTestLog::FlushDeferred()
+{
+    if (DeferredData.empty())
+        return;
+
+    for (const char* record = DeferredData.begin(); record < DeferredData.end(); )
+    {
+        ImGuiTestLogDeferredHeader header;
+        memcpy(&header, record, sizeof(header));
+        const char* fmt = record + sizeof(header);
+        const char* args = fmt + strlen(fmt) + 1;
+        const ImGuiTestVerboseLevel level = (ImGuiTestVerboseLevel)header.Level;
+
+        const int prev_size = Buffer.size();
+        AppendLineHeader(level, (ImGuiTestLogFlags)header.Flags, header.FrameCount, header.ActionDepth);
+        for (const char* p = fmt; *p; )
+        {
+            // Literal text
+            const char* literal_end = strchr(p, '%');
+            if (literal_end == nullptr)
+            {
+                Buffer.append(p);
+                break;
+            }
+            Buffer.append(p, literal_end);
+            p = literal_end + 1;
+            if (*p == '%')
+            {
+                Buffer.append("%");
+                p++;
+                continue;
+            }
+
+            // Conversion: rebuild specification with '*' fields replaced by their value, then format single value
+            ImGuiTestLogDeferredSpec spec_info;
+            const char* spec_begin = p - 1;
+            const char* spec_end = ImGuiTestLogDeferred_ParseSpec(p, &spec_info);
+            IM_ASSERT(spec_end != nullptr);
+            char spec[64];
+            int spec_len = 0;
+            for (const char* c = spec_begin; c < spec_end && spec_len < IM_ARRAYSIZE(spec) - 12; c++)
+            {
+                if (*c == '*')
+                {
+                    IM_ASSERT((ImGuiTestLogDeferredArgType)*args == ImGuiTestLogDeferredArgType_Int);
+                    args++;
+                    spec_len += ImFormatString(spec + spec_len, IM_ARRAYSIZE(spec) - spec_len, "%d", ImGuiTestLogDeferred_Read<int>(&args));
+                    continue;
+                }
+                spec[spec_len++] = *c;
+            }
+            spec[spec_len] = 0;
+
+            const ImGuiTestLogDeferredArgType type = (ImGuiTestLogDeferredArgType)*args++;
+            switch (type)
+            {
+            case ImGuiTestLogDeferredArgType_Int:         Buffer.appendf(spec, ImGuiTestLogDeferred_Read<int>(&args)); break;
+            case ImGuiTestLogDeferredArgType_Long:        Buffer.appendf(spec, ImGuiTestLogDeferred_Read<long>(&args)); break;
+            case ImGuiTestLogDeferredArgType_LongLong:    Buffer.appendf(spec, ImGuiTestLogDeferred_Read<long long>(&args)); break;
+            case ImGuiTestLogDeferredArgType_SizeT:       Buffer.appendf(spec, ImGuiTestLogDeferred_Read<size_t>(&args)); break;
+            case ImGuiTestLogDeferredArgType_Double:      Buffer.appendf(spec, ImGuiTestLogDeferred_Read<double>(&args)); break;
+            case ImGuiTestLogDeferredArgType_LongDouble:  Buffer.appendf(spec, ImGuiTestLogDeferred_Read<long double>(&args)); break;
+            case ImGuiTestLogDeferredArgType_Pointer:     Buffer.appendf(spec, ImGuiTestLogDeferred_Read<void*>(&args)); break;
+            case ImGuiTestLogDeferredArgType_String:      Buffer.appendf(spec, args); args += strlen(args) + 1; break;
+            case ImGuiTestLogDeferredArgType_StringNull:  Buffer.appendf(spec, "(null)"); break;
+            default:                                      IM_ASSERT(0); break;
+            }
+            p = spec_end;
+        }
+        Buffer.append("\n");
+        UpdateLineOffsets(nullptr, level, Buffer.begin() + prev_size);
+
+        record += header.RecordSize;
+    }
+    DeferredData.clear();
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
 // Output:
 // - If 'buffer != nullptr': all extracted lines are appended to 'buffer'. Use 'buffer->c_str()' on your side to obtain the text.
 // - Return value: number of lines extracted (should be equivalent to number of '\n' inside buffer->c_str()).
@@ -2594,6 +3787,7 @@ void ImGuiTestLog::Clear()
 int ImGuiTestLog::ExtractLinesForVerboseLevels(ImGuiTestVerboseLevel level_min, ImGuiTestVerboseLevel level_max, ImGuiTextBuffer* out_buffer)
 {
     IM_ASSERT(level_min <= level_max);
+    FlushDeferred();
 
     // Return count
     int count = 0;
@@ -2639,6 +3833,200 @@ void ImGuiTestLog::UpdateLineOffsets(ImGuiTestEngineIO* engine_io, ImGuiTestVerb
     }
 }
 
+//-------------------------------------------------------------------------
+// [SECTION] LOG OUTPUT THREAD
+//-------------------------------------------------------------------------
+// - ImGuiTestLogOutputQueue::Push()
+// - ImGuiTestLogOutputQueue::Pop()
+// - ImGuiTestEngine_WriteLogOutput() [Internal]
+// - ImGuiTestEngine_PushLogOutput()
+// - ImGuiTestEngine_FlushLogOutput()
+// - ImGuiTestEngine_StopLogOutputThread()
+//-------------------------------------------------------------------------
+
+struct ImGuiTestLogOutputThread
+{
+    std::thread                 Thread;
+    std::mutex                  Mutex;              // Only used to sleep on Cond
+    std::condition_variable     Cond;               // Notified on push and when thread should exit
+};
+
+void ImGuiTestLogOutputQueue::Push(ImGuiTestLogOutputMessage* msg)
+{
+    msg->Next.store(nullptr, std::memory_order_relaxed);
+    ImGuiTestLogOutputMessage* prev = Head.exchange(msg, std::memory_order_acq_rel);
+    prev->Next.store(msg, std::memory_order_release); // Until this is done, consumer can't reach msg and following messages
+}
+
+ImGuiTestLogOutputMessage* ImGuiTestLogOutputQueue::Pop()
+{
+    ImGuiTestLogOutputMessage* tail = Tail;
+    ImGuiTestLogOutputMessage* next = tail->Next.load(std::memory_order_acquire);
+    if (tail == &Stub)
+    {
+        if (next == nullptr)
+            return nullptr;
+        Tail = tail = next;
+        next = next->Next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr)
+    {
+        Tail = next;
+        return tail;
+    }
+    if (tail != Head.load(std::memory_order_acquire))
+        return nullptr;
+
+    // Last message: push stub back so we can hand out 'tail' without leaving queue without a node
+    Push(&Stub);
+    next = tail->Next.load(std::memory_order_acquire);
+    if (next == nullptr)
+        return nullptr;
+    Tail = next;
+    return tail;
+}
+
+static ImOsConsoleTextColor ImGuiTestEngine_GetLogOutputColor(ImGuiTestVerboseLevel level)
+{
+    switch (level)
+    {
+    case ImGuiTestVerboseLevel_Warning: return ImOsConsoleTextColor_BrightYellow;
+    case ImGuiTestVerboseLevel_Error:   return ImOsConsoleTextColor_BrightRed;
+    default:                            return ImOsConsoleTextColor_White;
+    }
+}
+
+// Write all pending messages. Return false if another thread is already doing it.
+// Consecutive TTY messages of same color are written with a single fwrite(), and stdout is flushed once.
+static bool ImGuiTestEngine_WriteLogOutput(ImGuiTestLogOutputQueue* queue)
+{
+    if (queue->ConsumerBusy.exchange(true, std::memory_order_acquire))
+        return false;
+
+    char* tty_buf = queue->TTYBuffer;
+    const int tty_buf_capacity = IM_ARRAYSIZE(queue->TTYBuffer);
+    int tty_buf_size = 0;
+    ImOsConsoleTextColor tty_color = ImOsConsoleTextColor_White;
+    bool tty_written = false;
+    while (ImGuiTestLogOutputMessage* msg = queue->Pop())
+    {
+        if (msg->Target == ImGuiTestLogOutputTarget_TTY)
+        {
+            const ImOsConsoleTextColor color = ImGuiTestEngine_GetLogOutputColor(msg->Level);
+            if (tty_buf_size > 0 && (color != tty_color || tty_buf_size + msg->TextLen > tty_buf_capacity))
+            {
+                fwrite(tty_buf, 1, (size_t)tty_buf_size, stdout);
+                tty_buf_size = 0;
+            }
+            if (color != tty_color)
+            {
+                ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, color);
+                tty_color = color;
+            }
+            if (msg->TextLen > tty_buf_capacity)
+            {
+                fwrite(msg->GetText(), 1, (size_t)msg->TextLen, stdout);
+            }
+            else
+            {
+                memcpy(tty_buf + tty_buf_size, msg->GetText(), (size_t)msg->TextLen);
+                tty_buf_size += msg->TextLen;
+            }
+            tty_written = true;
+        }
+        else if (msg->Target == ImGuiTestLogOutputTarget_Debugger)
+        {
+            ImOsOutputDebugString(msg->GetText());
+        }
+        msg->~ImGuiTestLogOutputMessage();
+        free(msg);
+    }
+    if (tty_buf_size > 0)
+        fwrite(tty_buf, 1, (size_t)tty_buf_size, stdout);
+    if (tty_color != ImOsConsoleTextColor_White)
+        ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
+    if (tty_written)
+        fflush(stdout);
+
+    queue->ConsumerBusy.store(false, std::memory_order_release);
+    return true;
+}
+
+static void ImGuiTestEngine_LogOutputThreadMain(ImGuiTestLogOutputQueue* queue, ImGuiTestLogOutputThread* thread)
+{
+    ImThreadSetCurrentThreadDescription("Dear ImGui Test Log Output");
+    while (!queue->ThreadShouldExit.load(std::memory_order_acquire))
+    {
+        ImGuiTestEngine_WriteLogOutput(queue);
+
+        // Wait with a timeout: producers notify without holding the mutex, so a notification may be missed.
+        std::unique_lock<std::mutex> lock(thread->Mutex);
+        thread->Cond.wait_for(lock, std::chrono::milliseconds(10), [queue]() { return !queue->IsEmpty() || queue->ThreadShouldExit.load(std::memory_order_acquire); });
+    }
+    ImGuiTestEngine_WriteLogOutput(queue);
+}
+
+// Copy message and queue it for the writer thread.
+// 'prefix' is concatenated in front of text (used for debugger output).
+void ImGuiTestEngine_PushLogOutput(ImGuiTestEngine* engine, ImGuiTestLogOutputTarget target, ImGuiTestVerboseLevel level, const char* prefix, const char* text, const char* text_end)
+{
+    ImGuiTestLogOutputQueue* queue = &engine->LogOutput;
+    if (queue->Thread == nullptr)
+    {
+        queue->ThreadShouldExit.store(false, std::memory_order_release);
+        queue->Thread = IM_NEW(ImGuiTestLogOutputThread)();
+        queue->Thread->Thread = std::thread(ImGuiTestEngine_LogOutputThreadMain, queue, queue->Thread);
+    }
+
+    const int prefix_len = prefix ? (int)strlen(prefix) : 0;
+    const int text_len = text_end ? (int)(text_end - text) : (int)strlen(text);
+    void* mem = malloc(sizeof(ImGuiTestLogOutputMessage) + (size_t)(prefix_len + text_len + 1));
+    ImGuiTestLogOutputMessage* msg = IM_PLACEMENT_NEW(mem) ImGuiTestLogOutputMessage();
+    msg->Target = target;
+    msg->Level = level;
+    msg->TextLen = prefix_len + text_len;
+    char* msg_text = (char*)(msg + 1);
+    if (prefix_len > 0)
+        memcpy(msg_text, prefix, (size_t)prefix_len);
+    memcpy(msg_text + prefix_len, text, (size_t)text_len);
+    msg_text[prefix_len + text_len] = 0;
+
+    queue->Push(msg);
+    queue->Thread->Cond.notify_one();
+}
+
+// Block until pending output has been written, for at most 'timeout_ms' (-1: no limit). May be called from any thread.
+static void ImGuiTestEngine_FlushLogOutputEx(ImGuiTestEngine* engine, int timeout_ms)
+{
+    ImGuiTestLogOutputQueue* queue = &engine->LogOutput;
+    const uint64_t time_end = (timeout_ms >= 0) ? ImTimeGetInMicroseconds() + (uint64_t)timeout_ms * 1000 : 0;
+    while (!queue->IsEmpty() || queue->ConsumerBusy.load(std::memory_order_acquire)) // Writer thread may still be writing messages it popped
+    {
+        if (!ImGuiTestEngine_WriteLogOutput(queue))
+            ImThreadSleepInMilliseconds(1); // Writer thread is busy
+        if (timeout_ms >= 0 && ImTimeGetInMicroseconds() >= time_end)
+            break;
+    }
+}
+
+void ImGuiTestEngine_FlushLogOutput(ImGuiTestEngine* engine)
+{
+    ImGuiTestEngine_FlushLogOutputEx(engine, -1);
+}
+
+void ImGuiTestEngine_StopLogOutputThread(ImGuiTestEngine* engine)
+{
+    ImGuiTestLogOutputQueue* queue = &engine->LogOutput;
+    if (queue->Thread == nullptr)
+        return;
+    queue->ThreadShouldExit.store(true, std::memory_order_release);
+    queue->Thread->Cond.notify_one();
+    queue->Thread->Thread.join();
+    IM_DELETE(queue->Thread);
+    queue->Thread = nullptr;
+    ImGuiTestEngine_FlushLogOutput(engine);
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] ImGuiTest
 //-------------------------------------------------------------------------
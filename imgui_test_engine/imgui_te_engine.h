@@ -57,6 +57,7 @@ typedef int ImGuiTestRunFlags;      // Flags: See ImGuiTestRunFlags_
 enum ImGuiTestActiveFunc : int;
 enum ImGuiTestGroup : int;
 enum ImGuiTestRunSpeed : int;
+enum ImGuiTestSchedulePolicy : int;
 enum ImGuiTestStatus : int;
 enum ImGuiTestVerboseLevel : int;
 enum ImGuiTestEngineExportFormat : int;
@@ -81,6 +82,17 @@ enum ImGuiTestRunSpeed : int
     ImGuiTestRunSpeed_COUNT
 };
 
+// Order of tests queued by ImGuiTestEngine_QueueTests(). Policies other than _None use the timing history (see ImGuiTestEngineIO::TimingHistoryFilename).
+// Tests without history keep their relative registration order and are placed after tests with history.
+enum ImGuiTestSchedulePolicy : int
+{
+    ImGuiTestSchedulePolicy_None            = 0,    // Registration order
+    ImGuiTestSchedulePolicy_LongestFirst    = 1,    // Longest predicted duration first (evens out shards/workers)
+    ImGuiTestSchedulePolicy_ShortestFirst   = 2,    // Shortest predicted duration first (fastest feedback)
+    ImGuiTestSchedulePolicy_FailedFirst     = 3,    // Tests which failed on their last run first, then registration order
+    ImGuiTestSchedulePolicy_COUNT
+};
+
 enum ImGuiTestVerboseLevel : int
 {
     ImGuiTestVerboseLevel_Silent    = 0,    // -v0
@@ -190,10 +202,13 @@ IMGUI_API ImGuiTextBuffer* ImGuiTestEngine_GetTempStringBuilder();
 //-------------------------------------------------------------------------
 
 // Functions: Initialization
+// - Each engine binds to one dear imgui context. Multiple engine+context pairs may run on separate threads, each with their own test queue.
+//   This requires a thread-local GImGui in your imconfig.h (e.g. 'extern thread_local ImGuiContext* MyImGuiTLS; #define GImGui MyImGuiTLS').
 IMGUI_API ImGuiTestEngine*    ImGuiTestEngine_CreateContext();                                      // Create test engine
 IMGUI_API void                ImGuiTestEngine_DestroyContext(ImGuiTestEngine* engine);              // Destroy test engine. Call after ImGui::DestroyContext() so test engine specific ini data gets saved.
 IMGUI_API void                ImGuiTestEngine_Start(ImGuiTestEngine* engine, ImGuiContext* ui_ctx); // Bind to a dear imgui context. Start coroutine.
 IMGUI_API void                ImGuiTestEngine_Stop(ImGuiTestEngine* engine);                        // Stop coroutine and export if any. (Unbind will lazily happen on context shutdown)
+IMGUI_API void                ImGuiTestEngine_FlushLogOutput(ImGuiTestEngine* engine);              // Wait until pending asynchronous TTY/debugger log output is written (see ConfigLogAsyncOutput). Call before writing to stdout yourself while tests are running.
 IMGUI_API void                ImGuiTestEngine_PostSwap(ImGuiTestEngine* engine);                    // Call every frame after framebuffer swap, will process screen capture and call test_io.ScreenCaptureFunc()
 IMGUI_API ImGuiTestEngineIO&  ImGuiTestEngine_GetIO(ImGuiTestEngine* engine);
 
@@ -209,6 +224,8 @@ IMGUI_API void                ImGuiTestEngine_QueueTests(ImGuiTestEngine* engine
 IMGUI_API bool                ImGuiTestEngine_TryAbortEngine(ImGuiTestEngine* engine);
 IMGUI_API void                ImGuiTestEngine_AbortCurrentTest(ImGuiTestEngine* engine);
 IMGUI_API ImGuiTest*          ImGuiTestEngine_FindTestByName(ImGuiTestEngine* engine, const char* category, const char* name);
+IMGUI_API void                ImGuiTestEngine_ClearTestQueue(ImGuiTestEngine* engine);              // Remove all queued tests (their status is reset to Unknown). Cannot be called while running tests.
+IMGUI_API void                ImGuiTestEngine_MergeTestOutput(ImGuiTestEngine* engine, ImGuiTest* test, const ImGuiTestOutput* output); // Import output of a test which ran elsewhere (e.g. worker process), so result summary and export include it.
 
 // Functions: Status Queries
 // FIXME: Clarify API to avoid function calls vs raw bools in ImGuiTestEngineIO
@@ -216,7 +233,8 @@ IMGUI_API bool                ImGuiTestEngine_IsTestQueueEmpty(ImGuiTestEngine*
 IMGUI_API bool                ImGuiTestEngine_IsUsingSimulatedInputs(ImGuiTestEngine* engine);
 IMGUI_API void                ImGuiTestEngine_GetResultSummary(ImGuiTestEngine* engine, ImGuiTestEngineResultSummary* out_results);
 IMGUI_API void                ImGuiTestEngine_GetTestList(ImGuiTestEngine* engine, ImVector<ImGuiTest*>* out_tests);
-IMGUI_API void                ImGuiTestEngine_GetTestQueue(ImGuiTestEngine* engine, ImVector<ImGuiTestRunTask>* out_tests);
+IMGUI_API void                ImGuiTestEngine_UpdateTestsSourceLines(ImGuiTestEngine* engine);    // Calculate ImGuiTest::SourceLineEnd of all tests (from SourceLine of next test in same file). Last test of a file keeps SourceLineEnd == SourceLine.
+IMGUI_API void                ImGuiTestEngine_GetTestQueue(ImGuiTestEngine* engine, ImVector<ImGuiTestRunTask>* out_tests, float* out_predicted_total_duration = nullptr); // Predicted total in seconds, from timing history. Tests without history are estimated using the average of known ones.
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 // Obsoleted 2025/03/17
@@ -260,14 +278,23 @@ struct IMGUI_API ImGuiTestEngineIO
     ImGuiTestVerboseLevel       ConfigVerboseLevelOnError = ImGuiTestVerboseLevel_Info;
     bool                        ConfigLogToTTY = false;
     bool                        ConfigLogToDebugger = false;
+    bool                        ConfigLogAsyncOutput = false;       // Write TTY/debugger log output from a background thread, so a slow console doesn't stall tests. Flushed by ImGuiTestEngine_Stop() and crash handler.
+    bool                        ConfigLogDeferredFormatting = false;// Store format string + packed arguments for messages which are not printed immediately, and only format them when the log is displayed, exported or printed on error. Reduces logging cost of passing tests.
     bool                        ConfigRestoreFocusAfterTests = true;// Restore focus back after running tests
     bool                        ConfigCaptureEnabled = true;        // Master enable flags for capturing and saving captures. Disable to avoid e.g. lengthy saving of large PNG files.
     bool                        ConfigCaptureOnError = false;
     bool                        ConfigNoThrottle = false;           // Disable vsync for performance measurement or fast test running
     bool                        ConfigMouseDrawCursor = true;       // Enable drawing of Dear ImGui software mouse cursor when running tests
     float                       ConfigFixedDeltaTime = 0.0f;        // Use fixed delta time instead of calculating it from wall clock
+    bool                        ConfigVirtualClock = false;         // When running tests in normal/cinematic mode: drive io.DeltaTime from a virtual clock advancing by ConfigVirtualClockDeltaTime every frame. Sleep() and mouse/typing speed follow it (watchdog stays on wall clock and only runs in Fast mode): runs don't wait on wall clock and timing is identical on all machines. Not used while measuring performances.
+    float                       ConfigVirtualClockDeltaTime = 1.0f / 60.0f;
+    bool                        ConfigSkipRender = false;           // When running tests in fast mode: let application skip rendering of frames which don't need rendered output (see IsRequestingSkipRender). Intended for headless runs.
+    bool                        ConfigUiContextSnapshot = false;    // [Experimental] Snapshot window/nav/popup/table state before each test and restore it in the following frame, instead of yielding 2 frames after each test. Docking state is not restored.
+    bool                        ConfigLabelIndex = false;           // Record labels of recently submitted items so repeated wildcard ("**/") queries may resolve without yielding. Keeps item hooks enabled while tests are running.
+    bool                        ConfigPerfCounters = false;         // Also measure thread CPU time and hardware counters (cycles, instructions, cache/branch misses; Linux only) around GuiFunc + ImGui::Render() during PerfCapture(). Recorded as extra perf log columns.
     int                         PerfStressAmount = 1;               // Integer to scale the amount of items submitted in test
     char                        GitBranchName[64] = "";             // e.g. fill in branch name (e.g. recorded in perf samples .csv)
+    bool                        ConfigPerfLogUpdateBinary = true;   // After PerfCapture() wrote to default .csv perf log, import new entries into default binary perf log. Disable in processes running concurrently (e.g. parallel jobs workers) and update from a single process.
 
     // Options: Speed of user simulation
     float                       MouseSpeed = 600.0f;                // Mouse speed (pixel/second) when not running in fast mode
@@ -294,6 +321,11 @@ struct IMGUI_API ImGuiTestEngineIO
     const char*                 ExportResultsFilename = nullptr;
     ImGuiTestEngineExportFormat ExportResultsFormat = (ImGuiTestEngineExportFormat)0;
 
+    // Options: Timing History
+    // Per-test durations, frame counts and last status, keyed by category/name. Loaded on first use, saved by ImGuiTestEngine_Stop().
+    const char*                 TimingHistoryFilename = nullptr;    // e.g. "imgui_test_history.bin". nullptr: disabled.
+    ImGuiTestSchedulePolicy     ConfigSchedulePolicy = ImGuiTestSchedulePolicy_None; // Order of tests queued by ImGuiTestEngine_QueueTests()
+
     // Options: Sanity Checks
     bool                        CheckDrawDataIntegrity = false;     // Check ImDrawData integrity (buffer count, etc.). Currently cheap but may become a slow operation.
 
@@ -304,6 +336,8 @@ struct IMGUI_API ImGuiTestEngineIO
     // Output: State of test engine
     bool                        IsRunningTests = false;
     bool                        IsRequestingMaxAppSpeed = false;    // When running in fast mode: request app to skip vsync or even skip rendering if it wants
+    bool                        IsUsingVirtualClock = false;        // When ConfigVirtualClock is set: io.DeltaTime of next frame will be ConfigVirtualClockDeltaTime. Backends may use it instead of measuring time (see ImGuiApp::FixedDeltaTime). Valid after ImGui::EndFrame().
+    bool                        IsRequestingSkipRender = false;     // When ConfigSkipRender is set: app may skip ImGui::Render() and its own rendering/swap for this frame. Valid after ImGui::EndFrame(). Keep calling ImGuiTestEngine_PostSwap().
     bool                        IsCapturing = false;                // Capture is in progress
 };
 
@@ -364,11 +398,13 @@ struct IMGUI_API ImGuiTestLog
     ImGuiTextBuffer                 Buffer;
     ImVector<ImGuiTestLogLineInfo>  LineInfo;
     int                             CountPerLevel[ImGuiTestVerboseLevel_COUNT] = {};
+    ImVector<char>                  DeferredData;           // Packed records not formatted yet (see ImGuiTestEngineIO::ConfigLogDeferredFormatting). Always more recent than Buffer contents.
 
     // Functions
     ImGuiTestLog() {}
-    bool    IsEmpty() const         { return Buffer.empty(); }
+    bool    IsEmpty() const         { return Buffer.empty() && DeferredData.empty(); }
     void    Clear();
+    void    FlushDeferred();        // Format pending records into Buffer/LineInfo/CountPerLevel. Call before accessing those directly.
 
     // Extract log contents filtered per log-level.
     // Output:
@@ -383,6 +419,8 @@ struct IMGUI_API ImGuiTestLog
 
     // [Internal]
     void    UpdateLineOffsets(ImGuiTestEngineIO* engine_io, ImGuiTestVerboseLevel level, const char* start);
+    void    AppendLineHeader(ImGuiTestVerboseLevel level, ImGuiTestLogFlags flags, int frame_count, int action_depth);
+    bool    AddDeferred(ImGuiTestVerboseLevel level, ImGuiTestLogFlags flags, int frame_count, int action_depth, const char* fmt, va_list args); // Return false if 'fmt' uses unsupported conversions (caller should format it immediately)
 };
 
 //-------------------------------------------------------------------------
@@ -404,6 +442,9 @@ struct IMGUI_API ImGuiTestOutput
     ImGuiTestLog                    Log;
     ImU64                           StartTime = 0;
     ImU64                           EndTime = 0;
+    int                             ArenaAllocCount = 0;            // Number of transient allocations served by the test arena
+    int                             ArenaChunkAllocCount = 0;       // Number of heap allocations made by the test arena (generally 0 once warmed up)
+    size_t                          ArenaPeakBytes = 0;             // High-water mark of transient bytes in use
 };
 
 // Storage for one test
@@ -464,6 +505,7 @@ struct IMGUI_API ImGuiTestRunTask
 {
     ImGuiTest*          Test = nullptr;
     ImGuiTestRunFlags   RunFlags = ImGuiTestRunFlags_None;
+    float               PredictedDuration = -1.0f;  // Seconds, from timing history. -1.0f if unknown.
 };
 
 //-------------------------------------------------------------------------
@@ -30,6 +30,8 @@ static void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char*
 
 void ImGuiTestEngine_PrintResultSummary(ImGuiTestEngine* engine)
 {
+    ImGuiTestEngine_FlushLogOutput(engine);
+
     ImGuiTestEngineResultSummary summary;
     ImGuiTestEngine_GetResultSummary(engine, &summary);
 
@@ -91,6 +93,7 @@ static void ImGuiTestEngine_ExportResultSummary(ImGuiTestEngine* engine, FILE* f
 
 static bool ImGuiTestEngine_HasAnyLogLines(ImGuiTestLog* test_log, ImGuiTestVerboseLevel level)
 {
+    test_log->FlushDeferred();
     for (auto& line_info : test_log->LineInfo)
         if (line_info.Level <= level)
             return true;
@@ -99,6 +102,7 @@ static bool ImGuiTestEngine_HasAnyLogLines(ImGuiTestLog* test_log, ImGuiTestVerb
 
 static void ImGuiTestEngine_PrintLogLines(FILE* fp, ImGuiTestLog* test_log, int indent, ImGuiTestVerboseLevel level)
 {
+    test_log->FlushDeferred();
     Str128 log_line;
     for (auto& line_info : test_log->LineInfo)
     {
@@ -205,6 +209,7 @@ void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_
 
             ImGuiTestOutput* test_output = &test->Output;
             ImGuiTestLog* test_log = &test_output->Log;
+            test_log->FlushDeferred();
 
             // Attributes for <testcase> tag.
             const char* testcase_name = test->Name;
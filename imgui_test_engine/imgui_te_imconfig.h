@@ -28,6 +28,13 @@
 #define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL 0
 #endif
 
+// [Optional, default 0] Automatically fill ImGuiTestEngineIO::CoroutineFuncs with an implementation using ucontext (Linux only)
+// Switching between stackful coroutines on the same thread is much faster than handing over between two threads.
+// Takes priority over IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL when both are enabled.
+#ifndef IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+#define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL 0
+#endif
+
 // [Optional, default 0] Disable calls that do not make sense on game consoles
 // (Disable: system(), popen(), sigaction(), colored TTY output)
 #ifndef IMGUI_TEST_ENGINE_IS_GAME_CONSOLE
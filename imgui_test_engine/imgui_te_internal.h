@@ -9,6 +9,7 @@
 #include "imgui_te_coroutine.h"
 #include "imgui_te_utils.h"         // ImMovingAverage
 #include "imgui_capture_tool.h"     // ImGuiCaptureTool  // FIXME
+#include <atomic>                   // std::atomic<> for ImGuiTestInputQueue, ImGuiTestLogOutputQueue
 
 //-------------------------------------------------------------------------
 // FORWARD DECLARATIONS
@@ -33,7 +34,26 @@ struct ImGuiTestInfoTask
     ImGuiTestItemInfo       Result;
 };
 
+// Index of active ImGuiTestInfoTask keyed by ID (queried from every ItemAdd/ItemInfo hook call).
+// Open addressing with linear probing and backward-shift deletion. ID 0 is never queried so it is used to mark empty slots.
+struct ImGuiTestInfoTaskMap
+{
+    struct Slot { ImGuiID ID; ImGuiTestInfoTask* Task; };
+    ImVector<Slot>          Slots;                          // Size is always 0 or a power of two
+    int                     Count = 0;
+
+    ImGuiTestInfoTask*      Find(ImGuiID id) const;
+    void                    Add(ImGuiTestInfoTask* task);
+    void                    Remove(ImGuiID id);
+    void                    Clear() { Slots.clear(); Count = 0; }
+};
+
+// Maximum number of Gather/FindByLabel tasks which may be active at the same time.
+// All active tasks are processed during the same ItemAdd()/ItemInfo() hook calls.
+#define IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS  8       // Must be <= 32
+
 // Gather item list in given parent ID.
+// Active when InParentID != 0.
 struct ImGuiTestGatherTask
 {
     // Input
@@ -50,6 +70,7 @@ struct ImGuiTestGatherTask
 
 // Find item ID given a label and a parent id
 // Usually used by queries with wildcards such as ItemInfo("hello/**/foo/bar")
+// Active when InSuffix != nullptr.
 struct ImGuiTestFindByLabelTask
 {
     // Input
@@ -59,16 +80,47 @@ struct ImGuiTestFindByLabelTask
     const char*             InSuffixLastItem = nullptr;     // A last label string (for "hello/**/foo/bar" it would be "bar")
     ImGuiID                 InSuffixLastItemHash = 0;
     ImGuiItemStatusFlags    InFilterItemStatusFlags = 0;    // Flags required for item to be returned
+    bool                    InNoClip = false;               // Request engine to disable item clipping while task is active, so clipped items submit their label too
 
     // Output
     ImGuiID                 OutItemId = 0;                  // Result item ID
 };
 
+// Record of a recently submitted item label (see ImGuiTestLabelIndex)
+#define IMGUI_TEST_ENGINE_LABEL_INDEX_STACK_DEPTH   8
+#define IMGUI_TEST_ENGINE_LABEL_INDEX_WINDOW_DEPTH  4
+struct ImGuiTestLabelIndexEntry
+{
+    int                     Seq;                    // Insertion sequence number, 0 for unused entry
+    int                     PrevSeqInBucket;        // Previous entry with same bucket, entries are chained from newest to oldest
+    int                     FrameCount;             // Last time item was submitted
+    ImGuiID                 ID;                     // 0 when invalidated
+    ImGuiID                 LabelHash;
+    ImGuiItemStatusFlags    StatusFlags;
+    ImGuiID                 IDStack[IMGUI_TEST_ENGINE_LABEL_INDEX_STACK_DEPTH];     // Top of ID stack of current window, [0] being the innermost
+    ImGuiID                 WindowIDs[IMGUI_TEST_ENGINE_LABEL_INDEX_WINDOW_DEPTH];  // Current window then its parents
+    ImS8                    IDStackSize;
+    ImS8                    WindowIDsCount;
+    bool                    IsComplete;             // Whole ID stack is stored and window has no parent: prefix matching can be trusted when failing
+};
+
+// Optional index of recently submitted item labels, filled from ImGuiTestEngineHook_ItemInfo() when IO.ConfigLabelIndex is set.
+// Bounded ring buffer + hash buckets keyed by label hash. Cleared when a test starts, entries invalidated per window when a window is closed.
+struct ImGuiTestLabelIndex
+{
+    ImVector<ImGuiTestLabelIndexEntry>  Entries;    // Ring buffer, size is a power of two
+    ImVector<int>                       Buckets;    // Seq of newest entry for each bucket, size is a power of two
+    int                                 NextSeq = 1;
+
+    void    Clear() { Entries.clear(); Buckets.clear(); NextSeq = 1; }
+};
+
 enum ImGuiTestInputType
 {
     ImGuiTestInputType_None,
     ImGuiTestInputType_Key,
     ImGuiTestInputType_Char,
+    ImGuiTestInputType_Text,
     ImGuiTestInputType_ViewportFocus,
     ImGuiTestInputType_ViewportSetPos,
     ImGuiTestInputType_ViewportSetSize,
@@ -80,10 +132,12 @@ struct ImGuiTestInput
 {
     ImGuiTestInputType      Type = ImGuiTestInputType_None;
     ImGuiKeyChord           KeyChord = ImGuiKey_None;
-    ImWchar                 Char = 0;
+    unsigned int            Char = 0;               // Codepoint, up to IM_UNICODE_CODEPOINT_MAX
+    const char*             Text = nullptr;         // UTF-8 text for ImGuiTestInputType_Text. Storage is owned by ctx->Arena.
     bool                    Down = false;
     ImGuiID                 ViewportId = 0;
     ImVec2                  ViewportPosSize;
+    double                  Time = 0.0;             // Timestamp (in UI context clock, see g.Time) at which input is due. 0.0: apply on next frame. May fall in-between frames, in which case it is applied on the frame reaching it.
 
     static ImGuiTestInput   ForKeyChord(ImGuiKeyChord key_chord, bool down)
     {
@@ -94,7 +148,7 @@ struct ImGuiTestInput
         return inp;
     }
 
-    static ImGuiTestInput   ForChar(ImWchar v)
+    static ImGuiTestInput   ForChar(unsigned int v)
     {
         ImGuiTestInput inp;
         inp.Type = ImGuiTestInputType_Char;
@@ -102,6 +156,14 @@ struct ImGuiTestInput
         return inp;
     }
 
+    static ImGuiTestInput   ForText(const char* text)
+    {
+        ImGuiTestInput inp;
+        inp.Type = ImGuiTestInputType_Text;
+        inp.Text = text;
+        return inp;
+    }
+
     static ImGuiTestInput   ForViewportFocus(ImGuiID viewport_id)
     {
         ImGuiTestInput inp;
@@ -137,17 +199,158 @@ struct ImGuiTestInput
     }
 };
 
+// Maximum number of pending inputs. Pushing into a full queue yields until some inputs are applied.
+#define IMGUI_TEST_ENGINE_INPUT_QUEUE_SIZE      1024    // Must be a power of two
+
+// Fixed-capacity single-producer/single-consumer ring buffer of inputs.
+// Pushed from the test coroutine, drained in order by ImGuiTestEngine_ApplyInputToImGuiContext() on the main thread.
+// Indices are free-running and wrap naturally, (Tail - Head) is the number of pending inputs.
+struct ImGuiTestInputQueue
+{
+    ImGuiTestInput              Data[IMGUI_TEST_ENGINE_INPUT_QUEUE_SIZE];
+    std::atomic<unsigned int>   Head { 0 };                     // Next input to read (only written by consumer)
+    std::atomic<unsigned int>   Tail { 0 };                     // Next slot to write (only written by producer)
+
+    int                     GetSize() const     { return (int)(Tail.load(std::memory_order_acquire) - Head.load(std::memory_order_acquire)); }
+    bool                    IsEmpty() const     { return GetSize() == 0; }
+    bool                    IsFull() const      { return GetSize() == IMGUI_TEST_ENGINE_INPUT_QUEUE_SIZE; }
+    bool                    Push(const ImGuiTestInput& input)   // Producer. Return false if full.
+    {
+        const unsigned int tail = Tail.load(std::memory_order_relaxed);
+        if (tail - Head.load(std::memory_order_acquire) == IMGUI_TEST_ENGINE_INPUT_QUEUE_SIZE)
+            return false;
+        Data[tail & (IMGUI_TEST_ENGINE_INPUT_QUEUE_SIZE - 1)] = input;
+        Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    const ImGuiTestInput*   Front() const                       // Consumer. Return nullptr if empty.
+    {
+        const unsigned int head = Head.load(std::memory_order_relaxed);
+        if (head == Tail.load(std::memory_order_acquire))
+            return nullptr;
+        return &Data[head & (IMGUI_TEST_ENGINE_INPUT_QUEUE_SIZE - 1)];
+    }
+    void                    PopFront()                          { IM_ASSERT(!IsEmpty()); Head.store(Head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+    void                    Clear()                             { Head.store(Tail.load(std::memory_order_acquire), std::memory_order_release); } // Consumer side, or while consumer is not running.
+};
+
 struct ImGuiTestInputs
 {
     ImVec2                      MousePosValue;                  // Own non-rounded copy of MousePos in order facilitate simulating mouse movement very slow speed and high-framerate
     ImVec2                      MouseWheel;
     ImGuiID                     MouseHoveredViewport = 0;
     int                         MouseButtonsValue = 0x00;       // FIXME-TESTS: Use simulated_io.MouseDown[] ?
-    ImVector<ImGuiTestInput>    Queue;
+    ImGuiTestInputQueue         Queue;                          // Pending key/char/viewport inputs, see ImGuiTestEngine_PushInput()
     bool                        HostEscDown = false;
     float                       HostEscDownDuration = -1.0f;    // Maintain our own DownDuration for host/backend ESC key so we can abort.
 };
 
+enum ImGuiTestLogOutputTarget
+{
+    ImGuiTestLogOutputTarget_TTY,
+    ImGuiTestLogOutputTarget_Debugger,
+};
+
+// A message waiting to be written by the log output thread. Zero-terminated text is stored right after the structure.
+struct ImGuiTestLogOutputMessage
+{
+    std::atomic<ImGuiTestLogOutputMessage*> Next { nullptr };
+    ImGuiTestLogOutputTarget    Target = ImGuiTestLogOutputTarget_TTY;
+    ImGuiTestVerboseLevel       Level = ImGuiTestVerboseLevel_Silent;
+    int                         TextLen = 0;
+
+    const char*                 GetText() const     { return (const char*)(this + 1); }
+};
+
+struct ImGuiTestLogOutputThread;
+
+// Asynchronous TTY/debugger log output (see ImGuiTestEngineIO::ConfigLogAsyncOutput)
+// - Multiple-producer/single-consumer intrusive queue: pushing is a single atomic exchange and never blocks.
+// - Messages are written by a lazily created background thread, coalescing them into few fwrite()/fflush() calls.
+// - Consumer side is guarded by ConsumerBusy so ImGuiTestEngine_FlushLogOutput() may also drain from another thread (e.g. crash handler).
+// - Messages are allocated with malloc() and not IM_ALLOC(): they are freed on the writer thread.
+struct ImGuiTestLogOutputQueue
+{
+    std::atomic<ImGuiTestLogOutputMessage*> Head { &Stub };     // Most recently pushed message. == &Stub when empty. (producers)
+    ImGuiTestLogOutputMessage*  Tail = &Stub;                   // Oldest message (consumer)
+    ImGuiTestLogOutputMessage   Stub;
+    std::atomic<bool>           ConsumerBusy { false };
+    std::atomic<bool>           ThreadShouldExit { false };
+    ImGuiTestLogOutputThread*   Thread = nullptr;               // Opaque, see imgui_te_engine.cpp
+    char                        TTYBuffer[4096];                // Used by consumer to coalesce writes
+
+    bool                        IsEmpty() const     { return Head.load(std::memory_order_acquire) == &Stub; }
+    void                        Push(ImGuiTestLogOutputMessage* msg);
+    ImGuiTestLogOutputMessage*  Pop();                          // Consumer. Return nullptr if empty or if a producer is in the middle of pushing.
+};
+
+// CPU time and hardware counters of one measured frame (see ImGuiTestEngineIO::ConfigPerfCounters)
+struct ImGuiTestPerfCounterSample
+{
+    ImU64                       CpuTimeNs = 0;                  // Thread CPU time
+    ImU64                       Values[ImPerfCounter_COUNT] = {}; // Hardware counters (zero when not available)
+};
+
+// Scoped measurements around GuiFunc and ImGui::Render() on the main thread, while PerfCalcRef()/PerfCapture() are measuring.
+// Unlike io.DeltaTime, this excludes coroutine switches, ImGui::NewFrame()/EndFrame(), backend/swap and time the thread is not scheduled.
+struct ImGuiTestPerfCounters
+{
+    ImPerfCounterGroup          Group;                          // Opened lazily by the main thread (counters are per-thread)
+    bool                        GroupOpenFailed = false;        // Don't retry opening after a failure
+    bool                        HasCpuTime = false;             // ImThreadGetCpuTimeInNanoseconds() is supported
+    bool                        ScopeActive = false;
+    ImGuiTestPerfCounterSample  ScopeStart;
+    ImGuiTestPerfCounterSample  Frame;                          // Accumulated since last reset by PerfCalcRef()/PerfCapture()
+    ImVector<ImGuiTestPerfCounterSample> RefSamples;            // Every frame measured by PerfCalcRef()
+    ImVector<ImGuiTestPerfCounterSample> Samples;               // Every frame measured by last PerfCapture()
+};
+
+// Timing history of one test (see ImGuiTestEngineIO::TimingHistoryFilename). Stored as-is in the history file.
+struct ImGuiTestTimingHistoryEntry
+{
+    ImGuiID                     TestID;                     // Hash of category + name, see ImGuiTestEngine_GetTestHistoryID()
+    float                       Duration;                   // Moving average of successful run durations (seconds)
+    int                         FrameCount;                 // Number of frames used by last successful run
+    ImU16                       RunCount;                   // Number of successful runs. Saturates at 0xFFFF
+    ImU8                        LastStatus;                 // ImGuiTestStatus of last run
+    ImU8                        Reserved;
+};
+
+// Entries are sorted by TestID.
+struct ImGuiTestTimingHistory
+{
+    ImVector<ImGuiTestTimingHistoryEntry> Entries;
+    bool                        Loaded = false;             // Lazily loaded on first use
+    bool                        Dirty = false;              // Needs saving
+
+    ImGuiTestTimingHistoryEntry* Find(ImGuiID id);
+    ImGuiTestTimingHistoryEntry* GetOrAdd(ImGuiID id);
+};
+
+// State of a window when taking a ImGuiTestUiContextSnapshot
+struct ImGuiTestUiWindowSnapshot
+{
+    ImGuiID                     WindowID;
+    ImVec2                      Pos;
+    ImVec2                      SizeFull;
+    bool                        Collapsed;
+    bool                        WasActive;                  // Submitted by application (or a parent test) at the time of the snapshot: left alone on restore
+};
+
+// Snapshot of dear imgui context state commonly disturbed by a test (see ImGuiTestEngineIO::ConfigUiContextSnapshot)
+// - Capture is O(windows), restore only processes windows/tables which were submitted during the test.
+// - Restore is done between frames (see ImGuiTestEngine::UiContextSnapshotToRestore). Windows are referred to by ID, so a snapshot stays valid if a window is destroyed.
+// - Windows are never destroyed: windows submitted by the test get their position/size restored and will be 'Appearing' again on next use.
+// - Tables submitted by the test are discarded along with their settings.
+struct ImGuiTestUiContextSnapshot
+{
+    int                         FrameCount = -1;
+    ImGuiID                     NavWindowID = 0;
+    int                         OpenPopupCount = 0;
+    ImVector<ImGuiTestUiWindowSnapshot> Windows;            // Sorted by WindowID
+    ImVector<ImGuiID>           ActiveTables;               // Tables submitted by application at the time of the snapshot
+};
+
 // [Internal] Test Engine Context
 struct ImGuiTestEngine
 {
@@ -164,11 +367,26 @@ struct ImGuiTestEngine
     ImVector<ImGuiTestRunTask>  TestsQueue;
     ImGuiTestContext*           TestContext = nullptr;          // Running test context
     bool                        TestsSourceLinesDirty = false;
-    ImVector<ImGuiTestInfoTask*>InfoTasks;
-    ImGuiTestGatherTask         GatherTask;
-    ImGuiTestFindByLabelTask    FindByLabelTask;
+    ImVector<ImGuiTestInfoTask*>InfoTasks;                      // Active tasks
+    ImGuiTestInfoTaskMap        InfoTasksMap;                   // Active tasks indexed by ID
+    ImVector<ImGuiTestInfoTask*>InfoTasksPool;                  // Recycled tasks, reused to avoid an allocation per query
+    ImGuiTestGatherTask         GatherTasks[IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS];
+    ImGuiTestFindByLabelTask    FindByLabelTasks[IMGUI_TEST_ENGINE_MAX_CONCURRENT_TASKS];
+    ImU32                       GatherTasksUsedMask = 0;        // 1 bit per GatherTasks[] entry in use
+    ImU32                       FindByLabelTasksUsedMask = 0;   // 1 bit per FindByLabelTasks[] entry in use
+    ImGuiItemStatusFlags        FindByLabelFilterItemStatusFlags = 0; // Set by ItemAction() on wildcard refs, copied into new FindByLabel tasks
+    ImGuiTestLabelIndex         LabelIndex;                     // Recently submitted labels (when IO.ConfigLabelIndex is set)
+    bool                        NoClipActive = false;           // Clipping disabled for the current frame (via logging), see ImGuiTestEngine_PostNewFrame()
+    ImGuiTextBuffer             TempStringBuilder;              // Used by IM_CHECK_OP() macros, see ImGuiTestEngine_GetTempStringBuilder()
+    ImGuiTestTimingHistory      TimingHistory;                  // Per-test durations from previous runs (when IO.TimingHistoryFilename is set)
+    ImGuiTestUiContextSnapshot  UiContextSnapshot;              // Taken before running each top-level test (when IO.ConfigUiContextSnapshot is set)
+    ImGuiTestUiContextSnapshot* UiContextSnapshotToRestore = nullptr; // Restored between frames by next ImGuiTestEngine_PreNewFrame()
+    ImGuiTestArena              TestArena;                      // Transient per-test allocations (UserVars, scratch buffers). Reset at the end of each top-level test, regular chunks are kept.
+    ImGuiTestLogOutputQueue     LogOutput;                      // Pending TTY/debugger output (when IO.ConfigLogAsyncOutput is set)
+    ImGuiTestPerfCounters       PerfCounters;                   // CPU time and hardware counters measured during perf captures (when IO.ConfigPerfCounters is set)
     ImGuiTestCoroutineHandle    TestQueueCoroutine = nullptr;   // Coroutine to run the test queue
     bool                        TestQueueCoroutineShouldExit = false; // Flag to indicate that we are shutting down and the test queue coroutine should stop
+    ImGuiContext*               TestQueueCoroutineUiContext = nullptr; // Dear ImGui context current on coroutine side: saved when yielding, restored when resuming
 
     // Inputs
     ImGuiTestInputs             Inputs;
@@ -216,7 +434,17 @@ struct ImGuiTestEngine
 //-------------------------------------------------------------------------
 
 ImGuiTestItemInfo*  ImGuiTestEngine_FindItemInfo(ImGuiTestEngine* engine, ImGuiID id, const char* debug_id);
+ImGuiTestGatherTask*        ImGuiTestEngine_AddGatherTask(ImGuiTestEngine* engine);             // Return nullptr if all tasks are in use
+void                        ImGuiTestEngine_RemoveGatherTask(ImGuiTestEngine* engine, ImGuiTestGatherTask* task);
+ImGuiTestFindByLabelTask*   ImGuiTestEngine_AddFindByLabelTask(ImGuiTestEngine* engine);        // Return nullptr if all tasks are in use
+void                        ImGuiTestEngine_RemoveFindByLabelTask(ImGuiTestEngine* engine, ImGuiTestFindByLabelTask* task);
+ImGuiTestTimingHistoryEntry* ImGuiTestEngine_GetTestHistory(ImGuiTestEngine* engine, ImGuiTest* test); // Return nullptr if test never ran or history is disabled
+void                        ImGuiTestEngine_RecordTestHistory(ImGuiTestEngine* engine, ImGuiTest* test, int frame_count);
+ImGuiID                     ImGuiTestEngine_LabelIndexFind(ImGuiTestEngine* engine, const ImGuiTestFindByLabelTask* task); // Return 0 if not found or ambiguous
 void                ImGuiTestEngine_Yield(ImGuiTestEngine* engine);
+void                ImGuiTestEngine_PushInput(ImGuiTestEngine* engine, const ImGuiTestInput& input);   // Yield while input queue is full
+void                ImGuiTestEngine_PushLogOutput(ImGuiTestEngine* engine, ImGuiTestLogOutputTarget target, ImGuiTestVerboseLevel level, const char* prefix, const char* text, const char* text_end = nullptr); // Never blocks, see ImGuiTestLogOutputQueue
+void                ImGuiTestEngine_StopLogOutputThread(ImGuiTestEngine* engine);                      // Write pending output and join thread
 void                ImGuiTestEngine_SetDeltaTime(ImGuiTestEngine* engine, float delta_time);
 int                 ImGuiTestEngine_GetFrameCount(ImGuiTestEngine* engine);
 bool                ImGuiTestEngine_PassFilter(ImGuiTest* test, const char* filter);
@@ -226,8 +454,9 @@ void                ImGuiTestEngine_BindImGuiContext(ImGuiTestEngine* engine, Im
 void                ImGuiTestEngine_UnbindImGuiContext(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 
 void                ImGuiTestEngine_RebootUiContext(ImGuiTestEngine* engine);
+void                ImGuiTestEngine_UiContextSnapshotCapture(ImGuiContext* ui_ctx, ImGuiTestUiContextSnapshot* snapshot);
+void                ImGuiTestEngine_UiContextSnapshotRestore(ImGuiContext* ui_ctx, ImGuiTestUiContextSnapshot* snapshot);
 ImGuiPerfTool*      ImGuiTestEngine_GetPerfTool(ImGuiTestEngine* engine);
-void                ImGuiTestEngine_UpdateTestsSourceLines(ImGuiTestEngine* engine);
 
 // Screen/Video Capturing
 bool                ImGuiTestEngine_CaptureScreenshot(ImGuiTestEngine* engine, ImGuiCaptureArgs* args);
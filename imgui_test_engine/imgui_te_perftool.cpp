@@ -64,6 +64,19 @@ void ImGuiPerfToolEntry::Set(const ImGuiPerfToolEntry& other)
     DtDeltaMsMin = other.DtDeltaMsMin;
     DtDeltaMsMax = other.DtDeltaMsMax;
     NumSamples = other.NumSamples;
+    DtDeltaMsMedian = other.DtDeltaMsMedian;
+    DtDeltaMsP90 = other.DtDeltaMsP90;
+    DtDeltaMsP99 = other.DtDeltaMsP99;
+    DtDeltaMsCI95 = other.DtDeltaMsCI95;
+    NumFrames = other.NumFrames;
+    NumOutliers = other.NumOutliers;
+    CpuDeltaMs = other.CpuDeltaMs;
+    CyclesDelta = other.CyclesDelta;
+    InstructionsDelta = other.InstructionsDelta;
+    CacheMissesDelta = other.CacheMissesDelta;
+    BranchMissesDelta = other.BranchMissesDelta;
+    NumCpuFrames = other.NumCpuFrames;
+    NumCounterFrames = other.NumCounterFrames;
     PerfStressAmount = other.PerfStressAmount;
     GitBranchName = other.GitBranchName;
     BuildType = other.BuildType;
@@ -110,11 +123,30 @@ static const ImGuiPerfToolColumnInfo PerfToolColumnInfo[] =
     { /* 09 */ "Min ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsMin),     ImGuiDataType_Double, false, 0 },
     { /* 00 */ "Max ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsMax),     ImGuiDataType_Double, false, 0 },
     { /* 11 */ "Samples",     offsetof(ImGuiPerfToolEntry, NumSamples),       ImGuiDataType_S32,    false, 0 },
-    { /* 12 */ "VS Baseline", offsetof(ImGuiPerfToolEntry, VsBaseline),       ImGuiDataType_Float,  true,  0 },
+    { /* 12 */ "Median ms",   offsetof(ImGuiPerfToolEntry, DtDeltaMsMedian),  ImGuiDataType_Double, true,  0 },
+    { /* 13 */ "P90 ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsP90),     ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 14 */ "P99 ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsP99),     ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 15 */ "CI95 ms",     offsetof(ImGuiPerfToolEntry, DtDeltaMsCI95),    ImGuiDataType_Double, true,  0 },
+    { /* 16 */ "Outliers",    offsetof(ImGuiPerfToolEntry, NumOutliers),      ImGuiDataType_S32,    true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 17 */ "CPU ms",      offsetof(ImGuiPerfToolEntry, CpuDeltaMs),       ImGuiDataType_Double, true,  0 },
+    { /* 18 */ "Cycles",      offsetof(ImGuiPerfToolEntry, CyclesDelta),      ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 19 */ "Instructions",offsetof(ImGuiPerfToolEntry, InstructionsDelta),ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 20 */ "Cache Misses",offsetof(ImGuiPerfToolEntry, CacheMissesDelta), ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 21 */ "Branch Misses",offsetof(ImGuiPerfToolEntry, BranchMissesDelta),ImGuiDataType_Double, true, ImGuiTableColumnFlags_DefaultHide },
+    { /* 22 */ "VS Baseline", offsetof(ImGuiPerfToolEntry, VsBaseline),       ImGuiDataType_Float,  true,  0 },
 };
 
 static const char* PerfToolReportDefaultOutputPath = "./output/capture_perf_report.html";
 
+static void PerfToolWriteCSVLine(FILE* f, const ImGuiPerfToolEntry* entry)
+{
+    fprintf(f, "%llu,%s,%s,%.3f,x%d,%s,%s,%s,%s,%s,%s,%.3f,%.3f,%.3f,%.3f,%d,%d,%.4f,%.0f,%.0f,%.0f,%.0f,%d,%d\n", entry->Timestamp, entry->Category, entry->TestName,
+            entry->DtDeltaMs, entry->PerfStressAmount, entry->GitBranchName, entry->BuildType, entry->Cpu, entry->OS,
+            entry->Compiler, entry->Date, entry->DtDeltaMsMedian, entry->DtDeltaMsP90, entry->DtDeltaMsP99, entry->DtDeltaMsCI95,
+            entry->NumFrames, entry->NumOutliers, entry->CpuDeltaMs, entry->CyclesDelta, entry->InstructionsDelta,
+            entry->CacheMissesDelta, entry->BranchMissesDelta, entry->NumCpuFrames, entry->NumCounterFrames);
+}
+
 // This is declared as a standalone function in order to run without a PerfTool instance
 void ImGuiTestEngine_PerfToolAppendToCSV(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename)
 {
@@ -134,9 +166,7 @@ void ImGuiTestEngine_PerfToolAppendToCSV(ImGuiPerfTool* perf_log, ImGuiPerfToolE
         fprintf(stderr, "Unable to open '%s', perftool entry was not saved.\n", filename);
         return;
     }
-    fprintf(f, "%llu,%s,%s,%.3f,x%d,%s,%s,%s,%s,%s,%s\n", entry->Timestamp, entry->Category, entry->TestName,
-            entry->DtDeltaMs, entry->PerfStressAmount, entry->GitBranchName, entry->BuildType, entry->Cpu, entry->OS,
-            entry->Compiler, entry->Date);
+    PerfToolWriteCSVLine(f, entry);
     fflush(f);
     fclose(f);
 
@@ -256,7 +286,9 @@ static int IMGUI_CDECL PerfToolComparerByEntryInfo(const void* lhs, const void*
     return result;
 }
 
-static ImGuiPerfTool* PerfToolInstance = nullptr;
+static const char* PerfToolMeanLabels[] = { "harmonic mean", "arithmetic mean", "geometric mean" };
+
+static thread_local ImGuiPerfTool* PerfToolInstance = nullptr; // For qsort() comparator. Thread-local as multiple engines may run on separate threads.
 static int IMGUI_CDECL CompareWithSortSpecs(const void* lhs, const void* rhs)
 {
     IM_ASSERT(PerfToolInstance != nullptr);
@@ -533,6 +565,7 @@ static ImRect ImPlotGetYTickRect(int t, int y = 0)
 ImGuiPerfTool::ImGuiPerfTool()
 {
     _CsvParser = IM_NEW(ImGuiCsvParser)();
+    _BinaryFile = IM_NEW(ImFileMapping)();
     Clear();
 }
 
@@ -540,7 +573,9 @@ ImGuiPerfTool::~ImGuiPerfTool()
 {
     _SrcData.clear_destruct();
     _Batches.clear_destruct();
+    _BatchesCache.clear_destruct();
     IM_DELETE(_CsvParser);
+    IM_DELETE(_BinaryFile);
 }
 
 void ImGuiPerfTool::AddEntry(ImGuiPerfToolEntry* entry)
@@ -550,57 +585,68 @@ void ImGuiPerfTool::AddEntry(ImGuiPerfToolEntry* entry)
     if (strcmp(_FilterDateTo, entry->Date) < 0)
         ImStrncpy(_FilterDateTo, entry->Date, IM_ARRAYSIZE(_FilterDateTo));
 
-    _SrcData.push_back(*entry);
+    // Insert at sorted position so _Rebuild() does not have to sort the whole history again.
+    if (_SrcDataSorted)
+    {
+        int lo = 0;
+        int hi = _SrcData.Size;
+        while (lo < hi)
+        {
+            const int mid = lo + (hi - lo) / 2;
+            if (PerfToolComparerByEntryInfo(entry, &_SrcData.Data[mid]) < 0)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        _SrcData.insert(_SrcData.Data + lo, *entry);
+    }
+    else
+    {
+        _SrcData.push_back(*entry);
+    }
+
+    if (_LabelsIndex.GetInt(ImHashStr(entry->TestName), -1) < 0)
+        _LabelsDirty = true;
+    _BatchesCacheDirty = true;
     _Batches.clear_destruct();
 }
 
-void ImGuiPerfTool::_Rebuild()
+// Gather all labels. Legend batches will store data in this order.
+void ImGuiPerfTool::_RebuildLabels()
 {
-    if (_SrcData.empty())
-        return;
-
-    ImGuiStorage& temp_set = _TempSet;
     _Labels.resize(0);
-    _LabelsVisible.resize(0);
-    _InfoTableSort.resize(0);
-    _Batches.clear_destruct();
-    _InfoTableSortDirty = true;
-
-    // Gather all visible labels. Legend batches will store data in this order.
-    temp_set.Data.resize(0);    // name_id:IsLabelSeen
+    _LabelsIndex.Clear();
     for (ImGuiPerfToolEntry& entry : _SrcData)
     {
         ImGuiID name_id = ImHashStr(entry.TestName);
-        if (!temp_set.GetBool(name_id))
+        if (_LabelsIndex.GetInt(name_id, -1) < 0)
         {
-            temp_set.SetBool(name_id, true);
+            _LabelsIndex.SetInt(name_id, _Labels.Size);
             _Labels.push_back(entry.TestName);
-            if (_IsVisibleTest(entry.TestName))
-                _LabelsVisible.push_front(entry.TestName);
         }
     }
-    int num_visible_labels = _LabelsVisible.Size;
 
     // Labels are sorted in reverse order so they appear to be oredered from top down.
     ImQsort(_Labels.Data, _Labels.Size, sizeof(const char*), &PerfToolComparerStr);
-    ImQsort(_LabelsVisible.Data, num_visible_labels, sizeof(const char*), &PerfToolComparerStr);
+    for (int label_n = 0; label_n < _Labels.Size; label_n++)
+        _LabelsIndex.SetInt(ImHashStr(_Labels.Data[label_n]), label_n);
 
-    // _SrcData vector stores sorted raw entries of imgui_perflog.csv. Sorting is very important,
-    // algorithm depends on data being correctly sorted. Sorting _SrcData is OK, because it is only
-    // ever appended to and never written out to disk. Entries are sorted by multiple criteria,
-    // in specified order:
-    // 1. By branch name
-    // 2. By build ID
-    // 3. By run timestamp
-    // 4. By test name
-    // This results in a neatly partitioned dataset where similar data is grouped together and where perf test order
-    // is consistent in all batches. Sorting by build ID _before_ timestamp is also important as we will be aggregating
-    // entries by build ID instead of timestamp, when appropriate display mode is enabled.
-    ImQsort(_SrcData.Data, _SrcData.Size, sizeof(ImGuiPerfToolEntry), &PerfToolComparerByEntryInfo);
+    // Mean labels are pushed after sorting so they are always at the start of the chart.
+    for (const char* label : PerfToolMeanLabels)
+        _Labels.push_back(label);
 
-    // Sort groups of entries into batches.
+    _LabelsDirty = false;
+    _BatchesCacheDirty = true;
+}
+
+// Aggregate entries of every batch for all labels. Label visibility is applied by _Rebuild() on top of this cache,
+// so toggling it (or changing the baseline) does not walk _SrcData again.
+void ImGuiPerfTool::_RebuildBatchesCache()
+{
+    IM_ASSERT(_SrcDataSorted && !_LabelsDirty);
+    _BatchesCache.clear_destruct();
+    const int num_labels = _Labels.Size - IM_ARRAYSIZE(PerfToolMeanLabels);
     const bool combine_by_build_info = _DisplayType == ImGuiPerfToolDisplayType_CombineByBuildInfo;
-    _LabelBarCounts.Data.resize(0);
 
     // Process all batches. `entry` is always a first batch element (guaranteed by _SrcData being sorted by timestamp).
     // At the end of this loop we fast-forward until next batch (first entry having different batch id (which is a
@@ -608,88 +654,175 @@ void ImGuiPerfTool::_Rebuild()
     for (ImGuiPerfToolEntry* entry = _SrcData.begin(); entry < _SrcData.end();)
     {
         // Filtered out entries can be safely ignored. Note that entry++ does not follow logic of fast-forwarding to the
-        // next batch, as found at the end of this loop. This is OK, because all entries belonging to a same batch will
-        // also have same date.
-        if ((_FilterDateFrom[0] && strcmp(entry->Date, _FilterDateFrom) < 0) || (_FilterDateTo[0] && strcmp(entry->Date, _FilterDateTo) > 0))
+        // next batch, as found at the end of this loop. This is OK, because entries of a batch are also filtered out
+        // individually below (runs combined by build info may span several dates).
+        if (_IsFilteredOutByDate(entry))
         {
             entry++;
             continue;
         }
 
-        _Batches.push_back(ImGuiPerfToolBatch());
-        ImGuiPerfToolBatch& batch = _Batches.back();
+        _BatchesCache.push_back(ImGuiPerfToolBatch());
+        ImGuiPerfToolBatch& batch = _BatchesCache.back();
         batch.BatchID = GetBatchID(this, entry);
-        batch.Entries.resize(num_visible_labels);
+        batch.Entries.resize(num_labels);
 
         // Fill in defaults. Done once before data aggregation loop, because same entry may be touched multiple times in
         // the following loop when entries are being combined by build info.
-        for (int i = 0; i < num_visible_labels; i++)
+        for (int i = 0; i < num_labels; i++)
         {
             ImGuiPerfToolEntry* e = &batch.Entries.Data[i];
             *e = *entry;
             e->DtDeltaMs = 0;
             e->NumSamples = 0;
+            e->DtDeltaMsMin = +FLT_MAX;
+            e->DtDeltaMsMax = -FLT_MAX;
+            e->DtDeltaMsMedian = e->DtDeltaMsP90 = e->DtDeltaMsP99 = e->DtDeltaMsCI95 = 0;
+            e->NumFrames = e->NumOutliers = 0;
+            e->CpuDeltaMs = e->CyclesDelta = e->InstructionsDelta = e->CacheMissesDelta = e->BranchMissesDelta = 0;
+            e->NumCpuFrames = e->NumCounterFrames = 0;
             e->LabelIndex = i;
-            e->TestName = _LabelsVisible.Data[i];
+            e->TestName = _Labels.Data[i];
         }
 
-        // Find perf test runs for this particular batch and accumulate them.
-        for (int i = 0; i < num_visible_labels; i++)
+        // Accumulate perf test runs of this batch in a single pass. Due to sorting we are sure that batch always starts
+        // with `entry`, and all entries that belong to a batch (whether we combine by build info or not) will be grouped
+        // in _SrcData. Also count how many unique batches participate in a batch aggregated by build info.
+        batch.NumSamples = 1;
+        ImU64 last_timestamp = entry->Timestamp;
+        for (; entry < _SrcData.end() && GetBatchID(this, entry) == batch.BatchID; entry++)
         {
-            // This inner loop walks all entries that belong to current batch. Due to sorting we are sure that batch
-            // always starts with `entry`, and all entries that belong to a batch (whether we combine by build info or not)
-            // will be grouped in _SrcData.
-            ImGuiPerfToolEntry* aggregate = &batch.Entries.Data[i];
-            for (ImGuiPerfToolEntry* e = entry; e < _SrcData.end() && GetBatchID(this, e) == batch.BatchID; e++)
+            if (_IsFilteredOutByDate(entry))
+                continue;
+            if (combine_by_build_info && entry->Timestamp != last_timestamp)
             {
-                if (strcmp(e->TestName, aggregate->TestName) != 0)
-                    continue;
-                aggregate->DtDeltaMs += e->DtDeltaMs;
-                aggregate->NumSamples++;
-                aggregate->DtDeltaMsMin = ImMin(aggregate->DtDeltaMsMin, e->DtDeltaMs);
-                aggregate->DtDeltaMsMax = ImMax(aggregate->DtDeltaMsMax, e->DtDeltaMs);
+                batch.NumSamples++;
+                last_timestamp = entry->Timestamp;
             }
+
+            const int label_n = _LabelsIndex.GetInt(ImHashStr(entry->TestName), -1);
+            IM_ASSERT(label_n >= 0 && label_n < num_labels);
+            ImGuiPerfToolEntry* aggregate = &batch.Entries.Data[label_n];
+            aggregate->DtDeltaMs += entry->DtDeltaMs;
+            aggregate->NumSamples++;
+            aggregate->DtDeltaMsMin = ImMin(aggregate->DtDeltaMsMin, entry->DtDeltaMs);
+            aggregate->DtDeltaMsMax = ImMax(aggregate->DtDeltaMsMax, entry->DtDeltaMs);
+
+            // Statistics are weighted by number of frames (entries without statistics don't contribute)
+            aggregate->DtDeltaMsMedian += entry->DtDeltaMsMedian * entry->NumFrames;
+            aggregate->DtDeltaMsP90 += entry->DtDeltaMsP90 * entry->NumFrames;
+            aggregate->DtDeltaMsP99 += entry->DtDeltaMsP99 * entry->NumFrames;
+            aggregate->DtDeltaMsCI95 += entry->DtDeltaMsCI95 * entry->NumFrames;
+            aggregate->NumFrames += entry->NumFrames;
+            aggregate->NumOutliers += entry->NumOutliers;
+            aggregate->CpuDeltaMs += entry->CpuDeltaMs * entry->NumCpuFrames;
+            aggregate->NumCpuFrames += entry->NumCpuFrames;
+            aggregate->CyclesDelta += entry->CyclesDelta * entry->NumCounterFrames;
+            aggregate->InstructionsDelta += entry->InstructionsDelta * entry->NumCounterFrames;
+            aggregate->CacheMissesDelta += entry->CacheMissesDelta * entry->NumCounterFrames;
+            aggregate->BranchMissesDelta += entry->BranchMissesDelta * entry->NumCounterFrames;
+            aggregate->NumCounterFrames += entry->NumCounterFrames;
         }
 
-        // In case data is combined by build info, DtDeltaMs will be a sum of all combined entries. Average it out.
-        if (combine_by_build_info)
-            for (int i = 0; i < num_visible_labels; i++)
+        for (ImGuiPerfToolEntry& aggregate : batch.Entries)
+        {
+            // In case data is combined by build info, DtDeltaMs will be a sum of all combined entries. Average it out.
+            if (combine_by_build_info && aggregate.NumSamples > 0)
+                aggregate.DtDeltaMs /= aggregate.NumSamples;
+            if (aggregate.NumFrames > 0)
             {
-                ImGuiPerfToolEntry* aggregate = &batch.Entries.Data[i];
-                if (aggregate->NumSamples > 0)
-                    aggregate->DtDeltaMs /= aggregate->NumSamples;
+                aggregate.DtDeltaMsMedian /= aggregate.NumFrames;
+                aggregate.DtDeltaMsP90 /= aggregate.NumFrames;
+                aggregate.DtDeltaMsP99 /= aggregate.NumFrames;
+                aggregate.DtDeltaMsCI95 /= aggregate.NumFrames;
             }
-
-        // Advance to the next batch.
-        batch.NumSamples = 1;
-        if (combine_by_build_info)
-        {
-            ImU64 last_timestamp = entry->Timestamp;
-            for (ImGuiID build_id = GetBuildID(entry); entry < _SrcData.end() && build_id == GetBuildID(entry);)
+            if (aggregate.NumCpuFrames > 0)
+                aggregate.CpuDeltaMs /= aggregate.NumCpuFrames;
+            if (aggregate.NumCounterFrames > 0)
             {
-                // Also count how many unique batches participate in this aggregated batch.
-                if (entry->Timestamp != last_timestamp)
-                {
-                    batch.NumSamples++;
-                    last_timestamp = entry->Timestamp;
-                }
-                entry++;
+                aggregate.CyclesDelta /= aggregate.NumCounterFrames;
+                aggregate.InstructionsDelta /= aggregate.NumCounterFrames;
+                aggregate.CacheMissesDelta /= aggregate.NumCounterFrames;
+                aggregate.BranchMissesDelta /= aggregate.NumCounterFrames;
             }
         }
-        else
+    }
+
+    _BatchesCacheDirty = false;
+    _BatchesCacheDisplayType = _DisplayType;
+    ImStrncpy(_BatchesCacheDateFrom, _FilterDateFrom, IM_ARRAYSIZE(_BatchesCacheDateFrom));
+    ImStrncpy(_BatchesCacheDateTo, _FilterDateTo, IM_ARRAYSIZE(_BatchesCacheDateTo));
+}
+
+void ImGuiPerfTool::_Rebuild()
+{
+    if (_SrcData.empty())
+        return;
+
+    ImGuiStorage& temp_set = _TempSet;
+    _LabelsVisible.resize(0);
+    _InfoTableSort.resize(0);
+    _Batches.clear_destruct();
+    _InfoTableSortDirty = true;
+
+    // _SrcData vector stores sorted raw entries of imgui_perflog.csv. Sorting is very important,
+    // algorithm depends on data being correctly sorted. Sorting _SrcData is OK, because it is only
+    // ever appended to and never written out to disk. Entries are sorted by multiple criteria,
+    // in specified order:
+    // 1. By branch name
+    // 2. By build ID
+    // 3. By run timestamp
+    // 4. By test name
+    // This results in a neatly partitioned dataset where similar data is grouped together and where perf test order
+    // is consistent in all batches. Sorting by build ID _before_ timestamp is also important as we will be aggregating
+    // entries by build ID instead of timestamp, when appropriate display mode is enabled.
+    // AddEntry() keeps this order, so a full sort is only needed after loading a log.
+    if (!_SrcDataSorted)
+    {
+        ImQsort(_SrcData.Data, _SrcData.Size, sizeof(ImGuiPerfToolEntry), &PerfToolComparerByEntryInfo);
+        _SrcDataSorted = true;
+        _BatchesCacheDirty = true;
+    }
+    if (_LabelsDirty)
+        _RebuildLabels();
+    if (_BatchesCacheDirty || _BatchesCacheDisplayType != _DisplayType || strcmp(_BatchesCacheDateFrom, _FilterDateFrom) != 0 || strcmp(_BatchesCacheDateTo, _FilterDateTo) != 0)
+        _RebuildBatchesCache();
+
+    // Gather visible labels, in the same order as _Labels.
+    const int num_labels = _Labels.Size - IM_ARRAYSIZE(PerfToolMeanLabels);
+    ImVector<int> visible_label_to_label;
+    for (int label_n = 0; label_n < num_labels; label_n++)
+    {
+        if (!_IsVisibleTest(_Labels.Data[label_n]))
+            continue;
+        _LabelsVisible.push_back(_Labels.Data[label_n]);
+        visible_label_to_label.push_back(label_n);
+    }
+    int num_visible_labels = _LabelsVisible.Size;
+
+    const bool combine_by_build_info = _DisplayType == ImGuiPerfToolDisplayType_CombineByBuildInfo;
+    _LabelBarCounts.Data.resize(0);
+
+    // Pick aggregates of visible labels out of cached batches.
+    _Batches.reserve(_BatchesCache.Size);
+    for (ImGuiPerfToolBatch& cached_batch : _BatchesCache)
+    {
+        _Batches.push_back(ImGuiPerfToolBatch());
+        ImGuiPerfToolBatch& batch = _Batches.back();
+        batch.BatchID = cached_batch.BatchID;
+        batch.NumSamples = cached_batch.NumSamples;
+        batch.Entries.resize(num_visible_labels);
+        for (int i = 0; i < num_visible_labels; i++)
         {
-            for (ImU64 timestamp = entry->Timestamp; entry < _SrcData.end() && timestamp == entry->Timestamp;)
-                entry++;
+            batch.Entries.Data[i] = cached_batch.Entries.Data[visible_label_to_label.Data[i]];
+            batch.Entries.Data[i].LabelIndex = i;
         }
     }
 
     // Create man entries for every batch.
-    // Pushed after sorting so they are always at the start of the chart.
-    const char* mean_labels[] = { "harmonic mean", "arithmetic mean", "geometric mean" };
     int num_visible_mean_labels = 0;
-    for (const char* label : mean_labels)
+    for (const char* label : PerfToolMeanLabels)
     {
-        _Labels.push_back(label);
         if (_IsVisibleTest(label))
         {
            _LabelsVisible.push_back(label);
@@ -710,9 +843,9 @@ void ImGuiPerfTool::_Rebuild()
         }
 
         int visible_label_i = 0;
-        for (int i = 0; i < IM_ARRAYSIZE(mean_labels); i++)
+        for (int i = 0; i < IM_ARRAYSIZE(PerfToolMeanLabels); i++)
         {
-            if (!_IsVisibleTest(mean_labels[i]))
+            if (!_IsVisibleTest(PerfToolMeanLabels[i]))
                 continue;
 
             batch.Entries.push_back(ImGuiPerfToolEntry());
@@ -805,26 +938,58 @@ void ImGuiPerfTool::Clear()
 {
     _Labels.clear();
     _LabelsVisible.clear();
+    _LabelsIndex.Clear();
     _Batches.clear_destruct();
+    _BatchesCache.clear_destruct();
     _Visibility.Clear();
     _SrcData.clear_destruct();
+    _SrcDataSorted = true;
+    _LabelsDirty = _BatchesCacheDirty = true;
     _CsvParser->Clear();
+    _BinaryFile->Close();
+    _CsvSize = 0;
 
     ImStrncpy(_FilterDateFrom, "9999-99-99", IM_ARRAYSIZE(_FilterDateFrom));
     ImStrncpy(_FilterDateTo, "0000-00-00", IM_ARRAYSIZE(_FilterDateFrom));
 }
 
-bool ImGuiPerfTool::LoadCSV(const char* filename)
+// Read entries of a .csv log, starting at byte 'offset'. With 'complete_lines_only', a last line without new line is left for
+// a later read, as another process may still be writing it. Set _CsvSize to offset following last read line.
+// Return false if file can't be read or is smaller than 'offset'.
+static bool PerfToolLoadCSV(ImGuiPerfTool* perftool, const char* filename, ImU64 offset, bool complete_lines_only)
 {
-    if (filename == nullptr)
-        filename = IMGUI_PERFLOG_DEFAULT_FILENAME;
-
-    Clear();
+    perftool->Clear();
+    perftool->_SrcDataSorted = false;   // Keep file order until _Rebuild(), sorting rows one by one is slower
 
-    ImGuiCsvParser* parser = _CsvParser;
-    parser->Columns = 11;
-    if (!parser->Load(filename))
+    FILE* f = fopen(filename, "rb");
+    if (f == nullptr)
+        return false;
+    fseek(f, 0, SEEK_END);
+    const long file_size = ftell(f);
+    if (file_size < 0 || (ImU64)file_size < offset)
+    {
+        fclose(f);
         return false;
+    }
+    ImVector<char> data;
+    data.resize((int)((ImU64)file_size - offset));
+    fseek(f, (long)offset, SEEK_SET);
+    const bool read_ok = fread(data.Data, 1, (size_t)data.Size, f) == (size_t)data.Size;
+    fclose(f);
+    if (!read_ok)
+        return false;
+
+    int data_size = data.Size;
+    if (complete_lines_only)
+        while (data_size > 0 && data[data_size - 1] != '\n')
+            data_size--;
+    perftool->_CsvSize = offset + (ImU64)data_size;
+
+    ImGuiCsvParser* parser = perftool->_CsvParser;
+    parser->Columns = 24;
+    parser->ColumnsMin = 11;    // Entries recorded before per-frame statistics and CPU time/hardware counters were added
+    if (data_size == 0 || !parser->LoadFromMemory(data.Data, (size_t)data_size))
+        return true;            // No rows
 
     // Read perf test entries from CSV
     for (int row = 0; row < parser->Rows; row++)
@@ -842,12 +1007,665 @@ bool ImGuiPerfTool::LoadCSV(const char* filename)
         entry.OS = parser->GetCell(row, col++);
         entry.Compiler = parser->GetCell(row, col++);
         entry.Date = parser->GetCell(row, col++);
-        AddEntry(&entry);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.DtDeltaMsMedian);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.DtDeltaMsP90);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.DtDeltaMsP99);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.DtDeltaMsCI95);
+        sscanf(parser->GetCell(row, col++), "%d", &entry.NumFrames);
+        sscanf(parser->GetCell(row, col++), "%d", &entry.NumOutliers);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.CpuDeltaMs);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.CyclesDelta);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.InstructionsDelta);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.CacheMissesDelta);
+        sscanf(parser->GetCell(row, col++), "%lf", &entry.BranchMissesDelta);
+        sscanf(parser->GetCell(row, col++), "%d", &entry.NumCpuFrames);
+        sscanf(parser->GetCell(row, col++), "%d", &entry.NumCounterFrames);
+        perftool->AddEntry(&entry);
+    }
+
+    return true;
+}
+
+bool ImGuiPerfTool::LoadCSV(const char* filename)
+{
+    if (filename == nullptr)
+        filename = IMGUI_PERFLOG_DEFAULT_FILENAME;
+
+    return PerfToolLoadCSV(this, filename, 0, false) && _CsvParser->Rows > 0;
+}
+
+bool ImGuiPerfTool::SaveCSV(const char* filename)
+{
+    if (!ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)))
+        return false;
+    FILE* f = fopen(filename, "wb");
+    if (f == nullptr)
+        return false;
+    for (const ImGuiPerfToolEntry& entry : _SrcData)
+        PerfToolWriteCSVLine(f, &entry);
+    fclose(f);
+    return true;
+}
+
+//-------------------------------------------------------------------------
+// Binary perf log
+//-------------------------------------------------------------------------
+// Append-only file made of self-contained blocks, each storing a number of entries column by column:
+// - File header:   char Magic[8] = "IMPERFLG", u32 Version, u32 Reserved, u64 CsvSize (size of .csv log imported into this file).
+// - Block header:  u32 BlockSize (total, including header), u32 NumRows, u32 NumColumns, u32 StringsSize.
+// - Block data:    char Strings[StringsSize] (zero-terminated, interned within the block), followed by NumColumns
+//                  arrays of NumRows values. String columns store u32 offsets into Strings. Sections are padded to 8 bytes.
+// Appending an entry writes a small block with a single fwrite() call: concurrent appends from multiple processes
+// don't need to coordinate string ids. ImGuiTestEngine_PerfToolConvertLog() rewrites a log as a single block (compaction).
+// Default binary log mirrors default .csv log, see ImGuiTestEngine_PerfToolUpdateBinaryLog().
+// Columns are never reordered: new columns are added at the end of PerfLogBinaryColumns[], older blocks simply have fewer
+// columns and unknown trailing columns are skipped. Values are stored in native byte order.
+// Loading maps the file in memory: strings of loaded entries point directly into the mapping.
+//-------------------------------------------------------------------------
+
+static const char   PerfLogBinaryMagic[8] = { 'I', 'M', 'P', 'E', 'R', 'F', 'L', 'G' };
+static const ImU32  PerfLogBinaryVersion = 1;
+static const int    PerfLogBinaryFileHeaderSize = 24;
+static const int    PerfLogBinaryFileHeaderCsvSizeOffset = 16;
+static const int    PerfLogBinaryBlockHeaderSize = 16;
+static const int    PerfLogBinaryCompactBlocksCount = 256;  // ImGuiTestEngine_PerfToolUpdateBinaryLog() rewrites log as a single block when it has more blocks
+
+struct ImGuiPerfLogBinaryColumn
+{
+    int             Offset;
+    ImGuiDataType   Type;           // ImGuiDataType_COUNT for strings
+
+    int             GetSize() const { return (Type == ImGuiDataType_U64 || Type == ImGuiDataType_Double) ? 8 : 4; }
+};
+
+// Same order as .csv columns
+static const ImGuiPerfLogBinaryColumn PerfLogBinaryColumns[] =
+{
+    { offsetof(ImGuiPerfToolEntry, Timestamp),          ImGuiDataType_U64 },
+    { offsetof(ImGuiPerfToolEntry, Category),           ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, TestName),           ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, DtDeltaMs),          ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, PerfStressAmount),   ImGuiDataType_S32 },
+    { offsetof(ImGuiPerfToolEntry, GitBranchName),      ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, BuildType),          ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, Cpu),                ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, OS),                 ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, Compiler),           ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, Date),               ImGuiDataType_COUNT },
+    { offsetof(ImGuiPerfToolEntry, DtDeltaMsMedian),    ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, DtDeltaMsP90),       ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, DtDeltaMsP99),       ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, DtDeltaMsCI95),      ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, NumFrames),          ImGuiDataType_S32 },
+    { offsetof(ImGuiPerfToolEntry, NumOutliers),        ImGuiDataType_S32 },
+    { offsetof(ImGuiPerfToolEntry, CpuDeltaMs),         ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, CyclesDelta),        ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, InstructionsDelta),  ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, CacheMissesDelta),   ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, BranchMissesDelta),  ImGuiDataType_Double },
+    { offsetof(ImGuiPerfToolEntry, NumCpuFrames),       ImGuiDataType_S32 },
+    { offsetof(ImGuiPerfToolEntry, NumCounterFrames),   ImGuiDataType_S32 },
+};
+
+static size_t PerfLogBinaryAlign(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+// Append one block storing 'entries' to 'out_buf'
+static void PerfLogBinaryWriteBlock(ImVector<char>* out_buf, const ImGuiPerfToolEntry* entries, int entries_count)
+{
+    // Intern strings: one copy of each unique string per block
+    ImVector<char> strings;
+    ImVector<ImU32> string_offsets;             // [column_n * entries_count + row_n] for string columns
+    ImGuiStorage string_map;                    // Hash -> offset + 1
+    const int columns_count = IM_ARRAYSIZE(PerfLogBinaryColumns);
+    string_offsets.resize(columns_count * entries_count);
+    for (int column_n = 0; column_n < columns_count; column_n++)
+    {
+        const ImGuiPerfLogBinaryColumn& column = PerfLogBinaryColumns[column_n];
+        if (column.Type != ImGuiDataType_COUNT)
+            continue;
+        for (int row_n = 0; row_n < entries_count; row_n++)
+        {
+            const char* str = *(const char* const*)((const char*)&entries[row_n] + column.Offset);
+            if (str == nullptr)
+                str = "";
+            const ImGuiID str_hash = ImHashStr(str);
+            int str_offset = string_map.GetInt(str_hash, 0) - 1;
+            if (str_offset < 0 || strcmp(strings.Data + str_offset, str) != 0) // Also handle hash collisions
+            {
+                str_offset = strings.Size;
+                strings.resize(strings.Size + (int)strlen(str) + 1);
+                memcpy(strings.Data + str_offset, str, strlen(str) + 1);
+                string_map.SetInt(str_hash, str_offset + 1);
+            }
+            string_offsets[column_n * entries_count + row_n] = (ImU32)str_offset;
+        }
+    }
+
+    // Calculate layout
+    size_t block_size = PerfLogBinaryBlockHeaderSize + PerfLogBinaryAlign((size_t)strings.Size);
+    for (const ImGuiPerfLogBinaryColumn& column : PerfLogBinaryColumns)
+        block_size += PerfLogBinaryAlign((size_t)column.GetSize() * entries_count);
+
+    // Write block
+    const int block_start = out_buf->Size;
+    out_buf->resize(block_start + (int)block_size);
+    char* p = out_buf->Data + block_start;
+    memset(p, 0, block_size);
+    const ImU32 header[4] = { (ImU32)block_size, (ImU32)entries_count, (ImU32)columns_count, (ImU32)strings.Size };
+    memcpy(p, header, sizeof(header));
+    p += PerfLogBinaryBlockHeaderSize;
+    if (strings.Size > 0)
+        memcpy(p, strings.Data, (size_t)strings.Size);
+    p += PerfLogBinaryAlign((size_t)strings.Size);
+    for (int column_n = 0; column_n < columns_count; column_n++)
+    {
+        const ImGuiPerfLogBinaryColumn& column = PerfLogBinaryColumns[column_n];
+        const int value_size = column.GetSize();
+        for (int row_n = 0; row_n < entries_count; row_n++)
+        {
+            const void* value = (column.Type == ImGuiDataType_COUNT) ? (const void*)&string_offsets[column_n * entries_count + row_n] : (const void*)((const char*)&entries[row_n] + column.Offset);
+            memcpy(p + (size_t)row_n * value_size, value, (size_t)value_size);
+        }
+        p += PerfLogBinaryAlign((size_t)value_size * entries_count);
     }
+    IM_ASSERT(p == out_buf->Data + block_start + block_size);
+}
+
+static void PerfLogBinaryWriteFileHeader(ImVector<char>* out_buf, ImU64 csv_size)
+{
+    const ImU32 header[2] = { PerfLogBinaryVersion, 0 };
+    out_buf->resize(out_buf->Size + PerfLogBinaryFileHeaderSize);
+    char* p = out_buf->Data + out_buf->Size - PerfLogBinaryFileHeaderSize;
+    memcpy(p, PerfLogBinaryMagic, sizeof(PerfLogBinaryMagic));
+    memcpy(p + sizeof(PerfLogBinaryMagic), header, sizeof(header));
+    memcpy(p + PerfLogBinaryFileHeaderCsvSizeOffset, &csv_size, sizeof(csv_size));
+}
+
+static bool PerfLogBinaryCheckFileHeader(const char* data, size_t size, ImU64* out_csv_size = nullptr)
+{
+    ImU32 version = 0;
+    if (size < (size_t)PerfLogBinaryFileHeaderSize || memcmp(data, PerfLogBinaryMagic, sizeof(PerfLogBinaryMagic)) != 0)
+        return false;
+    memcpy(&version, data + sizeof(PerfLogBinaryMagic), sizeof(version));
+    if (out_csv_size != nullptr)
+        memcpy(out_csv_size, data + PerfLogBinaryFileHeaderCsvSizeOffset, sizeof(*out_csv_size));
+    return version == PerfLogBinaryVersion;
+}
+
+// Validate block at 'p' and return its size, or 0 if block is invalid or truncated (e.g. interrupted write).
+static size_t PerfLogBinaryReadBlockHeader(const char* p, const char* p_end, ImU32 out_header[4])
+{
+    if (p_end - p < PerfLogBinaryBlockHeaderSize)
+        return 0;
+    memcpy(out_header, p, sizeof(ImU32) * 4);
+    const size_t block_size = out_header[0];
+    const size_t rows_count = out_header[1];
+    if (block_size < (size_t)PerfLogBinaryBlockHeaderSize || block_size > (size_t)(p_end - p) || (block_size & 7) != 0)
+        return 0;
+
+    // Known columns and strings must fit in block, strings must be zero-terminated
+    size_t used_size = PerfLogBinaryBlockHeaderSize + PerfLogBinaryAlign(out_header[3]);
+    for (int column_n = 0; column_n < IM_ARRAYSIZE(PerfLogBinaryColumns) && column_n < (int)out_header[2]; column_n++)
+        used_size += PerfLogBinaryAlign(PerfLogBinaryColumns[column_n].GetSize() * rows_count);
+    if (used_size > block_size)
+        return 0;
+    if (out_header[3] > 0 && p[PerfLogBinaryBlockHeaderSize + out_header[3] - 1] != 0)
+        return 0;
+    return block_size;
+}
+
+bool ImGuiPerfTool::LoadBinary(const char* filename)
+{
+    if (filename == nullptr)
+        filename = IMGUI_PERFLOG_BINARY_DEFAULT_FILENAME;
+
+    Clear();
+
+    ImFileMapping* file = _BinaryFile;
+    if (!file->Open(filename))
+        return false;
+    if (!PerfLogBinaryCheckFileHeader(file->Data, file->Size, &_CsvSize))
+    {
+        file->Close();
+        _CsvSize = 0;
+        return false;
+    }
+    const char* data_begin = file->Data + PerfLogBinaryFileHeaderSize;
+    const char* data_end = file->Data + file->Size;
+
+    // Count rows so entries are stored without reallocation
+    // (a truncated or invalid block ends the log, e.g. after an interrupted write)
+    ImU32 header[4];
+    int rows_total = 0;
+    for (const char* p = data_begin; p < data_end; )
+    {
+        const size_t block_size = PerfLogBinaryReadBlockHeader(p, data_end, header);
+        if (block_size == 0)
+            break;
+        rows_total += (int)header[1];
+        p += block_size;
+    }
+    _SrcData.reserve(rows_total);
+
+    // Read perf test entries, column by column
+    const int columns_known = IM_ARRAYSIZE(PerfLogBinaryColumns);
+    for (const char* p = data_begin; p < data_end; )
+    {
+        const size_t block_size = PerfLogBinaryReadBlockHeader(p, data_end, header);
+        if (block_size == 0)
+            break;
+        const int rows_count = (int)header[1];
+        const int columns_count = ImMin((int)header[2], columns_known);
+        const ImU32 strings_size = header[3];
+        const char* strings = p + PerfLogBinaryBlockHeaderSize;
+        const int first_entry = _SrcData.Size;
+        _SrcData.resize(_SrcData.Size + rows_count);
+        for (int row_n = 0; row_n < rows_count; row_n++)
+            _SrcData[first_entry + row_n] = ImGuiPerfToolEntry();
+
+        const char* column_data = strings + PerfLogBinaryAlign(strings_size);
+        for (int column_n = 0; column_n < columns_count; column_n++)
+        {
+            const ImGuiPerfLogBinaryColumn& column = PerfLogBinaryColumns[column_n];
+            const int value_size = column.GetSize();
+            for (int row_n = 0; row_n < rows_count; row_n++)
+            {
+                char* dst = (char*)&_SrcData[first_entry + row_n] + column.Offset;
+                if (column.Type == ImGuiDataType_COUNT)
+                {
+                    ImU32 str_offset;
+                    memcpy(&str_offset, column_data + (size_t)row_n * value_size, sizeof(str_offset));
+                    const char* str = (str_offset < strings_size) ? strings + str_offset : "";
+                    memcpy(dst, &str, sizeof(str));
+                }
+                else
+                {
+                    memcpy(dst, column_data + (size_t)row_n * value_size, (size_t)value_size);
+                }
+            }
+            column_data += PerfLogBinaryAlign((size_t)value_size * rows_count);
+        }
+
+        // Update date filter range
+        for (int row_n = 0; row_n < rows_count; row_n++)
+        {
+            const char* date = _SrcData[first_entry + row_n].Date;
+            if (strcmp(_FilterDateFrom, date) > 0)
+                ImStrncpy(_FilterDateFrom, date, IM_ARRAYSIZE(_FilterDateFrom));
+            if (strcmp(_FilterDateTo, date) < 0)
+                ImStrncpy(_FilterDateTo, date, IM_ARRAYSIZE(_FilterDateTo));
+        }
+        p += block_size;
+    }
+    _SrcDataSorted = false;
+    _LabelsDirty = _BatchesCacheDirty = true;
+    _Batches.clear_destruct();
 
     return true;
 }
 
+bool ImGuiPerfTool::LoadDefaultLog()
+{
+    if (ImGuiTestEngine_PerfToolUpdateBinaryLog() && LoadBinary(IMGUI_PERFLOG_BINARY_DEFAULT_FILENAME))
+        return true;
+    return LoadCSV(IMGUI_PERFLOG_DEFAULT_FILENAME);
+}
+
+bool ImGuiPerfTool::SaveBinary(const char* filename)
+{
+    ImVector<char> buf;
+    PerfLogBinaryWriteFileHeader(&buf, _CsvSize);
+    if (_SrcData.Size > 0)
+        PerfLogBinaryWriteBlock(&buf, _SrcData.Data, _SrcData.Size);
+
+    if (!ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)))
+        return false;
+    FILE* f = fopen(filename, "wb");
+    if (f == nullptr)
+        return false;
+    const bool ret = fwrite(buf.Data, 1, (size_t)buf.Size, f) == (size_t)buf.Size;
+    fclose(f);
+    return ret;
+}
+
+// This is declared as a standalone function in order to run without a PerfTool instance
+void ImGuiTestEngine_PerfToolAppendToBinary(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename)
+{
+    if (filename == nullptr)
+        filename = IMGUI_PERFLOG_BINARY_DEFAULT_FILENAME;
+
+    if (!ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)))
+    {
+        fprintf(stderr, "Unable to create missing directory '%*s', perftool entry was not saved.\n", (int)(ImPathFindFilename(filename) - filename), filename);
+        return;
+    }
+
+    // Writes are always done at end of file in "a" mode, header is only read
+    FILE* f = fopen(filename, "a+b");
+    if (f == nullptr)
+    {
+        fprintf(stderr, "Unable to open '%s', perftool entry was not saved.\n", filename);
+        return;
+    }
+    char file_header[PerfLogBinaryFileHeaderSize];
+    fseek(f, 0, SEEK_SET);
+    const size_t file_header_size = fread(file_header, 1, sizeof(file_header), f);
+    if (file_header_size > 0 && !PerfLogBinaryCheckFileHeader(file_header, file_header_size))
+    {
+        fprintf(stderr, "'%s' is not a perf log of a supported version, perftool entry was not saved.\n", filename);
+        fclose(f);
+        return;
+    }
+
+    ImVector<char> buf;
+    if (file_header_size == 0)
+        PerfLogBinaryWriteFileHeader(&buf, 0);
+    PerfLogBinaryWriteBlock(&buf, entry, 1);
+    fseek(f, 0, SEEK_END);
+    fwrite(buf.Data, 1, (size_t)buf.Size, f);
+    fflush(f);
+    fclose(f);
+
+    // Register to runtime perf tool if any
+    if (perf_log != nullptr)
+        perf_log->AddEntry(entry);
+}
+
+// Replace 'dst_filename' with entries of 'perftool'. Write into a temporary file first, as destination may be the file
+// mapped in memory by 'perftool'. Name is unique per process, as several processes may write concurrently.
+static bool PerfToolReplaceLog(ImGuiPerfTool* perftool, const char* dst_filename)
+{
+    const bool dst_is_csv = ImStricmp(ImPathFindExtension(dst_filename), ".csv") == 0;
+    Str256f temp_filename("%s.%d.tmp", dst_filename, ImOsGetCurrentProcessId());
+    if (!(dst_is_csv ? perftool->SaveCSV(temp_filename.c_str()) : perftool->SaveBinary(temp_filename.c_str())))
+        return false;
+    perftool->Clear();
+#ifdef _WIN32
+    ImFileDelete(dst_filename); // rename() doesn't replace existing files on Windows. Elsewhere it atomically replaces destination, which always stays readable.
+#endif
+    if (rename(temp_filename.c_str(), dst_filename) != 0)
+    {
+        ImFileDelete(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Convert between .csv and binary perf logs (format is selected by file extension).
+// Converting a binary log into itself rewrites it as a single block.
+bool ImGuiTestEngine_PerfToolConvertLog(const char* src_filename, const char* dst_filename)
+{
+    ImGuiPerfTool perftool;
+    const bool src_is_csv = ImStricmp(ImPathFindExtension(src_filename), ".csv") == 0;
+    if (!(src_is_csv ? perftool.LoadCSV(src_filename) : perftool.LoadBinary(src_filename)))
+        return false;
+    return PerfToolReplaceLog(&perftool, dst_filename);
+}
+
+// Return true when all blocks of binary log are valid, and read size of .csv log imported into it and number of blocks.
+// A truncated block (e.g. interrupted write) would hide blocks appended after it.
+static bool PerfLogBinaryCheckFile(const char* filename, ImU64* out_csv_size, int* out_blocks_count)
+{
+    ImFileMapping file;
+    *out_blocks_count = 0;
+    if (!file.Open(filename) || !PerfLogBinaryCheckFileHeader(file.Data, file.Size, out_csv_size))
+        return false;
+    ImU32 header[4];
+    const char* data_end = file.Data + file.Size;
+    for (const char* p = file.Data + PerfLogBinaryFileHeaderSize; p < data_end; )
+    {
+        const size_t block_size = PerfLogBinaryReadBlockHeader(p, data_end, header);
+        if (block_size == 0)
+            return false;
+        p += block_size;
+        (*out_blocks_count)++;
+    }
+    return true;
+}
+
+// The .csv log is the reference log: it is also written by builds without binary log, and by processes which don't update
+// binary log (see ImGuiTestEngineIO::ConfigPerfLogUpdateBinary). Binary log header stores size of .csv log imported so far,
+// rows appended after that are imported into a new block. Binary log is rebuilt when missing or invalid, or when .csv log shrunk.
+// Not safe to call from several processes at the same time, as they would import the same rows.
+bool ImGuiTestEngine_PerfToolUpdateBinaryLog(const char* csv_filename, const char* bin_filename)
+{
+    if (csv_filename == nullptr)
+        csv_filename = IMGUI_PERFLOG_DEFAULT_FILENAME;
+    if (bin_filename == nullptr)
+        bin_filename = IMGUI_PERFLOG_BINARY_DEFAULT_FILENAME;
+    if (!ImFileExist(csv_filename))
+        return ImFileExist(bin_filename);
+
+    // Import rows appended to .csv log since last update
+    ImGuiPerfTool perftool;
+    ImU64 csv_imported_size = 0;
+    int blocks_count = 0;
+    if (PerfLogBinaryCheckFile(bin_filename, &csv_imported_size, &blocks_count) && PerfToolLoadCSV(&perftool, csv_filename, csv_imported_size, true))
+    {
+        if (perftool._CsvSize != csv_imported_size)
+        {
+            ImVector<char> buf;
+            if (perftool._SrcData.Size > 0)
+            {
+                PerfLogBinaryWriteBlock(&buf, perftool._SrcData.Data, perftool._SrcData.Size);
+                blocks_count++;
+            }
+
+            // Header is written last: if interrupted, rows are imported again rather than lost
+            FILE* f = fopen(bin_filename, "r+b");
+            if (f == nullptr)
+                return false;
+            bool ret = fseek(f, 0, SEEK_END) == 0 && fwrite(buf.Data, 1, (size_t)buf.Size, f) == (size_t)buf.Size && fflush(f) == 0;
+            ret = ret && fseek(f, PerfLogBinaryFileHeaderCsvSizeOffset, SEEK_SET) == 0 && fwrite(&perftool._CsvSize, sizeof(perftool._CsvSize), 1, f) == 1;
+            fclose(f);
+            if (!ret)
+                return false;
+        }
+
+        // Updates after each PerfCapture() append single-entry blocks, which store each string and pad each column again.
+        // Rewrite log as a single block once they add up, so it stays columnar and smaller than .csv log.
+        if (blocks_count <= PerfLogBinaryCompactBlocksCount)
+            return true;
+        perftool.Clear();
+        return ImGuiTestEngine_PerfToolConvertLog(bin_filename, bin_filename);
+    }
+
+    // Rebuild from whole .csv log
+    if (!PerfToolLoadCSV(&perftool, csv_filename, 0, true))
+        return false;
+    return PerfToolReplaceLog(&perftool, bin_filename);
+}
+
+struct ImGuiPerfToolCheckRun
+{
+    ImGuiID                     BuildID;
+    const ImGuiPerfToolEntry*   Entry;
+};
+
+static int IMGUI_CDECL PerfToolComparerCheckRun(const void* lhs, const void* rhs)
+{
+    const ImGuiPerfToolCheckRun* a = (const ImGuiPerfToolCheckRun*)lhs;
+    const ImGuiPerfToolCheckRun* b = (const ImGuiPerfToolCheckRun*)rhs;
+    if (a->BuildID != b->BuildID)
+        return (a->BuildID < b->BuildID) ? -1 : +1;
+    if (int result = strcmp(a->Entry->TestName, b->Entry->TestName))
+        return result;
+    return (a->Entry->Timestamp < b->Entry->Timestamp) ? -1 : (a->Entry->Timestamp > b->Entry->Timestamp) ? +1 : 0;
+}
+
+static int IMGUI_CDECL PerfToolComparerTimestamp(const void* lhs, const void* rhs)
+{
+    const ImU64 a = *(const ImU64*)lhs;
+    const ImU64 b = *(const ImU64*)rhs;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+// Check perf tests of builds present in the most recent run for regressions. For each test the latest 'window' runs are
+// compared with the 'window' runs before them. A test regressed when a one-sided Mann-Whitney U test finds recent runs
+// slower with p-value <= 'max_p_value', and median slowdown is at least 'min_delta_percent' (or 'min_delta_ms' when
+// previous median is not positive, making a relative change meaningless).
+// Tests which were not part of the most recent run or which have less than 'window * 2' runs are not checked.
+int ImGuiTestEngine_PerfToolCheckRegressions(ImGuiPerfTool* perf_log, ImVector<ImGuiPerfToolCheckResult>* out_results, int window, double min_delta_percent, double min_delta_ms, double max_p_value)
+{
+    IM_ASSERT(perf_log != nullptr && out_results != nullptr);
+    IM_ASSERT(window >= 2);
+    out_results->resize(0);
+
+    // Find the most recent run. Each -jobs worker stamps entries with its own start time, so a run is a range of
+    // timestamps: the newest one, and timestamps preceding it by at most 'max_gap' each.
+    const ImU64 max_gap = 60 * 1000000;     // Microseconds
+    ImVector<ImU64> timestamps;
+    timestamps.reserve(perf_log->_SrcData.Size);
+    for (const ImGuiPerfToolEntry& entry : perf_log->_SrcData)
+        timestamps.push_back(entry.Timestamp);
+    ImQsort(timestamps.Data, (size_t)timestamps.Size, sizeof(ImU64), PerfToolComparerTimestamp);
+    ImU64 latest_run_start = timestamps.empty() ? 0 : timestamps.back();
+    for (int n = timestamps.Size - 2; n >= 0 && latest_run_start - timestamps[n] <= max_gap; n--)
+        latest_run_start = timestamps[n];
+
+    ImGuiStorage latest_builds;     // build_id:IsInLatestRun
+    for (const ImGuiPerfToolEntry& entry : perf_log->_SrcData)
+        if (entry.Timestamp >= latest_run_start)
+            latest_builds.SetBool(GetBuildID(&entry), true);
+
+    // Group runs of each test by build, ordered by timestamp
+    ImVector<ImGuiPerfToolCheckRun> runs;
+    for (const ImGuiPerfToolEntry& entry : perf_log->_SrcData)
+    {
+        const ImGuiID build_id = GetBuildID(&entry);
+        if (latest_builds.GetBool(build_id))
+            runs.push_back({ build_id, &entry });
+    }
+    ImQsort(runs.Data, (size_t)runs.Size, sizeof(ImGuiPerfToolCheckRun), PerfToolComparerCheckRun);
+
+    int num_regressions = 0;
+    ImVector<double> recent;
+    ImVector<double> previous;
+    for (int run_begin = 0; run_begin < runs.Size; )
+    {
+        int run_end = run_begin + 1;
+        while (run_end < runs.Size && runs[run_end].BuildID == runs[run_begin].BuildID && strcmp(runs[run_end].Entry->TestName, runs[run_begin].Entry->TestName) == 0)
+            run_end++;
+        const ImGuiPerfToolEntry* latest = runs[run_end - 1].Entry;
+        const int run_first = run_end - window * 2;
+        if (latest->Timestamp < latest_run_start || run_first < run_begin)
+        {
+            run_begin = run_end;
+            continue;
+        }
+
+        previous.resize(0);
+        recent.resize(0);
+        for (int n = run_first; n < run_end; n++)
+            (n < run_end - window ? previous : recent).push_back(runs[n].Entry->DtDeltaMs);
+
+        ImGuiPerfToolCheckResult result;
+        result.Entry = *latest;
+        result.NumRecent = recent.Size;
+        result.NumPrevious = previous.Size;
+        result.PValue = ImStatsMannWhitneyU(recent.Data, recent.Size, previous.Data, previous.Size, &result.RankBiserial);
+
+        ImStatsSummary stats;
+        ImStatsCalcSummary(recent.Data, recent.Size, &stats);
+        result.RecentMedianMs = stats.Median;
+        ImStatsCalcSummary(previous.Data, previous.Size, &stats);
+        result.PreviousMedianMs = stats.Median;
+
+        const double delta_ms = result.RecentMedianMs - result.PreviousMedianMs;
+        result.DeltaPercent = (result.PreviousMedianMs > 0.0) ? delta_ms / result.PreviousMedianMs * 100.0 : 0.0;
+        const bool is_large_delta = (result.PreviousMedianMs > 0.0) ? (result.DeltaPercent >= min_delta_percent) : (delta_ms >= min_delta_ms);
+        result.Regressed = delta_ms > 0.0 && result.PValue <= max_p_value && is_large_delta;
+        if (result.Regressed)
+            num_regressions++;
+        out_results->push_back(result);
+        run_begin = run_end;
+    }
+    return num_regressions;
+}
+
+static void PerfToolWriteJsonString(FILE* f, const char* str)
+{
+    fputc('"', f);
+    for (const char* p = str ? str : ""; *p; p++)
+    {
+        if (*p == '"' || *p == '\\')
+            fprintf(f, "\\%c", *p);
+        else if ((unsigned char)*p < 0x20)
+            fprintf(f, "\\u%04x", (unsigned char)*p);
+        else
+            fputc(*p, f);
+    }
+    fputc('"', f);
+}
+
+bool ImGuiTestEngine_PerfToolExportCheckResults(const ImVector<ImGuiPerfToolCheckResult>& results, const char* filename)
+{
+    if (!ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)))
+        return false;
+    FILE* f = fopen(filename, "wb");
+    if (f == nullptr)
+        return false;
+
+    int num_regressions = 0;
+    for (const ImGuiPerfToolCheckResult& result : results)
+        if (result.Regressed)
+            num_regressions++;
+
+    if (ImStricmp(ImPathFindExtension(filename), ".json") == 0)
+    {
+        fprintf(f, "{\n  \"tests\": %d,\n  \"regressions\": %d,\n  \"results\": [\n", results.Size, num_regressions);
+        for (int n = 0; n < results.Size; n++)
+        {
+            const ImGuiPerfToolCheckResult& result = results[n];
+            const char* properties[][2] =
+            {
+                { "test", result.Entry.TestName }, { "branch", result.Entry.GitBranchName }, { "build_type", result.Entry.BuildType },
+                { "cpu", result.Entry.Cpu }, { "os", result.Entry.OS }, { "compiler", result.Entry.Compiler },
+            };
+            fprintf(f, "    { ");
+            for (const auto& property : properties)
+            {
+                fprintf(f, "\"%s\": ", property[0]);
+                PerfToolWriteJsonString(f, property[1]);
+                fprintf(f, ", ");
+            }
+            fprintf(f, "\"recent_runs\": %d, \"previous_runs\": %d, \"recent_median_ms\": %.4f, \"previous_median_ms\": %.4f, \"delta_percent\": %.2f, \"rank_biserial\": %.3f, \"p_value\": %.5f, \"regressed\": %s }%s\n",
+                result.NumRecent, result.NumPrevious, result.RecentMedianMs, result.PreviousMedianMs, result.DeltaPercent, result.RankBiserial, result.PValue,
+                result.Regressed ? "true" : "false", (n + 1 < results.Size) ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+    }
+    else
+    {
+        fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<testsuites errors=\"0\" failures=\"%d\" name=\"Dear ImGui\" tests=\"%d\">\n"
+            "  <testsuite name=\"perf-check\" tests=\"%d\" errors=\"0\" failures=\"%d\">\n",
+            num_regressions, results.Size, results.Size, num_regressions);
+        for (const ImGuiPerfToolCheckResult& result : results)
+        {
+            const ImGuiPerfToolEntry& entry = result.Entry;
+            Str256 testcase_name = entry.TestName;
+            Str256f testcase_classname("%s/%s/%s/%s/%s", entry.GitBranchName, entry.BuildType, entry.Cpu, entry.OS, entry.Compiler);
+            ImStrXmlEscape(&testcase_name);
+            ImStrXmlEscape(&testcase_classname);
+            fprintf(f, "    <testcase name=\"%s\" classname=\"%s\"", testcase_name.c_str(), testcase_classname.c_str());
+            if (!result.Regressed)
+            {
+                fprintf(f, " />\n");
+                continue;
+            }
+            fprintf(f, ">\n      <failure message=\"%+.1f%% median (%.4f ms -&gt; %.4f ms), p = %.4f, r = %.2f\" type=\"regression\" />\n    </testcase>\n",
+                result.DeltaPercent, result.PreviousMedianMs, result.RecentMedianMs, result.PValue, result.RankBiserial);
+        }
+        fprintf(f, "  </testsuite>\n</testsuites>\n");
+    }
+    fclose(f);
+    return true;
+}
+
 void ImGuiPerfTool::ViewOnly(const char** perf_names)
 {
     // Data would not be built if we tried to view perftool of a particular test without first opening perftool via button. We need data to be built to hide perf tests.
@@ -905,6 +1723,11 @@ bool ImGuiPerfTool::_IsVisibleTest(const char* test_name)
     return _Visibility.GetBool(ImHashStr(test_name), true);
 }
 
+bool ImGuiPerfTool::_IsFilteredOutByDate(const ImGuiPerfToolEntry* entry)
+{
+    return (_FilterDateFrom[0] && strcmp(entry->Date, _FilterDateFrom) < 0) || (_FilterDateTo[0] && strcmp(entry->Date, _FilterDateTo) > 0);
+}
+
 void ImGuiPerfTool::_CalculateLegendAlignment()
 {
     // Estimate paddings for legend format so it looks nice and aligned
@@ -1015,7 +1838,17 @@ bool ImGuiPerfTool::SaveHtmlReport(const char* file_name, const char* image_file
                 case 9:  fprintf(fp, "| %.2f ", entry->DtDeltaMsMin);       break;
                 case 10: fprintf(fp, "| %.2f ", entry->DtDeltaMsMax);       break;
                 case 11: fprintf(fp, "| %d ", entry->NumSamples);           break;
-                case 12: FormatVsBaseline(entry, baseline_entry, label); fprintf(fp, "| %s ", label.c_str()); break;
+                case 12: fprintf(fp, entry->NumFrames ? "| %.2f " : "| -- ", entry->DtDeltaMsMedian); break;
+                case 13: fprintf(fp, entry->NumFrames ? "| %.2f " : "| -- ", entry->DtDeltaMsP90); break;
+                case 14: fprintf(fp, entry->NumFrames ? "| %.2f " : "| -- ", entry->DtDeltaMsP99); break;
+                case 15: fprintf(fp, entry->NumFrames ? "| %.2f " : "| -- ", entry->DtDeltaMsCI95); break;
+                case 16: fprintf(fp, "| %d ", entry->NumOutliers);          break;
+                case 17: fprintf(fp, entry->NumCpuFrames ? "| %.3f " : "| -- ", entry->CpuDeltaMs); break;
+                case 18: fprintf(fp, entry->NumCounterFrames ? "| %.0f " : "| -- ", entry->CyclesDelta); break;
+                case 19: fprintf(fp, entry->NumCounterFrames ? "| %.0f " : "| -- ", entry->InstructionsDelta); break;
+                case 20: fprintf(fp, entry->NumCounterFrames ? "| %.0f " : "| -- ", entry->CacheMissesDelta); break;
+                case 21: fprintf(fp, entry->NumCounterFrames ? "| %.0f " : "| -- ", entry->BranchMissesDelta); break;
+                case 22: FormatVsBaseline(entry, baseline_entry, label); fprintf(fp, "| %s ", label.c_str()); break;
                 default: IM_ASSERT(0); break;
                 }
             }
@@ -1060,7 +1893,7 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
     }
 
     if (ImGui::IsWindowAppearing() && Empty())
-        LoadCSV();
+        LoadDefaultLog();
 
     // -----------------------------------------------------------------------------------------------------------------
     // Render utility buttons
@@ -1497,7 +2330,14 @@ void ImGuiPerfTool::_ShowEntriesPlot()
         for (int i = 0; i < _Batches.Size; i++)
         {
             if (ImGuiPerfToolEntry* hovered_entry = GetEntryByBatchIdx(i, test_name))
-                ImGui::Text("%s %.3fms", label.c_str(), hovered_entry->DtDeltaMs);
+            {
+                if (hovered_entry->NumFrames > 0)
+                    ImGui::Text("%s %.3fms +/- %.3f (median %.3fms)", label.c_str(), hovered_entry->DtDeltaMs, hovered_entry->DtDeltaMsCI95, hovered_entry->DtDeltaMsMedian);
+                else
+                    ImGui::Text("%s %.3fms", label.c_str(), hovered_entry->DtDeltaMs);
+                if (hovered_entry->NumCpuFrames > 0)
+                    ImGui::Text("CPU %.3fms (median)", hovered_entry->CpuDeltaMs);
+            }
             else
                 ImGui::Text("%s --", label.c_str());
         }
@@ -1659,6 +2499,41 @@ void ImGuiPerfTool::_ShowEntriesTable()
         if (ImGui::TableNextColumn())
             ImGui::Text("%d", entry->NumSamples);
 
+        // Median, P90, P99, CI95 ms, Outliers
+        const double stats[] = { entry->DtDeltaMsMedian, entry->DtDeltaMsP90, entry->DtDeltaMsP99, entry->DtDeltaMsCI95 };
+        for (double stat : stats)
+            if (ImGui::TableNextColumn())
+            {
+                if (entry->NumFrames > 0)
+                    ImGui::Text("%.3lf", stat);
+                else
+                    ImGui::TextUnformatted("--");
+            }
+        if (ImGui::TableNextColumn())
+        {
+            ImGui::Text("%d", entry->NumOutliers);
+            if (entry->NumFrames > 0 && ImGui::IsItemHovered())
+                ImGui::SetTooltip("%d/%d frames rejected", entry->NumOutliers, entry->NumFrames);
+        }
+
+        // CPU ms, hardware counters
+        if (ImGui::TableNextColumn())
+        {
+            if (entry->NumCpuFrames > 0)
+                ImGui::Text("%.3lf", entry->CpuDeltaMs);
+            else
+                ImGui::TextUnformatted("--");
+        }
+        const double counters[] = { entry->CyclesDelta, entry->InstructionsDelta, entry->CacheMissesDelta, entry->BranchMissesDelta };
+        for (double counter : counters)
+            if (ImGui::TableNextColumn())
+            {
+                if (entry->NumCounterFrames > 0)
+                    ImGui::Text("%.0lf", counter);
+                else
+                    ImGui::TextUnformatted("--");
+            }
+
         // VS Baseline
         if (ImGui::TableNextColumn())
         {
@@ -1803,6 +2678,24 @@ static bool SetPerfToolWindowOpen(ImGuiTestContext* ctx, bool is_open)
     return was_open;
 }
 
+// Entry of a run of a "perf" test with a Release/X64/Linux build. Strings are not copied and need to outlive the entry.
+static ImGuiPerfToolEntry PerfToolTestMakeEntry(ImU64 timestamp, const char* test_name, double dt_delta_ms, const char* branch_name = "master", const char* compiler = "GCC", const char* date = "2024-01-01")
+{
+    ImGuiPerfToolEntry entry;
+    entry.Timestamp = timestamp;
+    entry.Category = "perf";
+    entry.TestName = test_name;
+    entry.DtDeltaMs = dt_delta_ms;
+    entry.PerfStressAmount = 5;
+    entry.GitBranchName = branch_name;
+    entry.BuildType = "Release";
+    entry.Cpu = "X64";
+    entry.OS = "Linux";
+    entry.Compiler = compiler;
+    entry.Date = date;
+    return entry;
+}
+
 void RegisterTests_TestEnginePerfTool(ImGuiTestEngine* e)
 {
     ImGuiTest* t = nullptr;
@@ -1890,6 +2783,334 @@ void RegisterTests_TestEnginePerfTool(ImGuiTestEngine* e)
         SetPerfToolWindowOpen(ctx, perf_was_open);                   // Restore window visibility
     };
 
+    // ## Incremental rebuild: sorted insertion and cached batches should produce the same data as a full rebuild.
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_perftool_incremental_rebuild");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+        const char* test_names[] = { "perf_b", "perf_c", "perf_a" };
+        const char* branch_names[] = { "master", "docking" };
+        ImGuiPerfTool perftool_incremental;
+        ImGuiPerfTool perftool_full;
+        for (int n = 0; n < 60; n++)
+        {
+            // Runs are not added in order
+            ImGuiPerfToolEntry entry = PerfToolTestMakeEntry(1000 + (n * 7) % 10, test_names[n % 3], 1.0 + n * 0.25, branch_names[(n / 3) % 2]);
+            entry.DtDeltaMsMedian = entry.DtDeltaMs;
+            entry.NumFrames = 10;
+            perftool_incremental.AddEntry(&entry);
+            perftool_incremental._Rebuild();
+            perftool_full.AddEntry(&entry);
+        }
+        for (int n = 1; n < perftool_incremental._SrcData.Size; n++)
+            IM_CHECK_LE(PerfToolComparerByEntryInfo(&perftool_incremental._SrcData[n - 1], &perftool_incremental._SrcData[n]), 0);
+
+        for (int display_type = 0; display_type < 3; display_type++)
+        {
+            for (int hidden_n = -1; hidden_n < IM_ARRAYSIZE(test_names); hidden_n++)
+            {
+                ImGuiPerfTool* perftools[] = { &perftool_incremental, &perftool_full };
+                for (ImGuiPerfTool* perftool : perftools)
+                {
+                    perftool->_DisplayType = (ImGuiPerfToolDisplayType)display_type;
+                    for (int n = 0; n < IM_ARRAYSIZE(test_names); n++)
+                        perftool->_Visibility.SetBool(ImHashStr(test_names[n]), n != hidden_n);
+                }
+                perftool_incremental._Rebuild();
+                perftool_full._SrcDataSorted = false;
+                perftool_full._LabelsDirty = perftool_full._BatchesCacheDirty = true;
+                perftool_full._Rebuild();
+
+                IM_CHECK_EQ(perftool_incremental._LabelsVisible.Size, perftool_full._LabelsVisible.Size);
+                IM_CHECK_EQ(perftool_incremental._Batches.Size, perftool_full._Batches.Size);
+                for (int batch_n = 0; batch_n < perftool_full._Batches.Size; batch_n++)
+                {
+                    const ImGuiPerfToolBatch& batch_incremental = perftool_incremental._Batches[batch_n];
+                    const ImGuiPerfToolBatch& batch_full = perftool_full._Batches[batch_n];
+                    IM_CHECK_EQ(batch_incremental.BatchID, batch_full.BatchID);
+                    IM_CHECK_EQ(batch_incremental.NumSamples, batch_full.NumSamples);
+                    IM_CHECK_EQ(batch_incremental.Entries.Size, batch_full.Entries.Size);
+                    for (int entry_n = 0; entry_n < batch_full.Entries.Size; entry_n++)
+                    {
+                        const ImGuiPerfToolEntry& entry_incremental = batch_incremental.Entries[entry_n];
+                        const ImGuiPerfToolEntry& entry_full = batch_full.Entries[entry_n];
+                        IM_CHECK_STR_EQ(entry_incremental.TestName, entry_full.TestName);
+                        IM_CHECK_EQ(entry_incremental.LabelIndex, entry_n);
+                        IM_CHECK_EQ(entry_incremental.NumSamples, entry_full.NumSamples);
+                        IM_CHECK_EQ(entry_incremental.DtDeltaMs, entry_full.DtDeltaMs);
+                        IM_CHECK_EQ(entry_incremental.DtDeltaMsMedian, entry_full.DtDeltaMsMedian);
+                    }
+                }
+            }
+        }
+    };
+
+    // ## Batch aggregates combined by build info, with runs out of date range filtered out. Expected values are hand-computed.
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_perftool_batch_aggregate");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+        ImGuiPerfTool perftool;
+        struct { ImU64 Timestamp; const char* TestName; double DtDeltaMs; double DtDeltaMsMedian; int NumFrames; const char* Compiler; const char* Date; } runs[] =
+        {
+            { 300, "perf_a", 100.0, 100.0, 10, "GCC",   "2024-02-01" },  // Filtered out (after date range)
+            { 300, "perf_b", 100.0,   0.0,  0, "GCC",   "2024-02-01" },  // Filtered out (after date range)
+            { 200, "perf_a",   3.0,   2.5, 30, "GCC",   "2024-01-15" },
+            { 200, "perf_b",   6.0,   0.0,  0, "GCC",   "2024-01-15" },
+            { 100, "perf_a",   1.0,   0.5, 10, "GCC",   "2024-01-01" },
+            { 100, "perf_b",   4.0,   0.0,  0, "GCC",   "2024-01-01" },
+            {  50, "perf_a",  50.0,  50.0, 10, "GCC",   "2023-12-01" },  // Filtered out (before date range), combined with in-range runs of same build
+            {  50, "perf_b",  50.0,   0.0,  0, "GCC",   "2023-12-01" },  // Filtered out (before date range), combined with in-range runs of same build
+            { 150, "perf_a",   2.0,   1.5, 20, "Clang", "2024-01-15" },  // No "perf_b" run for this build
+        };
+        for (auto& run : runs)
+        {
+            ImGuiPerfToolEntry entry = PerfToolTestMakeEntry(run.Timestamp, run.TestName, run.DtDeltaMs, "master", run.Compiler, run.Date);
+            entry.DtDeltaMsMedian = run.DtDeltaMsMedian;
+            entry.NumFrames = run.NumFrames;
+            perftool.AddEntry(&entry);
+        }
+
+        // AddEntry() widens date range to include all entries, narrow it after adding them.
+        ImStrncpy(perftool._FilterDateFrom, "2024-01-01", IM_ARRAYSIZE(perftool._FilterDateFrom));
+        ImStrncpy(perftool._FilterDateTo, "2024-01-31", IM_ARRAYSIZE(perftool._FilterDateTo));
+
+        // One batch per run in range.
+        perftool._DisplayType = ImGuiPerfToolDisplayType_Simple;
+        perftool._Rebuild();
+        IM_CHECK_EQ(perftool._Batches.Size, 3);
+
+        // One batch per build, aggregating runs in range.
+        perftool._DisplayType = ImGuiPerfToolDisplayType_CombineByBuildInfo;
+        perftool._Rebuild();
+        IM_CHECK_EQ(perftool._Batches.Size, 2);
+        IM_CHECK_EQ(perftool._LabelsVisible.Size, 2 + IM_ARRAYSIZE(PerfToolMeanLabels));
+        for (ImGuiPerfToolBatch& batch : perftool._Batches)
+        {
+            const bool is_gcc = strcmp(batch.Entries[0].Compiler, "GCC") == 0;
+            ImGuiPerfToolEntry* entry_a = nullptr;
+            ImGuiPerfToolEntry* entry_b = nullptr;
+            ImGuiPerfToolEntry* entry_mean = nullptr;
+            for (ImGuiPerfToolEntry& entry : batch.Entries)
+            {
+                if (strcmp(entry.TestName, "perf_a") == 0)
+                    entry_a = &entry;
+                else if (strcmp(entry.TestName, "perf_b") == 0)
+                    entry_b = &entry;
+                else if (strcmp(entry.TestName, "arithmetic mean") == 0)
+                    entry_mean = &entry;
+            }
+            IM_CHECK(entry_a != nullptr && entry_b != nullptr && entry_mean != nullptr);
+
+            if (is_gcc)
+            {
+                // perf_a: runs 3.0 (30 frames, median 2.5) and 1.0 (10 frames, median 0.5). perf_b: runs 6.0 and 4.0, no frame statistics.
+                IM_CHECK_EQ(batch.NumSamples, 2);
+                IM_CHECK_EQ(entry_a->NumSamples, 2);
+                IM_CHECK_EQ(entry_a->DtDeltaMs, 2.0);                   // (3.0 + 1.0) / 2
+                IM_CHECK_EQ(entry_a->DtDeltaMsMin, 1.0);
+                IM_CHECK_EQ(entry_a->DtDeltaMsMax, 3.0);
+                IM_CHECK_EQ(entry_a->NumFrames, 40);
+                IM_CHECK_EQ(entry_a->DtDeltaMsMedian, 2.0);             // (2.5 * 30 + 0.5 * 10) / 40
+                IM_CHECK_EQ(entry_b->NumSamples, 2);
+                IM_CHECK_EQ(entry_b->DtDeltaMs, 5.0);                   // (6.0 + 4.0) / 2
+                IM_CHECK_EQ(entry_b->DtDeltaMsMin, 4.0);
+                IM_CHECK_EQ(entry_b->DtDeltaMsMax, 6.0);
+                IM_CHECK_EQ(entry_b->NumFrames, 0);
+                IM_CHECK_EQ(entry_b->DtDeltaMsMedian, 0.0);
+                IM_CHECK_EQ(entry_mean->DtDeltaMs, 3.5);                // (2.0 + 5.0) / 2
+            }
+            else
+            {
+                IM_CHECK_STR_EQ(batch.Entries[0].Compiler, "Clang");
+                IM_CHECK_EQ(batch.NumSamples, 1);
+                IM_CHECK_EQ(entry_a->NumSamples, 1);
+                IM_CHECK_EQ(entry_a->DtDeltaMs, 2.0);
+                IM_CHECK_EQ(entry_a->DtDeltaMsMin, 2.0);
+                IM_CHECK_EQ(entry_a->DtDeltaMsMax, 2.0);
+                IM_CHECK_EQ(entry_a->NumFrames, 20);
+                IM_CHECK_EQ(entry_a->DtDeltaMsMedian, 1.5);
+                IM_CHECK_EQ(entry_b->NumSamples, 0);
+                IM_CHECK_EQ(entry_b->DtDeltaMs, 0.0);
+                IM_CHECK_EQ(entry_mean->DtDeltaMs, 1.0);                // (2.0 + 0.0) / 2
+            }
+        }
+    };
+
+    // ## Perf regression check: latest runs against previous runs of same build.
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_perftool_regression_check");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+        ImGuiPerfTool perftool;
+        const char* test_names[] = { "perf_stable", "perf_regressed", "perf_improved", "perf_zero_noise", "perf_zero_regressed" };
+        const ImU64 first_run_time = 1700000000000000;
+        const ImU64 run_interval = (ImU64)3600 * 1000000;  // Hourly runs, in microseconds
+        for (int run_n = 0; run_n < 12; run_n++)
+        {
+            for (int test_n = 0; test_n < IM_ARRAYSIZE(test_names); test_n++)
+            {
+                const bool is_recent_run = run_n >= 7;
+                double dt_delta_ms;
+                if (test_n < 3)
+                {
+                    dt_delta_ms = 1.0 + (run_n % 3) * 0.01;
+                    if (is_recent_run && test_n == 1)
+                        dt_delta_ms *= 1.2;
+                    if (is_recent_run && test_n == 2)
+                        dt_delta_ms *= 0.8;
+                }
+                else
+                {
+                    // Median of previous runs is 0.0 ms: use absolute threshold
+                    dt_delta_ms = ((run_n % 3) - 1) * 0.001;
+                    if (is_recent_run)
+                        dt_delta_ms += (test_n == 3) ? 0.004 : 0.5;
+                }
+                // Each test runs in a -jobs worker started a few seconds apart from others, in a different order every run
+                ImGuiPerfToolEntry entry = PerfToolTestMakeEntry(first_run_time + run_n * run_interval + ((test_n + run_n) % 3) * 2000000, test_names[test_n], dt_delta_ms);
+                perftool.AddEntry(&entry);
+            }
+        }
+
+        // Regressed build which is not part of the most recent run is not checked
+        for (int run_n = 0; run_n < 10; run_n++)
+        {
+            ImGuiPerfToolEntry entry = PerfToolTestMakeEntry(first_run_time - (10 - run_n) * run_interval, "perf_regressed", (run_n < 5) ? 1.0 : 2.0, "master", "Clang", "2023-12-01");
+            perftool.AddEntry(&entry);
+        }
+
+        ImVector<ImGuiPerfToolCheckResult> results;
+        IM_CHECK_EQ(ImGuiTestEngine_PerfToolCheckRegressions(&perftool, &results, 5), 2);
+        IM_CHECK_EQ(results.Size, IM_ARRAYSIZE(test_names));
+        for (const ImGuiPerfToolCheckResult& result : results)
+        {
+            const bool is_regressed_test = strcmp(result.Entry.TestName, "perf_regressed") == 0;
+            IM_CHECK_STR_EQ(result.Entry.Compiler, "GCC");
+            IM_CHECK_EQ(result.NumRecent, 5);
+            IM_CHECK_EQ(result.NumPrevious, 5);
+            IM_CHECK_EQ(result.Regressed, is_regressed_test || strcmp(result.Entry.TestName, "perf_zero_regressed") == 0);
+            if (is_regressed_test)
+            {
+                IM_CHECK_GT(result.DeltaPercent, 15.0);
+                IM_CHECK_EQ(result.RankBiserial, 1.0);
+                IM_CHECK_LT(result.PValue, 0.05);
+            }
+        }
+
+        // Not enough runs for a larger window
+        IM_CHECK_EQ(ImGuiTestEngine_PerfToolCheckRegressions(&perftool, &results, 7), 0);
+        IM_CHECK_EQ(results.Size, 0);
+    };
+
+    // ## Binary perf log: append, load, convert from/to .csv
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_perftool_binary_log");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        const char* temp_perf_bin = "output/testengine_perftool_binary_log.bin";
+        const char* temp_perf_csv = "output/testengine_perftool_binary_log.csv";
+        ImFileDelete(temp_perf_bin);
+
+        const char* test_names[] = { "perf_a", "perf_b", "perf_c" };
+        for (int n = 0; n < 30; n++)
+        {
+            ImGuiPerfToolEntry entry = PerfToolTestMakeEntry(1000 + n / 3, test_names[n % 3], n * 0.5, (n & 1) ? "master" : nullptr, "GCC", (n < 15) ? "2024-01-01" : "2024-02-01");
+            entry.NumFrames = n;
+            entry.CyclesDelta = n * 1000.0;
+            ImGuiTestEngine_PerfToolAppendToBinary(nullptr, &entry, temp_perf_bin);
+        }
+
+        ImGuiPerfTool perftool;
+        IM_CHECK(perftool.LoadBinary(temp_perf_bin));
+        IM_CHECK_EQ(perftool._SrcData.Size, 30);
+        IM_CHECK_STR_EQ(perftool._FilterDateFrom, "2024-01-01");
+        IM_CHECK_STR_EQ(perftool._FilterDateTo, "2024-02-01");
+        for (int n = 0; n < perftool._SrcData.Size; n++)
+        {
+            const ImGuiPerfToolEntry& entry = perftool._SrcData[n];
+            IM_CHECK_EQ(entry.Timestamp, (ImU64)(1000 + n / 3));
+            IM_CHECK_STR_EQ(entry.TestName, test_names[n % 3]);
+            IM_CHECK_STR_EQ(entry.GitBranchName, (n & 1) ? "master" : "");
+            IM_CHECK_EQ(entry.DtDeltaMs, n * 0.5);
+            IM_CHECK_EQ(entry.NumFrames, n);
+            IM_CHECK_EQ(entry.CyclesDelta, n * 1000.0);
+        }
+
+        // Round-trip through .csv, then compact back into a single block
+        perftool.Clear();
+        IM_CHECK(ImGuiTestEngine_PerfToolConvertLog(temp_perf_bin, temp_perf_csv));
+        IM_CHECK(ImGuiTestEngine_PerfToolConvertLog(temp_perf_csv, temp_perf_bin));
+        IM_CHECK(ImGuiTestEngine_PerfToolConvertLog(temp_perf_bin, temp_perf_bin));
+        IM_CHECK(perftool.LoadBinary(temp_perf_bin));
+        IM_CHECK_EQ(perftool._SrcData.Size, 30);
+        IM_CHECK_STR_EQ(perftool._SrcData[29].TestName, "perf_c");
+        IM_CHECK_EQ(perftool._SrcData[29].DtDeltaMs, 14.5);
+        IM_CHECK_EQ(perftool._SrcData[29].PerfStressAmount, 5);
+
+        // Binary log converted from .csv log already contains all its entries
+        perftool.Clear();
+        IM_CHECK(ImGuiTestEngine_PerfToolUpdateBinaryLog(temp_perf_csv, temp_perf_bin));
+        IM_CHECK(perftool.LoadBinary(temp_perf_bin));
+        IM_CHECK_EQ(perftool._SrcData.Size, 30);
+
+        // Entries appended to .csv log only (e.g. by a build without binary log) are imported, a partially written line is left for next update
+        perftool.Clear();
+        ImGuiPerfToolEntry entry = PerfToolTestMakeEntry(2000, "perf_d", 1.5);
+        ImGuiTestEngine_PerfToolAppendToCSV(nullptr, &entry, temp_perf_csv);
+        FILE* f = fopen(temp_perf_csv, "ab");
+        IM_CHECK(f != nullptr);
+        fputs("2001,perf,perf_e,2.5", f);
+        fclose(f);
+        IM_CHECK(ImGuiTestEngine_PerfToolUpdateBinaryLog(temp_perf_csv, temp_perf_bin));
+        IM_CHECK(perftool.LoadBinary(temp_perf_bin));
+        IM_CHECK_EQ(perftool._SrcData.Size, 31);
+        IM_CHECK_STR_EQ(perftool._SrcData[30].TestName, "perf_d");
+        IM_CHECK_EQ(perftool._SrcData[30].DtDeltaMs, 1.5);
+
+        perftool.Clear();
+        f = fopen(temp_perf_csv, "ab");
+        IM_CHECK(f != nullptr);
+        fputs("00,x5,master,Release,X64,Linux,GCC,2024-03-01\n", f);
+        fclose(f);
+        IM_CHECK(ImGuiTestEngine_PerfToolUpdateBinaryLog(temp_perf_csv, temp_perf_bin));
+        IM_CHECK(perftool.LoadBinary(temp_perf_bin));
+        IM_CHECK_EQ(perftool._SrcData.Size, 32);
+        IM_CHECK_STR_EQ(perftool._SrcData[31].TestName, "perf_e");
+        IM_CHECK_EQ(perftool._SrcData[31].DtDeltaMs, 2.5);
+        IM_CHECK_STR_EQ(perftool._SrcData[31].Date, "2024-03-01");
+        size_t csv_size = 0;
+        IM_FREE(ImFileLoadToMemory(temp_perf_csv, "rb", &csv_size));
+        IM_CHECK_EQ(perftool._CsvSize, (ImU64)csv_size);
+
+        // Binary log is rebuilt when .csv log shrunk
+        perftool.Clear();
+        ImFileDelete(temp_perf_csv);
+        ImGuiTestEngine_PerfToolAppendToCSV(nullptr, &entry, temp_perf_csv);
+        IM_CHECK(ImGuiTestEngine_PerfToolUpdateBinaryLog(temp_perf_csv, temp_perf_bin));
+        IM_CHECK(perftool.LoadBinary(temp_perf_bin));
+        IM_CHECK_EQ(perftool._SrcData.Size, 1);
+        IM_CHECK_STR_EQ(perftool._SrcData[0].TestName, "perf_d");
+
+        // Binary log updated after each new entry is rewritten as a single block once blocks add up
+        perftool.Clear();
+        for (int n = 0; n < PerfLogBinaryCompactBlocksCount + 10; n++)
+        {
+            ImGuiTestEngine_PerfToolAppendToCSV(nullptr, &entry, temp_perf_csv);
+            IM_CHECK(ImGuiTestEngine_PerfToolUpdateBinaryLog(temp_perf_csv, temp_perf_bin));
+        }
+        ImU64 csv_imported_size = 0;
+        int blocks_count = 0;
+        IM_CHECK(PerfLogBinaryCheckFile(temp_perf_bin, &csv_imported_size, &blocks_count));
+        IM_CHECK_LE(blocks_count, PerfLogBinaryCompactBlocksCount);
+        IM_CHECK(perftool.LoadBinary(temp_perf_bin));
+        IM_CHECK_EQ(perftool._SrcData.Size, 1 + PerfLogBinaryCompactBlocksCount + 10);
+        IM_CHECK_EQ(perftool._CsvSize, csv_imported_size);
+
+        perftool.Clear();
+        ImFileDelete(temp_perf_bin);
+        ImFileDelete(temp_perf_csv);
+    };
+
     // ## Capture perf tool graph.
     t = IM_REGISTER_TEST(e, "capture", "capture_perf_report");
     t->TestFunc = [](ImGuiTestContext* ctx)
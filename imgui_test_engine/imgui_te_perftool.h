@@ -14,15 +14,18 @@
 struct ImGuiPerfToolColumnInfo;
 struct ImGuiTestEngine;
 struct ImGuiCsvParser;
+struct ImFileMapping;
 
 // Configuration
 #define IMGUI_PERFLOG_DEFAULT_FILENAME  "output/imgui_perflog.csv"
+#define IMGUI_PERFLOG_BINARY_DEFAULT_FILENAME   "output/imgui_perflog.bin"  // Same entries in binary columnar format, faster to load (see ImGuiTestEngine_PerfToolUpdateBinaryLog())
 
 // [Internal] Perf log entry. Changes to this struct should be reflected in ImGuiTestContext::PerfCapture() and ImGuiTestEngine_Start().
 // This struct assumes strings stored here will be available until next ImGuiPerfTool::Clear() call. Fortunately we do not have to actively
 // manage lifetime of these strings. New entries are created only in two cases:
 // 1. ImGuiTestEngine_PerfToolAppendToCSV() call after perf test has run. This call receives ImGuiPerfToolEntry with const strings stored indefinitely by application.
 // 2. As a consequence of ImGuiPerfTool::LoadCSV() call, we persist the ImGuiCSVParser instance, which keeps parsed CSV text, from which strings are referenced.
+//    Similarly ImGuiPerfTool::LoadBinary() keeps the binary log mapped in memory, and strings point into the mapping.
 // As a result our solution also doesn't make many allocations.
 struct IMGUI_API ImGuiPerfToolEntry
 {
@@ -33,6 +36,19 @@ struct IMGUI_API ImGuiPerfToolEntry
     double                      DtDeltaMsMin = +FLT_MAX;        // May be used by perftool.
     double                      DtDeltaMsMax = -FLT_MAX;        // May be used by perftool.
     int                         NumSamples = 1;                 // Number aggregated samples.
+    double                      DtDeltaMsMedian = 0.0;          // Median frame time, relative to median reference frame time.
+    double                      DtDeltaMsP90 = 0.0;             // 90th percentile frame time, relative to median reference frame time.
+    double                      DtDeltaMsP99 = 0.0;             // 99th percentile frame time, relative to median reference frame time.
+    double                      DtDeltaMsCI95 = 0.0;            // Half-width of 95% confidence interval of DtDeltaMs. Differences smaller than that are noise.
+    int                         NumFrames = 0;                  // Number of measured frames. 0 for entries recorded without per-frame statistics.
+    int                         NumOutliers = 0;                // Number of measured frames rejected as outliers (not included in DtDeltaMs).
+    double                      CpuDeltaMs = 0.0;               // Mean per-frame thread CPU time of GuiFunc + Render(), relative to reference (see ImGuiTestEngineIO::ConfigPerfCounters).
+    double                      CyclesDelta = 0.0;              // Median per-frame hardware counters of GuiFunc + Render(), relative to reference.
+    double                      InstructionsDelta = 0.0;        //
+    double                      CacheMissesDelta = 0.0;         //
+    double                      BranchMissesDelta = 0.0;        //
+    int                         NumCpuFrames = 0;               // Number of frames with CPU time measurement. 0 when not measured.
+    int                         NumCounterFrames = 0;           // Number of frames with hardware counters measurement. 0 when not measured or not supported.
     int                         PerfStressAmount = 0;           //
     const char*                 GitBranchName = nullptr;        // Build information.
     const char*                 BuildType = nullptr;            //
@@ -74,6 +90,14 @@ struct IMGUI_API ImGuiPerfTool
     ImVector<const char*>       _Labels;
     ImVector<const char*>       _LabelsVisible;                 // ImPlot requires a pointer of all labels beforehand. Always contains a dummy "" entry at the end!
     ImVector<ImGuiPerfToolBatch> _Batches;
+    ImVector<ImGuiPerfToolBatch> _BatchesCache;                 // Aggregates of all labels (not only visible ones) per batch ID, for the date filter and display type below.
+    ImGuiStorage                _LabelsIndex;                   // ImHashStr(TestName) -> index in _Labels.
+    bool                        _SrcDataSorted = true;          // AddEntry() keeps _SrcData sorted by insertion, bulk loads append and leave sorting to _Rebuild().
+    bool                        _LabelsDirty = true;            // A new test name was added.
+    bool                        _BatchesCacheDirty = true;      // _SrcData was modified since _BatchesCache was built.
+    ImGuiPerfToolDisplayType    _BatchesCacheDisplayType = ImGuiPerfToolDisplayType_Simple;
+    char                        _BatchesCacheDateFrom[11] = {};
+    char                        _BatchesCacheDateTo[11] = {};
     ImGuiStorage                _LabelBarCounts;                // Number bars each label will render.
     int                         _NumVisibleBuilds = 0;          // Cached number of visible builds.
     int                         _NumUniqueBuilds = 0;           // Cached number of unique builds.
@@ -104,12 +128,18 @@ struct IMGUI_API ImGuiPerfTool
     bool                        _ReportGenerating = false;
     ImGuiStorage                _Visibility;
     ImGuiCsvParser*             _CsvParser = nullptr;           // We keep this around and point to its fields
+    ImFileMapping*              _BinaryFile = nullptr;          // Binary log mapped in memory by LoadBinary(), strings of entries point into it
+    ImU64                       _CsvSize = 0;                   // Size of .csv log read by LoadCSV(), or size of .csv log imported into binary log read by LoadBinary(). Written by SaveBinary().
 
     ImGuiPerfTool();
     ~ImGuiPerfTool();
 
     void        Clear();
     bool        LoadCSV(const char* filename = nullptr);
+    bool        LoadBinary(const char* filename = nullptr);
+    bool        LoadDefaultLog();                               // Load default binary log after importing new entries of default .csv log into it, or default .csv log when binary log can't be updated
+    bool        SaveCSV(const char* filename);                  // Write all entries
+    bool        SaveBinary(const char* filename);               // Write all entries in a single block. Don't overwrite the file loaded by this instance: use ImGuiTestEngine_PerfToolConvertLog().
     void        AddEntry(ImGuiPerfToolEntry* entry);
 
     void        ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open);
@@ -120,9 +150,12 @@ struct IMGUI_API ImGuiPerfTool
     inline bool Empty()         { return _SrcData.empty(); }
 
     void        _Rebuild();
+    void        _RebuildLabels();
+    void        _RebuildBatchesCache();
     bool        _IsVisibleBuild(ImGuiPerfToolBatch* batch);
     bool        _IsVisibleBuild(ImGuiPerfToolEntry* batch);
     bool        _IsVisibleTest(const char* test_name);
+    bool        _IsFilteredOutByDate(const ImGuiPerfToolEntry* entry);
     void        _CalculateLegendAlignment();
     void        _ShowEntriesPlot();
     void        _ShowEntriesTable();
@@ -131,4 +164,23 @@ struct IMGUI_API ImGuiPerfTool
     void        _UnpackSortedKey(ImU64 key, int* batch_index, int* entry_index, int* monotonic_index = nullptr);
 };
 
+// Result of ImGuiTestEngine_PerfToolCheckRegressions() for one perf test of one build.
+struct ImGuiPerfToolCheckResult
+{
+    ImGuiPerfToolEntry          Entry;                          // Most recent entry (test name and build info).
+    int                         NumRecent = 0;                  // Number of runs in recent window.
+    int                         NumPrevious = 0;                // Number of runs in previous window.
+    double                      RecentMedianMs = 0.0;           // Median of DtDeltaMs of recent runs.
+    double                      PreviousMedianMs = 0.0;         // Median of DtDeltaMs of previous runs.
+    double                      DeltaPercent = 0.0;             // Effect size: change of median, relative to previous runs.
+    double                      RankBiserial = 0.0;             // Effect size: +1.0 when every recent run is slower than every previous run.
+    double                      PValue = 1.0;                   // One-sided Mann-Whitney U test of recent runs being slower.
+    bool                        Regressed = false;
+};
+
 IMGUI_API void    ImGuiTestEngine_PerfToolAppendToCSV(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename = nullptr);
+IMGUI_API void    ImGuiTestEngine_PerfToolAppendToBinary(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename = nullptr); // Entries of default .csv log are imported by ImGuiTestEngine_PerfToolUpdateBinaryLog() instead
+IMGUI_API bool    ImGuiTestEngine_PerfToolConvertLog(const char* src_filename, const char* dst_filename); // Convert between .csv and binary log (by file extension), or compact a binary log when both are the same
+IMGUI_API bool    ImGuiTestEngine_PerfToolUpdateBinaryLog(const char* csv_filename = nullptr, const char* bin_filename = nullptr); // Import entries appended to .csv log since last update into binary log (default logs when nullptr), creating it if needed
+IMGUI_API int     ImGuiTestEngine_PerfToolCheckRegressions(ImGuiPerfTool* perf_log, ImVector<ImGuiPerfToolCheckResult>* out_results, int window = 5, double min_delta_percent = 5.0, double min_delta_ms = 0.01, double max_p_value = 0.05); // Return number of regressed tests
+IMGUI_API bool    ImGuiTestEngine_PerfToolExportCheckResults(const ImVector<ImGuiPerfToolCheckResult>& results, const char* filename); // JSON when filename ends with .json, JUnit XML otherwise
@@ -135,6 +135,7 @@ static void DrawTestLog(ImGuiTestEngine* e, ImGuiTest* test)
     ImGuiTestOutput* test_output = &test->Output;
 
     ImGuiTestLog* log = &test_output->Log;
+    log->FlushDeferred();
     const char* text = log->Buffer.begin();
     const char* text_end = log->Buffer.end();
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(6.0f, 2.0f) * dpi_scale);
@@ -537,8 +538,8 @@ static void ShowTestGroup(ImGuiTestEngine* e, ImGuiTestGroup group, Str* filter)
             }
 
             // Process source popup
-            static ImGuiTextBuffer source_blurb;
-            static int goto_line = -1;
+            static thread_local ImGuiTextBuffer source_blurb;
+            static thread_local int goto_line = -1;
             if (view_source)
             {
                 source_blurb.clear();
@@ -633,7 +634,10 @@ static void ImGuiTestEngine_ShowLogAndTools(ImGuiTestEngine* engine)
         ImGui::SameLine();
         if (ImGui::SmallButton("Copy to clipboard"))
             if (engine->UiSelectedTest)
+            {
+                selected_test->Output.Log.FlushDeferred();
                 ImGui::SetClipboardText(selected_test->Output.Log.Buffer.c_str());
+            }
         ImGui::Separator();
 
         ImGui::BeginChild("Log");
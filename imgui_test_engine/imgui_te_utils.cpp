@@ -36,8 +36,18 @@
 #if defined(__linux) || defined(__linux__) || defined(__MACH__) || defined(__MSL__) || defined(__MINGW32__)
 #include <pthread.h>    // pthread_setname_np()
 #endif
+#if !defined(_WIN32) && (defined(__linux__) || defined(__APPLE__))
+#define IMGUI_TEST_ENGINE_HAS_MMAP
+#include <fcntl.h>              // open()
+#include <sys/mman.h>           // mmap()
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>   // perf_event_attr
+#include <sys/syscall.h>        // syscall(__NR_perf_event_open)
+#endif
 #include <chrono>       // high_resolution_clock::now()
 #include <thread>       // this_thread::sleep_for()
+#include <time.h>       // clock_gettime()
 
 //-----------------------------------------------------------------------------
 // Hashing Helpers
@@ -259,9 +269,11 @@ const char* ImFindNextDecoratedPartInPath(const char* str, const char* str_end)
 // File/Directory Helpers
 //-----------------------------------------------------------------------------
 // - ImFileExist()
+// - ImFileDelete()
 // - ImFileCreateDirectoryChain()
 // - ImFileFindInParents()
 // - ImFileLoadSourceBlurb()
+// - ImFileMapping
 //-----------------------------------------------------------------------------
 
 #if _WIN32
@@ -396,6 +408,94 @@ bool ImFileLoadSourceBlurb(const char* file_name, int line_no_start, int line_no
     return true;
 }
 
+bool ImFileMapping::Open(const char* filename)
+{
+    Close();
+#if defined(_WIN32) && !IMGUI_TEST_ENGINE_IS_GAME_CONSOLE
+    ImVector<wchar_t> buf;
+    ImUtf8ToWideChar(filename, &buf);
+    HANDLE file = ::CreateFileW(&buf[0], GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER file_size;
+    if (!::GetFileSizeEx(file, &file_size))
+    {
+        ::CloseHandle(file);
+        return false;
+    }
+    if (file_size.QuadPart > 0)
+    {
+        _Handle = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_Handle != nullptr)
+            Data = (const char*)::MapViewOfFile(_Handle, FILE_MAP_READ, 0, 0, 0);
+        if (Data == nullptr)
+        {
+            if (_Handle != nullptr)
+                ::CloseHandle(_Handle);
+            _Handle = nullptr;
+            ::CloseHandle(file);
+            return false;
+        }
+        Size = (size_t)file_size.QuadPart;
+        _IsMapped = true;
+    }
+    ::CloseHandle(file); // Mapping keeps a reference to the file
+    return true;
+#elif defined(IMGUI_TEST_ENGINE_HAS_MMAP)
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1)
+        return false;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    if (file_stat.st_size > 0)
+    {
+        void* data = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+        Data = (const char*)data;
+        Size = (size_t)file_stat.st_size;
+        _IsMapped = true;
+    }
+    close(fd); // Mapping keeps a reference to the file
+    return true;
+#else
+    if (!ImFileExist(filename))
+        return false;
+    Data = (const char*)ImFileLoadToMemory(filename, "rb", &Size, 0);
+    return Data != nullptr || Size == 0;
+#endif
+}
+
+void ImFileMapping::Close()
+{
+    if (Data != nullptr)
+    {
+#if defined(_WIN32) && !IMGUI_TEST_ENGINE_IS_GAME_CONSOLE
+        if (_IsMapped)
+        {
+            ::UnmapViewOfFile(Data);
+            ::CloseHandle(_Handle);
+        }
+#elif defined(IMGUI_TEST_ENGINE_HAS_MMAP)
+        if (_IsMapped)
+            munmap((void*)Data, Size);
+#endif
+        if (!_IsMapped)
+            IM_FREE((void*)Data);
+    }
+    Data = nullptr;
+    Size = 0;
+    _Handle = nullptr;
+    _IsMapped = false;
+}
+
 //-----------------------------------------------------------------------------
 // Path Helpers
 //-----------------------------------------------------------------------------
@@ -712,6 +812,7 @@ void ImTimestampToISO8601(uint64_t timestamp, Str* out_date)
 //-----------------------------------------------------------------------------
 // - ImThreadSleepInMilliseconds()
 // - ImThreadSetCurrentThreadDescription()
+// - ImThreadGetCpuTimeInNanoseconds()
 //-----------------------------------------------------------------------------
 
 void ImThreadSleepInMilliseconds(int ms)
@@ -786,6 +887,27 @@ void ImThreadSetCurrentThreadDescription(const char* description)
 #endif
 }
 
+// Unlike wall clock time, this is not affected by the thread being preempted or waiting on I/O.
+// Note that Windows only updates thread times on scheduler ticks (~15 ms), making it mostly useful over many frames.
+uint64_t ImThreadGetCpuTimeInNanoseconds()
+{
+#if defined(_WIN32) && !IMGUI_TEST_ENGINE_IS_GAME_CONSOLE
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+        return 0;
+    const uint64_t kernel_100ns = ((uint64_t)kernel_time.dwHighDateTime << 32) | kernel_time.dwLowDateTime;
+    const uint64_t user_100ns = ((uint64_t)user_time.dwHighDateTime << 32) | user_time.dwLowDateTime;
+    return (kernel_100ns + user_100ns) * 100;
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 // Build info helpers
 //-----------------------------------------------------------------------------
@@ -807,63 +929,63 @@ static void ImBuildParseDateFromCompilerIntoYMD(const char* in_date, char* out_b
 
 // Those strings are used to output easily identifiable markers in compare logs. We only need to support what we use for testing.
 // We can probably grab info in eaplatform.h/eacompiler.h etc. in EASTL
-const ImBuildInfo* ImBuildGetCompilationInfo()
+static void ImBuildInitCompilationInfo(ImBuildInfo& build_info)
 {
-    static ImBuildInfo build_info;
-
-    if (build_info.Type[0] == '\0')
-    {
-        // Build Type
+    // Build Type
 #if defined(DEBUG) || defined(_DEBUG)
-        build_info.Type = "Debug";
+    build_info.Type = "Debug";
 #else
-        build_info.Type = "Release";
+    build_info.Type = "Release";
 #endif
 
-        // CPU
+    // CPU
 #if defined(_M_X86) || defined(_M_IX86) || defined(__i386) || defined(__i386__) || defined(_X86_) || defined(_M_AMD64) || defined(_AMD64_) || defined(__x86_64__)
-        build_info.Cpu = (sizeof(size_t) == 4) ? "X86" : "X64";
+    build_info.Cpu = (sizeof(size_t) == 4) ? "X86" : "X64";
 #elif defined(__aarch64__) || (defined(_M_ARM64) && defined(_WIN64))
-        build_info.Cpu = "ARM64";
+    build_info.Cpu = "ARM64";
 #elif defined(__EMSCRIPTEN__)
-        build_info.Cpu = "WebAsm";
+    build_info.Cpu = "WebAsm";
 #else
-        build_info.Cpu = (sizeof(size_t) == 4) ? "Unknown32" : "Unknown64";
+    build_info.Cpu = (sizeof(size_t) == 4) ? "Unknown32" : "Unknown64";
 #endif
 
-        // Platform/OS
+    // Platform/OS
 #if defined(_WIN32)
-        build_info.OS = "Windows";
+    build_info.OS = "Windows";
 #elif defined(__linux) || defined(__linux__)
-        build_info.OS = "Linux";
+    build_info.OS = "Linux";
 #elif defined(__MACH__) || defined(__MSL__)
-        build_info.OS = "OSX";
+    build_info.OS = "OSX";
 #elif defined(__ORBIS__)
-        build_info.OS = "PS4";
+    build_info.OS = "PS4";
 #elif defined(__PROSPERO__)
-        build_info.OS = "PS5";
+    build_info.OS = "PS5";
 #elif defined(_DURANGO)
-        build_info.OS = "XboxOne";
+    build_info.OS = "XboxOne";
 #else
-        build_info.OS = "Unknown";
+    build_info.OS = "Unknown";
 #endif
 
-        // Compiler
+    // Compiler
 #if defined(_MSC_VER)
-        build_info.Compiler = "MSVC";
+    build_info.Compiler = "MSVC";
 #elif defined(__clang__)
-        build_info.Compiler = "Clang";
+    build_info.Compiler = "Clang";
 #elif defined(__GNUC__)
-        build_info.Compiler = "GCC";
+    build_info.Compiler = "GCC";
 #else
-        build_info.Compiler = "Unknown";
+    build_info.Compiler = "Unknown";
 #endif
 
-        // Date/Time
-        ImBuildParseDateFromCompilerIntoYMD(__DATE__, build_info.Date, IM_ARRAYSIZE(build_info.Date));
-        build_info.Time = __TIME__;
-    }
+    // Date/Time
+    ImBuildParseDateFromCompilerIntoYMD(__DATE__, build_info.Date, IM_ARRAYSIZE(build_info.Date));
+    build_info.Time = __TIME__;
+}
 
+const ImBuildInfo* ImBuildGetCompilationInfo()
+{
+    // Function-local static initialization is thread-safe (engines may run on multiple threads)
+    static const ImBuildInfo build_info = []() { ImBuildInfo info; ImBuildInitCompilationInfo(info); return info; }();
     return &build_info;
 }
 
@@ -904,6 +1026,7 @@ bool ImBuildFindGitBranchName(const char* git_repo_path, Str* branch_name)
 // - ImOsOpenInShell()
 // - ImOsConsoleSetTextColor()
 // - ImOsIsDebuggerPresent()
+// - ImOsGetCurrentProcessId()
 //-----------------------------------------------------------------------------
 
 bool    ImOsCreateProcess(const char* cmd_line)
@@ -1080,6 +1203,15 @@ bool    ImOsIsDebuggerPresent()
 #endif
 }
 
+int     ImOsGetCurrentProcessId()
+{
+#ifdef _WIN32
+    return (int)::GetCurrentProcessId();
+#else
+    return (int)getpid();
+#endif
+}
+
 void    ImOsOutputDebugString(const char* message)
 {
 #ifdef _WIN32
@@ -1326,7 +1458,19 @@ bool ImGuiCsvParser::Load(const char* filename)
     _Data = (char*)ImFileLoadToMemory(filename, "rb", &len, 1);
     if (_Data == nullptr)
         return false;
+    return _Parse(filename, len);
+}
 
+bool ImGuiCsvParser::LoadFromMemory(const char* data, size_t data_size)
+{
+    _Data = (char*)IM_ALLOC(data_size + 1);
+    memcpy(_Data, data, data_size);
+    _Data[data_size] = 0;
+    return _Parse("<memory>", data_size);
+}
+
+bool ImGuiCsvParser::_Parse(const char* filename, size_t len)
+{
     int columns = 1;
     if (Columns > 0)
     {
@@ -1360,7 +1504,8 @@ bool ImGuiCsvParser::Load(const char* filename)
         const bool is_eof = (*c == '\0');
         if (is_comma || is_eol || is_eof)
         {
-            _Index[Rows * columns + col] = col_data;
+            if (col < columns)
+                _Index[Rows * columns + col] = col_data;
             col_data = c + 1;
             if (is_comma)
             {
@@ -1368,10 +1513,16 @@ bool ImGuiCsvParser::Load(const char* filename)
             }
             else
             {
-                if (col + 1 == columns)
+                if (col + 1 == columns || (ColumnsMin > 0 && col + 1 >= ColumnsMin))
+                {
+                    for (int missing_col = col + 1; missing_col < columns; missing_col++)
+                        _Index[Rows * columns + missing_col] = c; // Empty string (*c is zeroed below)
                     Rows++;
+                }
                 else
+                {
                     fprintf(stderr, "%s: Unexpected number of columns on line %d, ignoring.\n", filename, Rows + 1); // FIXME
+                }
                 col = 0;
             }
             *c = 0;
@@ -1386,3 +1537,316 @@ bool ImGuiCsvParser::Load(const char* filename)
 }
 
 //-----------------------------------------------------------------------------
+// Statistics
+//-----------------------------------------------------------------------------
+
+static int IMGUI_CDECL ImStatsCompareDouble(const void* lhs, const void* rhs)
+{
+    const double a = *(const double*)lhs;
+    const double b = *(const double*)rhs;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+double ImStatsCalcPercentile(const double* sorted_samples, int count, double percentile)
+{
+    if (count <= 0)
+        return 0.0;
+    const double rank = ImClamp(percentile, 0.0, 100.0) / 100.0 * (count - 1);
+    const int rank_lo = (int)rank;
+    const int rank_hi = ImMin(rank_lo + 1, count - 1);
+    return sorted_samples[rank_lo] + (sorted_samples[rank_hi] - sorted_samples[rank_lo]) * (rank - rank_lo);
+}
+
+void ImStatsCalcSummary(double* samples, int count, ImStatsSummary* out, double outlier_threshold)
+{
+    *out = ImStatsSummary();
+    if (count <= 0)
+        return;
+
+    ImQsort(samples, (size_t)count, sizeof(double), ImStatsCompareDouble);
+    out->Count = count;
+    out->Min = samples[0];
+    out->Max = samples[count - 1];
+    out->Median = ImStatsCalcPercentile(samples, count, 50.0);
+    out->P90 = ImStatsCalcPercentile(samples, count, 90.0);
+    out->P99 = ImStatsCalcPercentile(samples, count, 99.0);
+
+    // Median absolute deviation
+    ImVector<double> deviations;
+    deviations.resize(count);
+    for (int n = 0; n < count; n++)
+        deviations[n] = fabs(samples[n] - out->Median);
+    ImQsort(deviations.Data, (size_t)count, sizeof(double), ImStatsCompareDouble);
+    out->MAD = ImStatsCalcPercentile(deviations.Data, count, 50.0);
+
+    // Mean and standard deviation of inliers
+    const double inlier_max_deviation = (out->MAD > 0.0) ? outlier_threshold * out->MAD / 0.6745 : DBL_MAX;
+    double sum = 0.0;
+    int inliers = 0;
+    for (int n = 0; n < count; n++)
+        if (fabs(samples[n] - out->Median) <= inlier_max_deviation)
+        {
+            sum += samples[n];
+            inliers++;
+        }
+    out->OutlierCount = count - inliers;
+    out->Mean = sum / inliers;
+
+    double sum_sq = 0.0;
+    for (int n = 0; n < count; n++)
+        if (fabs(samples[n] - out->Median) <= inlier_max_deviation)
+            sum_sq += (samples[n] - out->Mean) * (samples[n] - out->Mean);
+    out->StdDev = (inliers > 1) ? sqrt(sum_sq / (inliers - 1)) : 0.0;
+    out->CI95 = 1.96 * out->StdDev / sqrt((double)inliers);
+}
+
+struct ImStatsRankedSample
+{
+    double  Value;
+    bool    FromA;
+};
+
+static int IMGUI_CDECL ImStatsCompareRankedSample(const void* lhs, const void* rhs)
+{
+    const double a = ((const ImStatsRankedSample*)lhs)->Value;
+    const double b = ((const ImStatsRankedSample*)rhs)->Value;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+double ImStatsMannWhitneyU(const double* a, int count_a, const double* b, int count_b, double* out_rank_biserial)
+{
+    if (out_rank_biserial)
+        *out_rank_biserial = 0.0;
+    if (count_a <= 0 || count_b <= 0)
+        return 1.0;
+
+    const int count = count_a + count_b;
+    ImVector<ImStatsRankedSample> samples;
+    samples.resize(count);
+    for (int n = 0; n < count; n++)
+        samples[n] = (n < count_a) ? ImStatsRankedSample{ a[n], true } : ImStatsRankedSample{ b[n - count_a], false };
+    ImQsort(samples.Data, (size_t)count, sizeof(ImStatsRankedSample), ImStatsCompareRankedSample);
+
+    // Sum ranks of 'a' (tied samples share their average rank)
+    double rank_sum_a = 0.0;
+    double ties_sum = 0.0;
+    for (int n = 0; n < count; )
+    {
+        int n_end = n + 1;
+        while (n_end < count && samples[n_end].Value == samples[n].Value)
+            n_end++;
+        const double rank = (n + 1 + n_end) * 0.5;
+        for (int i = n; i < n_end; i++)
+            if (samples[i].FromA)
+                rank_sum_a += rank;
+        const double ties = n_end - n;
+        ties_sum += ties * ties * ties - ties;
+        n = n_end;
+    }
+
+    const double u_a = rank_sum_a - count_a * (count_a + 1) * 0.5;
+    const double u_mean = count_a * (double)count_b * 0.5;
+    const double u_variance = count_a * (double)count_b / 12.0 * ((count + 1) - ties_sum / (count * (count - 1.0)));
+    if (out_rank_biserial)
+        *out_rank_biserial = u_a / u_mean - 1.0;
+    if (u_variance <= 0.0)
+        return 1.0;     // All samples are equal
+    const double z = (u_a - u_mean - 0.5) / sqrt(u_variance);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+//-----------------------------------------------------------------------------
+// Hardware performance counters
+//-----------------------------------------------------------------------------
+
+bool ImPerfCounterGroup::Open()
+{
+    Close();
+#if defined(__linux__)
+    static const ImU64 configs[ImPerfCounter_COUNT] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+    for (int n = 0; n < ImPerfCounter_COUNT; n++)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[n];
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        // pid == 0, cpu == -1: calling thread on any CPU. First counter is the group leader.
+        Fds[n] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, (n == 0) ? -1 : Fds[0], 0);
+        if (Fds[n] == -1)
+        {
+            Close();
+            return false;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ImPerfCounterGroup::Close()
+{
+#if defined(__linux__)
+    for (int n = ImPerfCounter_COUNT - 1; n >= 0; n--) // Leader last
+        if (Fds[n] != -1)
+            close(Fds[n]);
+#endif
+    for (int& fd : Fds)
+        fd = -1;
+}
+
+bool ImPerfCounterGroup::Read(ImU64 out_values[ImPerfCounter_COUNT]) const
+{
+#if defined(__linux__)
+    if (!IsOpen())
+        return false;
+
+    // PERF_FORMAT_GROUP layout: { nr, time_enabled, time_running, values[nr] }
+    ImU64 data[3 + ImPerfCounter_COUNT];
+    if (read(Fds[0], data, sizeof(data)) != (ssize_t)sizeof(data) || data[0] != ImPerfCounter_COUNT)
+        return false;
+    const ImU64 time_enabled = data[1];
+    const ImU64 time_running = data[2];
+    for (int n = 0; n < ImPerfCounter_COUNT; n++)
+        out_values[n] = (time_running > 0 && time_running < time_enabled) ? (ImU64)((double)data[3 + n] * time_enabled / time_running) : data[3 + n];
+    return true;
+#else
+    IM_UNUSED(out_values);
+    return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Arena (bump) allocator
+//-----------------------------------------------------------------------------
+
+struct ImGuiTestArenaChunk
+{
+    ImGuiTestArenaChunk*    Next;
+    size_t                  Size;                       // Usable size (following this header)
+    size_t                  Used;
+    unsigned char*          GetData()                   { return (unsigned char*)(this + 1); }
+};
+
+static size_t ImGuiTestArenaChunk_GetAlignedOffset(ImGuiTestArenaChunk* chunk, size_t align)
+{
+    const uintptr_t base = (uintptr_t)chunk->GetData();
+    return (size_t)(((base + chunk->Used + (align - 1)) & ~(uintptr_t)(align - 1)) - base);
+}
+
+void* ImGuiTestArena::Alloc(size_t size, size_t align)
+{
+    IM_ASSERT(align > 0 && (align & (align - 1)) == 0);
+
+    ImGuiTestArenaChunk* chunk = _ChunkCurrent;
+    size_t offset = chunk ? ImGuiTestArenaChunk_GetAlignedOffset(chunk, align) : 0;
+    if (chunk == nullptr || offset + size > chunk->Size)
+    {
+        // Move on to next chunk retained from a previous Reset(), if large enough
+        ImGuiTestArenaChunk* next = chunk ? chunk->Next : _ChunkFirst;
+        if (next != nullptr && next->Size >= size + align)
+        {
+            chunk = next;
+            chunk->Used = 0;
+        }
+        else
+        {
+            // Allocate a new chunk, inserted after the current one so retained chunks stay reachable
+            const size_t chunk_size = (size + align > _ChunkSize) ? size + align : _ChunkSize;
+            chunk = (ImGuiTestArenaChunk*)IM_ALLOC(sizeof(ImGuiTestArenaChunk) + chunk_size);
+            chunk->Size = chunk_size;
+            chunk->Used = 0;
+            ImGuiTestArenaChunk** p_link = _ChunkCurrent ? &_ChunkCurrent->Next : &_ChunkFirst;
+            chunk->Next = *p_link;
+            *p_link = chunk;
+            ChunkAllocCount++;
+        }
+        offset = ImGuiTestArenaChunk_GetAlignedOffset(chunk, align);
+    }
+
+    _UsedBytes += (offset - chunk->Used) + size;
+    chunk->Used = offset + size;
+    _ChunkCurrent = chunk;
+    AllocCount++;
+    AllocBytes += size;
+    if (PeakBytes < _UsedBytes)
+        PeakBytes = _UsedBytes;
+    return chunk->GetData() + offset;
+}
+
+void ImGuiTestArena::Reset()
+{
+    _ChunkCurrent = nullptr;
+    _UsedBytes = 0;
+}
+
+void ImGuiTestArena::Clear()
+{
+    for (ImGuiTestArenaChunk* chunk = _ChunkFirst; chunk != nullptr; )
+    {
+        ImGuiTestArenaChunk* next = chunk->Next;
+        IM_FREE(chunk);
+        chunk = next;
+    }
+    _ChunkFirst = _ChunkCurrent = nullptr;
+    _UsedBytes = 0;
+}
+
+void ImGuiTestArena::Trim()
+{
+    IM_ASSERT(_ChunkCurrent == nullptr && _UsedBytes == 0);
+    for (ImGuiTestArenaChunk** p_link = &_ChunkFirst; *p_link != nullptr; )
+    {
+        ImGuiTestArenaChunk* chunk = *p_link;
+        if (chunk->Size > _ChunkSize)
+        {
+            *p_link = chunk->Next;
+            IM_FREE(chunk);
+        }
+        else
+        {
+            p_link = &chunk->Next;
+        }
+    }
+}
+
+ImGuiTestArenaMarker ImGuiTestArena::GetMarker() const
+{
+    ImGuiTestArenaMarker marker;
+    marker.Chunk = _ChunkCurrent;
+    marker.Offset = _ChunkCurrent ? _ChunkCurrent->Used : 0;
+    marker.UsedBytes = _UsedBytes;
+    return marker;
+}
+
+void ImGuiTestArena::ResetToMarker(const ImGuiTestArenaMarker& marker)
+{
+    IM_ASSERT(marker.UsedBytes <= _UsedBytes);
+    _ChunkCurrent = marker.Chunk;
+    if (_ChunkCurrent != nullptr)
+        _ChunkCurrent->Used = marker.Offset;
+    _UsedBytes = marker.UsedBytes;
+}
+
+size_t ImGuiTestArena::GetReservedBytes() const
+{
+    size_t total = 0;
+    for (ImGuiTestArenaChunk* chunk = _ChunkFirst; chunk != nullptr; chunk = chunk->Next)
+        total += chunk->Size;
+    return total;
+}
+
+bool ImGuiTestArena::Contains(const void* p) const
+{
+    for (ImGuiTestArenaChunk* chunk = _ChunkFirst; chunk != nullptr; chunk = chunk->Next)
+        if ((const unsigned char*)p >= chunk->GetData() && (const unsigned char*)p < chunk->GetData() + chunk->Size)
+            return true;
+    return false;
+}
+
+//-----------------------------------------------------------------------------
@@ -33,6 +33,21 @@ bool        ImFileCreateDirectoryChain(const char* path, const char* path_end =
 bool        ImFileFindInParents(const char* sub_path, int max_parent_count, Str* output);
 bool        ImFileLoadSourceBlurb(const char* filename, int line_no_start, int line_no_end, ImGuiTextBuffer* out_buf);
 
+// Read-only mapping of a whole file in memory (mmap/MapViewOfFile, falls back to loading the file on other platforms).
+// Data stays valid until Close() or destruction.
+struct ImFileMapping
+{
+    const char*     Data = nullptr;
+    size_t          Size = 0;
+    void*           _Handle = nullptr;              // Win32 file mapping handle
+    bool            _IsMapped = false;              // false when Data was allocated by ImFileLoadToMemory()
+
+    ImFileMapping() {}
+    ~ImFileMapping()                                { Close(); }
+    bool            Open(const char* filename);     // Return false if file can't be opened. Empty files are successfully opened with Data == nullptr.
+    void            Close();
+};
+
 //-----------------------------------------------------------------------------
 // Path Helpers
 //-----------------------------------------------------------------------------
@@ -71,6 +86,7 @@ void        ImTimestampToISO8601(uint64_t timestamp, Str* out_date);
 
 void        ImThreadSleepInMilliseconds(int ms);
 void        ImThreadSetCurrentThreadDescription(const char* description);
+uint64_t    ImThreadGetCpuTimeInNanoseconds();      // CPU time consumed by calling thread. Return 0 if not supported.
 
 //-----------------------------------------------------------------------------
 // Build Info helpers
@@ -116,6 +132,7 @@ FILE*       ImOsPOpen(const char* cmd_line, const char* mode);
 void        ImOsPClose(FILE* fp);
 void        ImOsOpenInShell(const char* path);
 bool        ImOsIsDebuggerPresent();
+int         ImOsGetCurrentProcessId();
 void        ImOsOutputDebugString(const char* message);
 void        ImOsConsoleSetTextColor(ImOsConsoleStream stream, ImOsConsoleTextColor color);
 
@@ -154,6 +171,116 @@ struct ImMovingAverage
     bool    IsFull() const          { return FillAmount == Samples.Size; }
 };
 
+//-----------------------------------------------------------------------------
+// Helper: robust statistics of a set of samples (e.g. frame times)
+//-----------------------------------------------------------------------------
+// - Percentiles are calculated over all samples (linear interpolation between closest ranks).
+// - Outliers are rejected using the median absolute deviation (MAD): samples with a modified z-score
+//   0.6745 * |x - median| / MAD above 'outlier_threshold' (3.5 is the usual choice) are excluded from Mean/StdDev/CI95.
+//   Nothing is rejected when MAD is zero (e.g. all samples equal).
+// - ImStatsMannWhitneyU() is a one-sided Mann-Whitney U test of samples of 'a' tending to be larger than samples of 'b'
+//   (normal approximation with tie and continuity corrections). It returns the p-value. 'out_rank_biserial' is an effect size
+//   in -1.0..+1.0 range: +1.0 when all samples of 'a' are larger than all samples of 'b'.
+//-----------------------------------------------------------------------------
+
+struct ImStatsSummary
+{
+    int             Count = 0;                      // Number of samples
+    int             OutlierCount = 0;               // Number of samples rejected as outliers
+    double          Min = 0.0;
+    double          Max = 0.0;
+    double          Median = 0.0;
+    double          P90 = 0.0;
+    double          P99 = 0.0;
+    double          MAD = 0.0;                      // Median absolute deviation
+    double          Mean = 0.0;                     // Mean of non-outlier samples
+    double          StdDev = 0.0;                   // Standard deviation of non-outlier samples
+    double          CI95 = 0.0;                     // Half-width of the 95% confidence interval of Mean (normal approximation)
+};
+
+void        ImStatsCalcSummary(double* samples, int count, ImStatsSummary* out, double outlier_threshold = 3.5); // Sort 'samples' in place
+double      ImStatsCalcPercentile(const double* sorted_samples, int count, double percentile);                 // 'percentile' in 0.0..100.0 range
+double      ImStatsMannWhitneyU(const double* a, int count_a, const double* b, int count_b, double* out_rank_biserial = nullptr);
+
+//-----------------------------------------------------------------------------
+// Helper: hardware performance counters of calling thread
+//-----------------------------------------------------------------------------
+// - Only implemented on Linux (perf_event_open). Open() returns false elsewhere, or when the kernel refuses
+//   access (e.g. /proc/sys/kernel/perf_event_paranoid, containers, virtual machines without PMU passthrough).
+// - Counters are opened as a single group so they are always scheduled together. Values are scaled when
+//   the kernel had to multiplex them with other counters.
+// - Only user-space events are counted.
+//-----------------------------------------------------------------------------
+
+enum ImPerfCounter
+{
+    ImPerfCounter_Cycles,
+    ImPerfCounter_Instructions,
+    ImPerfCounter_CacheMisses,
+    ImPerfCounter_BranchMisses,
+    ImPerfCounter_COUNT
+};
+
+struct ImPerfCounterGroup
+{
+    int             Fds[ImPerfCounter_COUNT];       // File descriptors, -1 when not opened
+
+    ImPerfCounterGroup()    { for (int& fd : Fds) fd = -1; }
+    ~ImPerfCounterGroup()   { Close(); }
+    bool            Open();                         // Start counting for calling thread. Return false if not supported.
+    void            Close();
+    bool            IsOpen() const                  { return Fds[0] != -1; }
+    bool            Read(ImU64 out_values[ImPerfCounter_COUNT]) const; // Read current values (monotonically increasing)
+};
+
+//-----------------------------------------------------------------------------
+// Helper: Arena (bump) allocator
+//-----------------------------------------------------------------------------
+// - Allocations are never freed individually: call Reset() to release everything in one step.
+// - Chunks are kept across Reset() calls so steady-state usage doesn't hit the heap. Trim() releases oversized ones.
+// - GetMarker()/ResetToMarker() allow rewinding LIFO-style, e.g. for scratch buffers inside a loop.
+// - No destructors are called: caller is responsible for destructing non-trivial types it placed in the arena.
+//-----------------------------------------------------------------------------
+
+struct ImGuiTestArenaChunk;
+
+struct ImGuiTestArenaMarker
+{
+    ImGuiTestArenaChunk*    Chunk = nullptr;
+    size_t                  Offset = 0;
+    size_t                  UsedBytes = 0;
+};
+
+struct ImGuiTestArena
+{
+    // Internal fields
+    ImGuiTestArenaChunk*    _ChunkFirst = nullptr;      // All chunks ever allocated (linked list, kept across Reset())
+    ImGuiTestArenaChunk*    _ChunkCurrent = nullptr;    // Chunk we are currently allocating from
+    size_t                  _ChunkSize = 64 * 1024;     // Default chunk size. Larger allocations get a dedicated chunk.
+    size_t                  _UsedBytes = 0;             // Bytes currently in use (including alignment padding)
+
+    // Counters (reset by ResetCounters())
+    int                     AllocCount = 0;             // Number of Alloc() calls
+    size_t                  AllocBytes = 0;             // Sum of requested sizes
+    size_t                  PeakBytes = 0;              // High-water mark of bytes in use
+    int                     ChunkAllocCount = 0;        // Number of chunks allocated from the heap (this is the malloc traffic we want to see drop)
+
+    // Functions
+    ImGuiTestArena()                                    { }
+    ~ImGuiTestArena()                                   { Clear(); }
+    void*                   Alloc(size_t size, size_t align = 16);
+    template<typename T> T* AllocArray(int count)       { return (T*)Alloc(sizeof(T) * (size_t)count, alignof(T)); }
+    void                    Reset();                    // Release all allocations, keep chunks.
+    void                    Clear();                    // Release all allocations and chunks.
+    void                    Trim();                     // Release chunks dedicated to allocations larger than _ChunkSize. Arena must be empty (e.g. after Reset()).
+    void                    ResetCounters()             { AllocCount = ChunkAllocCount = 0; AllocBytes = PeakBytes = 0; }
+    ImGuiTestArenaMarker    GetMarker() const;
+    void                    ResetToMarker(const ImGuiTestArenaMarker& marker);
+    size_t                  GetUsedBytes() const        { return _UsedBytes; }
+    size_t                  GetReservedBytes() const;
+    bool                    Contains(const void* p) const;
+};
+
 //-----------------------------------------------------------------------------
 // Helper: Simple/dumb CSV parser
 //-----------------------------------------------------------------------------
@@ -162,6 +289,7 @@ struct ImGuiCsvParser
 {
     // Public fields
     int             Columns = 0;                    // Number of columns in CSV file.
+    int             ColumnsMin = -1;                // Minimum number of columns of a valid row, if less than Columns. Missing cells are empty strings. Extra cells are ignored.
     int             Rows = 0;                       // Number of rows in CSV file.
 
     // Internal fields
@@ -172,8 +300,10 @@ struct ImGuiCsvParser
     ImGuiCsvParser(int columns = -1)                { Columns = columns; }
     ~ImGuiCsvParser()                               { Clear(); }
     bool            Load(const char* file_name);    // Open and parse a CSV file.
+    bool            LoadFromMemory(const char* data, size_t data_size); // Parse a copy of CSV data.
     void            Clear();                        // Free allocated buffers.
     const char*     GetCell(int row, int col)       { IM_ASSERT(0 <= row && row < Rows && 0 <= col && col < Columns); return _Index[row * Columns + col]; }
+    bool            _Parse(const char* file_name, size_t data_size); // Parse _Data, which must be zero-terminated.
 };
 
 //-----------------------------------------------------------------------------
@@ -12,6 +12,12 @@
 //   main.exe -nogui -v -nopause            // Run all tests
 //   main.exe -nogui -nopause testname      // Run tests matching "testname"
 //   main.exe -nogui -viewport-mock         // Run with viewport emulation
+//   main.exe -nogui -nopause -skiprender   // Run all tests, skipping rendering when possible
+//   main.exe -nogui -nopause -snapshot     // Run all tests, restoring UI state after each test instead of yielding frames
+//   main.exe -nogui -slow -virtualclock    // Run all tests at normal speed without waiting on wall clock
+//   main.exe -nogui -nopause -deferredlog  // Run all tests, only formatting log messages of tests which need displaying them
+//   main.exe -nogui -schedule failed       // Run all tests, tests which failed on previous run first
+//   main.exe -nogui -changed-since HEAD~1  // Run tests affected by changes since given git revision
 
 // Examples
 #define CMDLINE_ARGS    ""
@@ -48,9 +54,12 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "imgui.h"
 #include <stdio.h>
+#include <stdlib.h>     // strtol(), bsearch()
+#include <limits.h>     // INT_MAX
 #include "imgui_test_suite.h"
 #include "imgui_test_engine/imgui_te_engine.h"
 #include "imgui_test_engine/imgui_te_exporters.h"
+#include "imgui_test_engine/imgui_te_perftool.h"
 #include "imgui_test_engine/imgui_te_coroutine.h"
 #include "imgui_test_engine/imgui_te_utils.h"
 #include "imgui_test_engine/imgui_te_ui.h"
@@ -79,6 +88,10 @@ static void TestSuite_PrintCommandLineHelp();
 static bool TestSuite_ParseCommandLineOptions(TestSuiteApp* app, int argc, char** argv);
 static void TestSuite_QueueTests(TestSuiteApp* app, ImGuiTestRunFlags run_flags);
 static void TestSuite_LoadFonts(float dpi_scale);
+static bool TestSuite_RunJobs(TestSuiteApp* app);
+static void TestSuite_FilterQueueByChanges(TestSuiteApp* app, const char* rev);
+static void TestSuite_CoverageUpdate(TestSuiteApp* app);
+static void TestSuite_CoverageSave(TestSuiteApp* app);
 
 //-------------------------------------------------------------------------
 // Test Application
@@ -86,6 +99,17 @@ static void TestSuite_LoadFonts(float dpi_scale);
 
 struct ImGuiApp;
 
+// Per-test durations/status of previous runs, used by -schedule and -jobs
+#define TEST_SUITE_TIMING_HISTORY_FILENAME  "output/imgui_test_suite_history.bin"
+
+// Functions called while running a test (-record-coverage)
+struct TestSuiteCoverageRecord
+{
+    ImGuiTest*                  Test;
+    int                         AddrOffset;                 // Index into TestSuiteApp::CoverageAddrs[]
+    int                         AddrCount;
+};
+
 struct TestSuiteApp
 {
     // Main State
@@ -102,15 +126,40 @@ struct TestSuiteApp
     ImGuiTestVerboseLevel       OptVerboseLevelBasic = ImGuiTestVerboseLevel_COUNT; // Default is set in main.cpp depending on -gui/-nogui
     ImGuiTestVerboseLevel       OptVerboseLevelError = ImGuiTestVerboseLevel_COUNT; // "
     bool                        OptNoThrottle = false;
+    bool                        OptSkipRender = false;
+    bool                        OptUiContextSnapshot = false;
+    bool                        OptVirtualClock = false;
+    bool                        OptLogDeferredFormatting = false;
+    bool                        OptLogAsyncOutput = false;
+    bool                        OptPerfCounters = false;
     bool                        OptPauseOnExit = true;
     bool                        OptViewports = false;
     bool                        OptMockViewports = false;
     bool                        OptCaptureEnabled = true;
     int                         OptStressAmount = 5;
+    int                         OptJobs = 1;
+    ImGuiTestSchedulePolicy     OptSchedulePolicy = ImGuiTestSchedulePolicy_None;
+    Str64                       OptChangedSince;
+    Str256                      OptPerfLogConvertSrc;
+    Str256                      OptPerfLogConvertDst;
+    bool                        OptPerfCheck = false;
+    int                         OptPerfCheckWindow = 5;
+    float                       OptPerfCheckMinDelta = 5.0f;
+    bool                        OptRecordCoverage = false;
     Str128                      OptSourceFileOpener;
     Str128                      OptExportFilename;
     ImGuiTestEngineExportFormat OptExportFormat = ImGuiTestEngineExportFormat_JUnitXml;
     ImVector<char*>             TestsToRun;
+
+    // Parallel jobs
+    FILE*                       JobsWorkerResultsFile = nullptr;    // Set in worker processes
+    ImVector<int>               JobsWorkerPendingTests;             // Indices (in test list) of worker tests whose results were not written yet
+
+    // Coverage recording
+    ImVector<ImGuiTest*>        CoverageTestList;
+    ImGuiTest*                  CoverageTest = nullptr;             // Test currently being recorded
+    ImVector<TestSuiteCoverageRecord> CoverageRecords;
+    ImVector<void*>             CoverageAddrs;
 };
 
 static void TestSuite_ShowUI(TestSuiteApp* app)
@@ -169,10 +218,24 @@ static void TestSuite_PrintCommandLineHelp()
     printf("  -guifunc                 : run test GuiFunc only (no TestFunc).\n");
     printf("  -slow                    : run automation at feeble human speed.\n");
     printf("  -nothrottle              : run GUI app without throttling/vsync by default.\n");
+    printf("  -skiprender              : skip rendering of frames which don't need rendered output (requires -nogui).\n");
+    printf("  -snapshot                : restore windows/focus/popups state after each test instead of waiting 2 frames (waits 1).\n");
+    printf("  -virtualclock            : with -slow: use a virtual clock (60 FPS), running as fast as possible with same timing on all machines.\n");
+    printf("  -deferredlog             : record log messages which are not printed as format string + arguments, format them only when needed.\n");
+    printf("  -asynclog                : write log output to console/debugger from a background thread.\n");
+    printf("  -perfcounters            : perf tests also record CPU time and hardware counters (Linux) of GuiFunc + Render.\n");
     printf("  -nopause                 : don't pause application on exit.\n");
     printf("  -nocapture               : don't capture any images or video.\n");
     printf("  -stressamount <int>      : set performance test duration multiplier (default: 5)\n");
+    printf("  -jobs <int>              : run tests in <int> parallel worker processes (requires -nogui).\n");
+    printf("  -schedule <policy>       : order queued tests using durations/status of previous runs: longest, shortest, failed.\n");
+    printf("  -changed-since <rev>     : only run queued tests affected by changes since git revision <rev> (e.g. HEAD~1, origin/master).\n");
+    printf("  -record-coverage         : record imgui functions called by each test, used by -changed-since (requires 'make IMGUI_COVERAGE=1').\n");
     printf("  -fileopener <file>       : provide a bat/cmd/shell script to open source file (default to open with shell).\n");
+    printf("  -perflog-convert <a> <b> : convert perf log <a> to <b> (.csv or binary, by extension) and exit. Use <a> == <b> to compact a binary log.\n");
+    printf("  -perf-check              : check perf log for regressions of latest runs against previous runs, and exit. Report is saved with -export-file (.json, or JUnit).\n");
+    printf("  -perf-check-window <int> : number of latest runs compared with as many previous runs (default: 5).\n");
+    printf("  -perf-check-delta <%%>    : minimum slowdown of median to report a regression, in percent (default: 5).\n");
     printf("  -export-file <file>      : save test run results in specified file.\n");
     printf("  -export-format <format>  : save test run results in specified format. (default: junit)\n");
     printf("  -list                    : list queued tests (one per line) and exit.\n");
@@ -218,6 +281,12 @@ static bool TestSuite_ParseCommandLineOptions(TestSuiteApp* app, int argc, char*
         else if (strcmp(argv[n], "-fast") == 0)         { app->OptRunSpeed = ImGuiTestRunSpeed_Fast; app->OptNoThrottle = true; }
         else if (strcmp(argv[n], "-slow") == 0)         { app->OptRunSpeed = ImGuiTestRunSpeed_Normal; app->OptNoThrottle = false; }
         else if (strcmp(argv[n], "-nothrottle") == 0)   { app->OptNoThrottle = true; }
+        else if (strcmp(argv[n], "-skiprender") == 0)   { app->OptSkipRender = true; }
+        else if (strcmp(argv[n], "-snapshot") == 0)     { app->OptUiContextSnapshot = true; }
+        else if (strcmp(argv[n], "-virtualclock") == 0) { app->OptVirtualClock = true; }
+        else if (strcmp(argv[n], "-deferredlog") == 0)  { app->OptLogDeferredFormatting = true; }
+        else if (strcmp(argv[n], "-asynclog") == 0)     { app->OptLogAsyncOutput = true; }
+        else if (strcmp(argv[n], "-perfcounters") == 0) { app->OptPerfCounters = true; }
         else if (strcmp(argv[n], "-nopause") == 0)      { app->OptPauseOnExit = false; }
         else if (strcmp(argv[n], "-nocapture") == 0)    { app->OptCaptureEnabled = false; }
         else if (strcmp(argv[n], "-viewport") == 0)     { app->OptViewports = true; }
@@ -227,6 +296,54 @@ static bool TestSuite_ParseCommandLineOptions(TestSuiteApp* app, int argc, char*
             app->OptStressAmount = atoi(argv[n + 1]);
             n++;
         }
+        else if (strcmp(argv[n], "-jobs") == 0 && n + 1 < argc)
+        {
+            app->OptJobs = ImMax(atoi(argv[n + 1]), 1);
+            n++;
+        }
+        else if (strcmp(argv[n], "-schedule") == 0 && n + 1 < argc)
+        {
+            if (strcmp(argv[n + 1], "longest") == 0)
+                app->OptSchedulePolicy = ImGuiTestSchedulePolicy_LongestFirst;
+            else if (strcmp(argv[n + 1], "shortest") == 0)
+                app->OptSchedulePolicy = ImGuiTestSchedulePolicy_ShortestFirst;
+            else if (strcmp(argv[n + 1], "failed") == 0)
+                app->OptSchedulePolicy = ImGuiTestSchedulePolicy_FailedFirst;
+            else
+                fprintf(stderr, "Unknown value '%s' passed to '-schedule'. Possible values: longest, shortest, failed.\n", argv[n + 1]);
+            n++;
+        }
+        else if (strcmp(argv[n], "-changed-since") == 0 && n + 1 < argc)
+        {
+            app->OptChangedSince = argv[n + 1];
+            n++;
+        }
+        else if (strcmp(argv[n], "-record-coverage") == 0)
+        {
+#if IMGUI_TEST_SUITE_ENABLE_COVERAGE
+            app->OptRecordCoverage = true;
+#else
+            fprintf(stderr, "-record-coverage requires building with IMGUI_TEST_SUITE_ENABLE_COVERAGE (e.g. 'make IMGUI_COVERAGE=1').\n");
+            return false;
+#endif
+        }
+        else if (strcmp(argv[n], "-perflog-convert") == 0 && n + 2 < argc)
+        {
+            app->OptPerfLogConvertSrc = argv[n + 1];
+            app->OptPerfLogConvertDst = argv[n + 2];
+            n += 2;
+        }
+        else if (strcmp(argv[n], "-perf-check") == 0)   { app->OptPerfCheck = true; }
+        else if (strcmp(argv[n], "-perf-check-window") == 0 && n + 1 < argc)
+        {
+            app->OptPerfCheckWindow = ImMax(atoi(argv[n + 1]), 2);
+            n++;
+        }
+        else if (strcmp(argv[n], "-perf-check-delta") == 0 && n + 1 < argc)
+        {
+            app->OptPerfCheckMinDelta = (float)atof(argv[n + 1]);
+            n++;
+        }
         else if (strcmp(argv[n], "-fileopener") == 0 && n + 1 < argc)
         {
             app->OptSourceFileOpener = argv[n + 1];
@@ -331,7 +448,7 @@ static void TestSuite_LoadFonts(float dpi_scale)
 static void TestSuite_QueueTests(TestSuiteApp* app, ImGuiTestRunFlags run_flags)
 {
     // Non-interactive mode queue all tests by default
-    if (!app->OptGui && app->TestsToRun.empty())
+    if ((!app->OptGui || !app->OptChangedSince.empty()) && app->TestsToRun.empty())
         app->TestsToRun.push_back(strdup("tests"));
 
     // Special groups are supported by ImGuiTestEngine_QueueTests(): "all", "tests", "perfs"
@@ -372,6 +489,937 @@ static void FindVideoEncoder(char* out, int out_len)
         *out = 0;
 }
 
+//-------------------------------------------------------------------------
+// Parallel Jobs (-jobs N)
+//-------------------------------------------------------------------------
+// - Main process forks N worker processes after tests are queued and before ImGuiTestEngine_Start().
+// - Queue is partitioned using durations from the engine timing history (greedy: longest test goes to least loaded worker).
+// - Workers run their share and send back test outputs + console output, which are merged into main process engine,
+//   so result summary and export (e.g. JUnit) are the same as with a single process run.
+// - Only supported with -nogui (null backend) on POSIX systems.
+//-------------------------------------------------------------------------
+
+#ifndef _WIN32
+#include <unistd.h>     // fork(), dup2()
+#include <sys/wait.h>   // waitpid()
+
+struct TestSuiteJob
+{
+    pid_t                       Pid = -1;
+    FILE*                       ResultsFile = nullptr;      // Written by worker, read by main process
+    FILE*                       ConsoleFile = nullptr;      // Worker stdout/stderr
+    double                      PredictedDuration = 0.0;
+    ImVector<ImGuiTestRunTask>  Tasks;
+};
+
+// Called in worker process after every frame. Write outputs of tests which ended since last call, so the main process
+// still gets results of completed tests if the worker crashes later on.
+static void TestSuite_JobWriteResults(TestSuiteApp* app)
+{
+    FILE* f = app->JobsWorkerResultsFile;
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(app->TestEngine, &tests);
+    bool written = false;
+    for (int pending_n = 0; pending_n < app->JobsWorkerPendingTests.Size; pending_n++)
+    {
+        int test_n = app->JobsWorkerPendingTests[pending_n];
+        ImGuiTestOutput* output = &tests[test_n]->Output;
+        if (output->Status != ImGuiTestStatus_Success && output->Status != ImGuiTestStatus_Error)
+            continue;
+        output->Log.FlushDeferred();
+        const int buf_size = output->Log.Buffer.size();
+        fwrite(&test_n, sizeof(int), 1, f);
+        fwrite(&output->Status, sizeof(output->Status), 1, f);
+        fwrite(&output->StartTime, sizeof(ImU64), 1, f);
+        fwrite(&output->EndTime, sizeof(ImU64), 1, f);
+        fwrite(&buf_size, sizeof(int), 1, f);
+        fwrite(output->Log.Buffer.c_str(), 1, (size_t)buf_size, f);
+        fwrite(&output->Log.LineInfo.Size, sizeof(int), 1, f);
+        fwrite(output->Log.LineInfo.Data, sizeof(ImGuiTestLogLineInfo), (size_t)output->Log.LineInfo.Size, f);
+        fwrite(output->Log.CountPerLevel, sizeof(output->Log.CountPerLevel), 1, f);
+        app->JobsWorkerPendingTests.erase(app->JobsWorkerPendingTests.Data + pending_n);
+        pending_n--;
+        written = true;
+    }
+    if (written)
+        fflush(f);
+}
+
+// Called in main process. Merge outputs written by a worker, return number of test outputs read.
+static int TestSuite_JobReadResults(ImGuiTestEngine* engine, FILE* f)
+{
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(engine, &tests);
+    fseek(f, 0, SEEK_SET);
+
+    int count = 0;
+    int test_n = 0;
+    ImVector<char> buf;
+    while (fread(&test_n, sizeof(int), 1, f) == 1)
+    {
+        ImGuiTestOutput output;
+        int buf_size = 0;
+        int line_count = 0;
+        bool ok = true;
+        ok &= fread(&output.Status, sizeof(output.Status), 1, f) == 1;
+        ok &= fread(&output.StartTime, sizeof(ImU64), 1, f) == 1;
+        ok &= fread(&output.EndTime, sizeof(ImU64), 1, f) == 1;
+        ok &= fread(&buf_size, sizeof(int), 1, f) == 1 && buf_size >= 0;
+        if (ok)
+        {
+            buf.resize(buf_size);
+            ok &= fread(buf.Data, 1, (size_t)buf_size, f) == (size_t)buf_size;
+            output.Log.Buffer.append(buf.begin(), buf.end());
+        }
+        ok &= fread(&line_count, sizeof(int), 1, f) == 1 && line_count >= 0;
+        if (ok)
+        {
+            output.Log.LineInfo.resize(line_count);
+            ok &= fread(output.Log.LineInfo.Data, sizeof(ImGuiTestLogLineInfo), (size_t)line_count, f) == (size_t)line_count;
+        }
+        ok &= fread(output.Log.CountPerLevel, sizeof(output.Log.CountPerLevel), 1, f) == 1;
+        if (!ok || test_n < 0 || test_n >= tests.Size)
+        {
+            fprintf(stderr, "Error reading worker results.\n");
+            break;
+        }
+        ImGuiTestEngine_MergeTestOutput(engine, tests[test_n], &output);
+        count++;
+    }
+    return count;
+}
+
+// Return true in main process (after all workers are done and results are merged), false in worker processes.
+static bool TestSuite_RunJobs(TestSuiteApp* app)
+{
+    ImGuiTestEngine* engine = app->TestEngine;
+    ImVector<ImGuiTestRunTask> queue;
+    float predicted_total = 0.0f;
+    ImGuiTestEngine_GetTestQueue(engine, &queue, &predicted_total);
+    const int jobs_count = ImMin(app->OptJobs, queue.Size);
+    if (jobs_count <= 1)
+        return false;
+
+    // Partition queue, longest tests first. Tests without history use the average.
+    double duration_default = (predicted_total > 0.0f) ? (double)predicted_total / queue.Size : 1.0;
+    struct QueueEntry { int Index; double Duration; };
+    ImVector<QueueEntry> entries;
+    for (int n = 0; n < queue.Size; n++)
+        entries.push_back({ n, queue[n].PredictedDuration >= 0.0f ? (double)queue[n].PredictedDuration : duration_default });
+    qsort(entries.Data, (size_t)entries.Size, sizeof(QueueEntry), [](const void* lhs, const void* rhs)
+    {
+        const QueueEntry* a = (const QueueEntry*)lhs;
+        const QueueEntry* b = (const QueueEntry*)rhs;
+        if (a->Duration != b->Duration)
+            return (a->Duration > b->Duration) ? -1 : +1;
+        return a->Index - b->Index;
+    });
+
+    ImVector<TestSuiteJob*> jobs;
+    for (int job_n = 0; job_n < jobs_count; job_n++)
+        jobs.push_back(IM_NEW(TestSuiteJob)());
+    ImVector<int> queue_job_index;
+    queue_job_index.resize(queue.Size);
+    for (QueueEntry& entry : entries)
+    {
+        int job_n = 0;
+        for (int other_job_n = 1; other_job_n < jobs.Size; other_job_n++)
+            if (jobs[other_job_n]->PredictedDuration < jobs[job_n]->PredictedDuration)
+                job_n = other_job_n;
+        jobs[job_n]->PredictedDuration += entry.Duration;
+        queue_job_index[entry.Index] = job_n;
+    }
+    for (int n = 0; n < queue.Size; n++) // Keep queue order within each job
+        jobs[queue_job_index[n]]->Tasks.push_back(queue[n]);
+
+    // Workers only append to .csv perf log, main process imports their entries into binary perf log once they are done
+    bool has_perf_tests = false;
+    for (ImGuiTestRunTask& run_task : queue)
+        if (run_task.Test->Group == ImGuiTestGroup_Perfs)
+            has_perf_tests = true;
+
+    // Fork workers
+    printf("Running %d tests in %d jobs...\n", queue.Size, jobs_count);
+    ImGuiTestEngine_ClearTestQueue(engine);
+    fflush(stdout);
+    fflush(stderr);
+    for (int job_n = 0; job_n < jobs.Size; job_n++)
+    {
+        TestSuiteJob* job = jobs[job_n];
+        job->ResultsFile = tmpfile();
+        job->ConsoleFile = tmpfile();
+        if (job->ResultsFile == nullptr || job->ConsoleFile == nullptr || (job->Pid = fork()) < 0)
+        {
+            fprintf(stderr, "Error creating worker process, running remaining tests in main process.\n");
+            for (int remaining_job_n = job_n; remaining_job_n < jobs.Size; remaining_job_n++)
+            {
+                for (ImGuiTestRunTask& run_task : jobs[remaining_job_n]->Tasks)
+                    ImGuiTestEngine_QueueTest(engine, run_task.Test, run_task.RunFlags);
+                if (jobs[remaining_job_n]->ResultsFile)
+                    fclose(jobs[remaining_job_n]->ResultsFile);
+                if (jobs[remaining_job_n]->ConsoleFile)
+                    fclose(jobs[remaining_job_n]->ConsoleFile);
+                IM_DELETE(jobs[remaining_job_n]);
+            }
+            jobs.resize(job_n);
+            break;
+        }
+        if (job->Pid == 0)
+        {
+            // Worker process: queue our share and let main() run it
+            dup2(fileno(job->ConsoleFile), STDOUT_FILENO);
+            dup2(fileno(job->ConsoleFile), STDERR_FILENO);
+            ImVector<ImGuiTest*> tests;
+            ImGuiTestEngine_GetTestList(engine, &tests);
+            for (ImGuiTestRunTask& run_task : job->Tasks)
+            {
+                ImGuiTestEngine_QueueTest(engine, run_task.Test, run_task.RunFlags);
+                app->JobsWorkerPendingTests.push_back(tests.index_from_ptr(tests.find(run_task.Test)));
+            }
+            app->JobsWorkerResultsFile = job->ResultsFile;
+            app->OptPauseOnExit = false;
+            ImGui::GetIO().IniFilename = nullptr;       // Main process owns .ini file
+            ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
+            test_io.ExportResultsFormat = ImGuiTestEngineExportFormat_None;
+            test_io.ExportResultsFilename = nullptr;
+            test_io.TimingHistoryFilename = nullptr;    // Main process records history of merged results
+            test_io.ConfigPerfLogUpdateBinary = false;  // Main process imports perf log entries of all workers
+            return false;
+        }
+    }
+
+    // Main process: wait for workers, merge console output and results
+    for (int job_n = 0; job_n < jobs.Size; job_n++)
+    {
+        TestSuiteJob* job = jobs[job_n];
+        int status = 0;
+        waitpid(job->Pid, &status, 0);
+
+        printf("----- Job %d/%d: %d tests, predicted %.1f sec -----\n", job_n + 1, jobs.Size, job->Tasks.Size, job->PredictedDuration);
+        fseek(job->ConsoleFile, 0, SEEK_SET);
+        char line[1024];
+        while (fgets(line, IM_ARRAYSIZE(line), job->ConsoleFile))
+            fputs(line, stdout);
+
+        TestSuite_JobReadResults(engine, job->ResultsFile);
+        if (!WIFEXITED(status))
+            fprintf(stderr, "Job %d/%d exited abnormally (status %d).\n", job_n + 1, jobs.Size, status);
+
+        // Tests without results are reported as errors: the worker crashed or exited while running them, or before reaching them
+        for (ImGuiTestRunTask& run_task : job->Tasks)
+        {
+            ImGuiTestOutput* output = &run_task.Test->Output;
+            if (output->Status != ImGuiTestStatus_Unknown)
+                continue;
+            ImGuiTestOutput error_output;
+            error_output.Status = ImGuiTestStatus_Error;
+            error_output.Log.Buffer.appendf("[%s] Worker process for job %d/%d crashed or exited before this test ended.\n", run_task.Test->Name, job_n + 1, jobs.Size);
+            error_output.Log.UpdateLineOffsets(&ImGuiTestEngine_GetIO(engine), ImGuiTestVerboseLevel_Error, error_output.Log.Buffer.begin());
+            ImGuiTestEngine_MergeTestOutput(engine, run_task.Test, &error_output);
+        }
+        fclose(job->ResultsFile);
+        fclose(job->ConsoleFile);
+        IM_DELETE(job);
+    }
+    if (has_perf_tests)
+        ImGuiTestEngine_PerfToolUpdateBinaryLog();
+    fflush(stdout);
+    return true;
+}
+#else
+static void TestSuite_JobWriteResults(TestSuiteApp*) {}
+static bool TestSuite_RunJobs(TestSuiteApp* app)
+{
+    fprintf(stderr, "-jobs is not supported on this platform, running tests in a single process.\n");
+    app->OptJobs = 1;
+    return false;
+}
+#endif // #ifndef _WIN32
+
+//-------------------------------------------------------------------------
+// Changed Tests (-changed-since <rev>) and Coverage (-record-coverage)
+//-------------------------------------------------------------------------
+// - Diff hunks in test files are mapped to tests using their SourceLine..SourceLineEnd range.
+//   Other source changes in test engine/suite repository (helpers, test engine itself) queue all tests.
+// - Diff hunks in imgui/*.cpp are mapped to their enclosing function, then to tests which called this function
+//   during a previous run recorded with -record-coverage (requires building with 'make IMGUI_COVERAGE=1').
+//   Changes to imgui/*.h cannot be mapped and queue all tests.
+// - <rev> is used for both repositories. If it doesn't exist in imgui repository, only uncommitted changes are used there.
+//-------------------------------------------------------------------------
+
+#define TEST_SUITE_COVERAGE_FILENAME    "imgui_test_suite_coverage.txt"
+
+// Coverage database: for each test, list of imgui core functions called while it was running.
+// Text file, one "F<TAB>function" line per function followed by one "T<TAB>category<TAB>name<TAB>indices..." line per test.
+struct TestSuiteCoverageDbTest
+{
+    char*                       Category;
+    char*                       Name;
+    int                         FuncsOffset;                // Index into TestSuiteCoverageDb::TestsFuncs[]
+    int                         FuncsCount;
+};
+
+struct TestSuiteCoverageDb
+{
+    ImVector<char*>                     Funcs;
+    ImGuiStorage                        FuncsMap;           // Hash of function name -> index + 1
+    ImVector<TestSuiteCoverageDbTest>   Tests;
+    ImVector<int>                       TestsFuncs;
+
+    ~TestSuiteCoverageDb()
+    {
+        for (char* func : Funcs)
+            IM_FREE(func);
+        for (TestSuiteCoverageDbTest& test : Tests)
+        {
+            IM_FREE(test.Category);
+            IM_FREE(test.Name);
+        }
+    }
+
+    int AddFunc(const char* name)
+    {
+        const ImGuiID name_id = ImHashStr(name);
+        if (int idx = FuncsMap.GetInt(name_id, 0))
+            return idx - 1;
+        Funcs.push_back(ImStrdup(name));
+        FuncsMap.SetInt(name_id, Funcs.Size);
+        return Funcs.Size - 1;
+    }
+
+    TestSuiteCoverageDbTest* AddTest(const char* category, const char* name)
+    {
+        TestSuiteCoverageDbTest test;
+        test.Category = ImStrdup(category);
+        test.Name = ImStrdup(name);
+        test.FuncsOffset = TestsFuncs.Size;
+        test.FuncsCount = 0;
+        Tests.push_back(test);
+        return &Tests.back();
+    }
+
+    bool Load(const char* filename)
+    {
+        size_t file_size = 0;
+        char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size, 1);
+        if (file_data == nullptr)
+            return false;
+        ImVector<int> remap; // Index in file -> index in Funcs[]
+        for (char* line = file_data; line < file_data + file_size; )
+        {
+            char* line_end = strchr(line, '\n');
+            if (line_end == nullptr)
+                line_end = file_data + file_size;
+            *line_end = 0;
+            if (line[0] == 'F' && line[1] == '\t')
+            {
+                remap.push_back(AddFunc(line + 2));
+            }
+            else if (line[0] == 'T' && line[1] == '\t')
+            {
+                char* category = line + 2;
+                char* name = strchr(category, '\t');
+                char* indices = name ? strchr(name + 1, '\t') : nullptr;
+                if (indices != nullptr)
+                {
+                    *name++ = 0;
+                    *indices++ = 0;
+                    TestSuiteCoverageDbTest* test = AddTest(category, name);
+                    for (char* p = indices; *p != 0; )
+                    {
+                        char* p_end = nullptr;
+                        long idx = strtol(p, &p_end, 10);
+                        if (p_end == p)
+                            break;
+                        if (idx >= 0 && idx < remap.Size)
+                        {
+                            TestsFuncs.push_back(remap[(int)idx]);
+                            test->FuncsCount++;
+                        }
+                        p = p_end;
+                    }
+                }
+            }
+            line = line_end + 1;
+        }
+        IM_FREE(file_data);
+        return true;
+    }
+
+    bool Save(const char* filename)
+    {
+        FILE* f = fopen(filename, "wb");
+        if (f == nullptr)
+            return false;
+        fprintf(f, "; imgui_test_suite coverage: imgui core functions called by each test (see -record-coverage, -changed-since)\n");
+        for (char* func : Funcs)
+            fprintf(f, "F\t%s\n", func);
+        for (TestSuiteCoverageDbTest& test : Tests)
+        {
+            fprintf(f, "T\t%s\t%s\t", test.Category, test.Name);
+            for (int n = 0; n < test.FuncsCount; n++)
+                fprintf(f, n ? " %d" : "%d", TestsFuncs[test.FuncsOffset + n]);
+            fprintf(f, "\n");
+        }
+        fclose(f);
+        return true;
+    }
+};
+
+#if IMGUI_TEST_SUITE_ENABLE_COVERAGE
+#include <link.h>       // dl_iterate_phdr()
+#include <unistd.h>     // readlink()
+
+// Recording: imgui core is compiled with -finstrument-functions (see Makefile), which calls __cyg_profile_func_enter()
+// on entry of every function. We gather addresses of called functions in a set, flushed by main loop when running test changes.
+// Only one of main thread and test coroutine are running at a given time, so no locking is required.
+#define TEST_SUITE_NO_INSTRUMENT    __attribute__((no_instrument_function))
+
+struct TestSuiteCoverageSet
+{
+    void**                      Data = nullptr;
+    int                         Size = 0;
+    int                         Capacity = 0;               // Power of two
+    bool                        Enabled = false;
+};
+static TestSuiteCoverageSet     GTestSuiteCoverageSet;
+
+static inline TEST_SUITE_NO_INSTRUMENT void** TestSuite_CoverageSetProbe(void** data, int capacity, void* fn)
+{
+    size_t idx = (size_t)(((ImU64)(uintptr_t)fn * 0x9E3779B97F4A7C15ull) >> 32) & (size_t)(capacity - 1);
+    while (data[idx] != nullptr && data[idx] != fn)
+        idx = (idx + 1) & (size_t)(capacity - 1);
+    return &data[idx];
+}
+
+extern "C" TEST_SUITE_NO_INSTRUMENT void __cyg_profile_func_enter(void* fn, void* call_site)
+{
+    IM_UNUSED(call_site);
+    TestSuiteCoverageSet* set = &GTestSuiteCoverageSet;
+    if (!set->Enabled)
+        return;
+    if (set->Size * 2 >= set->Capacity)
+    {
+        const int new_capacity = set->Capacity ? set->Capacity * 2 : 4096;
+        void** new_data = (void**)calloc((size_t)new_capacity, sizeof(void*));
+        for (int n = 0; n < set->Capacity; n++)
+            if (set->Data[n] != nullptr)
+                *TestSuite_CoverageSetProbe(new_data, new_capacity, set->Data[n]) = set->Data[n];
+        free(set->Data);
+        set->Data = new_data;
+        set->Capacity = new_capacity;
+    }
+    void** slot = TestSuite_CoverageSetProbe(set->Data, set->Capacity, fn);
+    if (*slot == nullptr)
+    {
+        *slot = fn;
+        set->Size++;
+    }
+}
+
+extern "C" TEST_SUITE_NO_INSTRUMENT void __cyg_profile_func_exit(void* fn, void* call_site)
+{
+    IM_UNUSED(fn);
+    IM_UNUSED(call_site);
+}
+
+// Move content of recording set to current test record, and start recording for running test (if any).
+static void TestSuite_CoverageUpdate(TestSuiteApp* app)
+{
+    if (app->CoverageTest != nullptr && app->CoverageTest->Output.Status == ImGuiTestStatus_Running)
+        return;
+
+    ImGuiTest* running_test = nullptr;
+    for (ImGuiTest* test : app->CoverageTestList)
+        if (test->Output.Status == ImGuiTestStatus_Running)
+            running_test = test;
+    if (running_test == app->CoverageTest)
+        return;
+
+    TestSuiteCoverageSet* set = &GTestSuiteCoverageSet;
+    set->Enabled = false;
+    if (app->CoverageTest != nullptr)
+    {
+        TestSuiteCoverageRecord record = { app->CoverageTest, app->CoverageAddrs.Size, 0 };
+        for (int n = 0; n < set->Capacity; n++)
+            if (set->Data[n] != nullptr)
+                app->CoverageAddrs.push_back(set->Data[n]);
+        record.AddrCount = app->CoverageAddrs.Size - record.AddrOffset;
+        app->CoverageRecords.push_back(record);
+    }
+    if (set->Data != nullptr)
+        memset(set->Data, 0, sizeof(void*) * (size_t)set->Capacity);
+    set->Size = 0;
+    app->CoverageTest = running_test;
+    set->Enabled = (running_test != nullptr);
+}
+
+static int TestSuite_CoverageGetLoadBias(struct dl_phdr_info* info, size_t, void* data)
+{
+    *(uintptr_t*)data = (uintptr_t)info->dlpi_addr; // First entry is main program
+    return 1;
+}
+
+// Resolve recorded addresses to function names using addr2line, then merge with existing coverage file.
+static void TestSuite_CoverageSave(TestSuiteApp* app)
+{
+    TestSuite_CoverageUpdate(app); // Flush last test
+    GTestSuiteCoverageSet.Enabled = false;
+    if (app->CoverageRecords.empty())
+        return;
+
+    // Unique addresses
+    ImVector<void*> addrs = app->CoverageAddrs;
+    ImQsort(addrs.Data, (size_t)addrs.Size, sizeof(void*), [](const void* lhs, const void* rhs)
+    {
+        const uintptr_t a = *(const uintptr_t*)lhs;
+        const uintptr_t b = *(const uintptr_t*)rhs;
+        return (a < b) ? -1 : (a > b) ? +1 : 0;
+    });
+    int addrs_count = 0;
+    for (int n = 0; n < addrs.Size; n++)
+        if (n == 0 || addrs[n] != addrs[addrs_count - 1])
+            addrs[addrs_count++] = addrs[n];
+    addrs.resize(addrs_count);
+
+    // Resolve with addr2line
+    char exe_path[1024];
+    ssize_t exe_path_len = readlink("/proc/self/exe", exe_path, sizeof(exe_path) - 1);
+    char addrs_path[] = "/tmp/imgui_test_suite_coverage_XXXXXX";
+    int addrs_fd = (exe_path_len > 0) ? mkstemp(addrs_path) : -1;
+    if (addrs_fd < 0)
+    {
+        fprintf(stderr, "Error writing coverage: unable to create temporary file.\n");
+        return;
+    }
+    exe_path[exe_path_len] = 0;
+    uintptr_t load_bias = 0;
+    dl_iterate_phdr(TestSuite_CoverageGetLoadBias, &load_bias);
+    FILE* addrs_file = fdopen(addrs_fd, "wb");
+    for (void* addr : addrs)
+        fprintf(addrs_file, "0x%llx\n", (unsigned long long)((uintptr_t)addr - load_bias));
+    fclose(addrs_file);
+
+    TestSuiteCoverageDb db;
+    ImVector<int> addrs_func;       // Index in addrs[] -> index in db.Funcs[]
+    Str1024f cmd("addr2line -f -C -e \"%s\" < \"%s\"", exe_path, addrs_path);
+    if (FILE* pipe = ImOsPOpen(cmd.c_str(), "r"))
+    {
+        char func_line[2048];
+        char file_line[2048];
+        while (addrs_func.Size < addrs.Size && fgets(func_line, IM_ARRAYSIZE(func_line), pipe) && fgets(file_line, IM_ARRAYSIZE(file_line), pipe))
+        {
+            // "ImGui::ButtonEx(char const*, ImVec2 const&, int)" -> "ImGui::ButtonEx". Lambdas are attributed to their enclosing function.
+            char* func = func_line;
+            if (strncmp(func, "(anonymous namespace)::", 23) == 0)
+                func += 23;
+            func[strcspn(func, "(\r\n")] = 0;
+            addrs_func.push_back(db.AddFunc(func));
+        }
+        ImOsPClose(pipe);
+    }
+    ImFileDelete(addrs_path);
+    if (addrs_func.Size != addrs.Size)
+    {
+        fprintf(stderr, "Error writing coverage: failed to resolve function addresses (is addr2line installed?)\n");
+        return;
+    }
+
+    // Add recorded tests
+    ImGuiStorage recorded_tests;
+    for (TestSuiteCoverageRecord& record : app->CoverageRecords)
+    {
+        TestSuiteCoverageDbTest* db_test = db.AddTest(record.Test->Category, record.Test->Name);
+        ImGuiStorage test_funcs;
+        for (int n = 0; n < record.AddrCount; n++)
+        {
+            void* addr = app->CoverageAddrs[record.AddrOffset + n];
+            void** addr_it = (void**)bsearch(&addr, addrs.Data, (size_t)addrs.Size, sizeof(void*), [](const void* lhs, const void* rhs)
+            {
+                const uintptr_t a = *(const uintptr_t*)lhs;
+                const uintptr_t b = *(const uintptr_t*)rhs;
+                return (a < b) ? -1 : (a > b) ? +1 : 0;
+            });
+            const int func_idx = addrs_func[(int)(addr_it - addrs.Data)];
+            if (db.Funcs[func_idx][0] == '?' || test_funcs.GetBool((ImGuiID)func_idx + 1))
+                continue;
+            test_funcs.SetBool((ImGuiID)func_idx + 1, true);
+            db.TestsFuncs.push_back(func_idx);
+            db_test->FuncsCount++;
+        }
+        recorded_tests.SetBool(ImHashStr(record.Test->Name, 0, ImHashStr(record.Test->Category)), true);
+    }
+
+    // Keep tests from previous runs which didn't run this time
+    TestSuiteCoverageDb prev_db;
+    prev_db.Load(TEST_SUITE_COVERAGE_FILENAME);
+    for (TestSuiteCoverageDbTest& prev_test : prev_db.Tests)
+    {
+        if (recorded_tests.GetBool(ImHashStr(prev_test.Name, 0, ImHashStr(prev_test.Category))))
+            continue;
+        TestSuiteCoverageDbTest* db_test = db.AddTest(prev_test.Category, prev_test.Name);
+        for (int n = 0; n < prev_test.FuncsCount; n++)
+            db.TestsFuncs.push_back(db.AddFunc(prev_db.Funcs[prev_db.TestsFuncs[prev_test.FuncsOffset + n]]));
+        db_test->FuncsCount = prev_test.FuncsCount;
+    }
+
+    if (db.Save(TEST_SUITE_COVERAGE_FILENAME))
+        printf("Saved coverage of %d tests (%d functions) to '%s'.\n", app->CoverageRecords.Size, db.Funcs.Size, TEST_SUITE_COVERAGE_FILENAME);
+    else
+        fprintf(stderr, "Error writing coverage to '%s'.\n", TEST_SUITE_COVERAGE_FILENAME);
+}
+#else
+static void TestSuite_CoverageUpdate(TestSuiteApp*) {}
+static void TestSuite_CoverageSave(TestSuiteApp*) {}
+#endif // #if IMGUI_TEST_SUITE_ENABLE_COVERAGE
+
+// Lines of a diff hunk, in new version of file
+struct TestSuiteDiffHunk
+{
+    int                         FileIdx;                    // Index into TestSuiteDiff::Files[]
+    int                         LineMin;
+    int                         LineMax;
+};
+
+struct TestSuiteDiff
+{
+    ImVector<char*>             Files;                      // Paths relative to repository root
+    ImVector<TestSuiteDiffHunk> Hunks;
+
+    ~TestSuiteDiff() { for (char* file : Files) IM_FREE(file); }
+};
+
+static bool TestSuite_GitRevExists(const char* repo_path, const char* rev)
+{
+    Str512f cmd("git -C \"%s\" rev-parse --verify --quiet \"%s^{commit}\"", repo_path, rev);
+    FILE* pipe = ImOsPOpen(cmd.c_str(), "r");
+    if (pipe == nullptr)
+        return false;
+    char line[256];
+    bool exists = fgets(line, IM_ARRAYSIZE(line), pipe) != nullptr && line[0] != 0 && line[0] != '\n';
+    ImOsPClose(pipe);
+    return exists;
+}
+
+// Gather changes between 'rev' and working tree, using 'git diff -U0'
+static bool TestSuite_GitDiff(const char* repo_path, const char* rev, TestSuiteDiff* out_diff)
+{
+    Str512f cmd("git -C \"%s\" diff -U0 --no-color --no-ext-diff --no-renames \"%s\" --", repo_path, rev);
+    FILE* pipe = ImOsPOpen(cmd.c_str(), "r");
+    if (pipe == nullptr)
+        return false;
+    char line[2048];
+    Str256 old_file;
+    int file_idx = -1;
+    while (fgets(line, IM_ARRAYSIZE(line), pipe))
+    {
+        if (strncmp(line, "--- ", 4) == 0)
+        {
+            // "--- /dev/null" for added files
+            line[strcspn(line, "\r\n")] = 0;
+            old_file.set((strncmp(line + 4, "a/", 2) == 0) ? line + 6 : "");
+        }
+        else if (strncmp(line, "+++ ", 4) == 0)
+        {
+            // "+++ /dev/null" for deleted files: use old path, file will be missing from working tree
+            file_idx = -1;
+            line[strcspn(line, "\r\n")] = 0;
+            const char* file = (strncmp(line + 4, "b/", 2) == 0) ? line + 6 : old_file.c_str();
+            if (file[0] != 0)
+            {
+                out_diff->Files.push_back(ImStrdup(file));
+                file_idx = out_diff->Files.Size - 1;
+            }
+        }
+        else if (file_idx != -1 && strncmp(line, "@@ ", 3) == 0)
+        {
+            // "@@ -old_start[,old_count] +new_start[,new_count] @@". Pure deletions have new_count == 0 and happen after new_start.
+            int new_start = 0;
+            int new_count = 1;
+            const char* p = strchr(line + 3, '+');
+            if (p == nullptr || sscanf(p, "+%d,%d", &new_start, &new_count) < 1)
+                continue;
+            TestSuiteDiffHunk hunk;
+            hunk.FileIdx = file_idx;
+            hunk.LineMin = ImMax(new_start, 1);
+            hunk.LineMax = (new_count > 0) ? new_start + new_count - 1 : new_start + 1;
+            out_diff->Hunks.push_back(hunk);
+        }
+    }
+    ImOsPClose(pipe);
+    return true;
+}
+
+// Return true if 'src_file' (__FILE__ of a test, may be relative to build directory) and 'repo_file' (relative to repository root) refer to the same file.
+static bool TestSuite_SourceFileMatches(const char* src_file, const char* repo_file)
+{
+    Str256 a(src_file);
+    for (char* p = a.c_str(); *p; p++)
+        if (*p == '\\')
+            *p = '/';
+    const char* a_begin = a.c_str();
+    while (strncmp(a_begin, "./", 2) == 0 || strncmp(a_begin, "../", 3) == 0)
+        a_begin += (a_begin[1] == '/') ? 2 : 3;
+    const char* b_begin = repo_file;
+    const size_t a_len = strlen(a_begin);
+    const size_t b_len = strlen(b_begin);
+    const char* longer = (a_len >= b_len) ? a_begin : b_begin;
+    const char* shorter = (a_len >= b_len) ? b_begin : a_begin;
+    const size_t offset = ImMax(a_len, b_len) - ImMin(a_len, b_len);
+    return strcmp(longer + offset, shorter) == 0 && (offset == 0 || longer[offset - 1] == '/');
+}
+
+static inline bool TestSuite_IsIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':' || c == '~';
+}
+
+// Find names of functions enclosing given lines of a source file written in imgui style:
+// definition starts with an unindented signature (which may span multiple lines), followed by a '{' line and ending with a '}' line.
+// Return false if file cannot be loaded (e.g. deleted).
+static bool TestSuite_FindChangedFunctions(const char* filename, const ImVector<TestSuiteDiffHunk>& hunks, int file_idx, ImVector<char*>* out_funcs, int* out_unmapped_hunks)
+{
+    size_t file_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size, 1);
+    if (file_data == nullptr)
+        return false;
+
+    // Split lines, then calculate enclosing function of each line
+    ImVector<char*> lines;
+    lines.push_back(nullptr); // Line numbers are 1-based
+    for (char* line = file_data; line < file_data + file_size; )
+    {
+        char* line_end = strchr(line, '\n');
+        if (line_end == nullptr)
+            line_end = file_data + file_size;
+        *line_end = 0;
+        if (line_end > line && line_end[-1] == '\r')
+            line_end[-1] = 0;
+        lines.push_back(line);
+        line = line_end + 1;
+    }
+    ImVector<int> lines_func; // Line number of function signature, or 0 when outside of a function
+    lines_func.resize(lines.Size);
+    int current_func = 0;
+    for (int line_n = 1; line_n < lines.Size; line_n++)
+    {
+        const char* line = lines[line_n];
+        if (current_func == 0 && line[0] == '{')
+        {
+            int sig_n = line_n - 1;
+            while (sig_n > 1 && (lines[sig_n][0] == ' ' || lines[sig_n][0] == '\t'))
+                sig_n--;
+            if (sig_n > 0 && strchr(lines[sig_n], '(') != nullptr && line_n - sig_n < 8)
+                current_func = sig_n;
+        }
+        lines_func[line_n] = current_func;
+        if (current_func != 0 && line[0] == '}')
+            current_func = 0;
+    }
+
+    for (const TestSuiteDiffHunk& hunk : hunks)
+    {
+        if (hunk.FileIdx != file_idx)
+            continue;
+        bool mapped = false;
+        for (int line_n = hunk.LineMin; line_n <= hunk.LineMax && line_n < lines.Size; line_n++)
+        {
+            const int sig_n = lines_func[line_n];
+            if (sig_n == 0)
+                continue;
+            mapped = true;
+
+            // "bool ImGui::ButtonEx(const char* label, ...)" -> "ImGui::ButtonEx"
+            const char* sig = lines[sig_n];
+            const char* name_end = strchr(sig, '(');
+            const char* name_begin = name_end;
+            while (name_begin > sig && TestSuite_IsIdentifierChar(name_begin[-1]))
+                name_begin--;
+            if (name_begin == name_end)
+                continue;
+            Str128 name;
+            name.append(name_begin, name_end);
+            bool found = false;
+            for (char* func : *out_funcs)
+                found |= (strcmp(func, name.c_str()) == 0);
+            if (!found)
+                out_funcs->push_back(ImStrdup(name.c_str()));
+        }
+        if (!mapped)
+            (*out_unmapped_hunks)++;
+    }
+    IM_FREE(file_data);
+    return true;
+}
+
+// Return true if recorded function name (fully qualified) refers to a function name found in source (possibly declared in a namespace block)
+static bool TestSuite_FunctionNameMatches(const char* recorded_name, const char* source_name)
+{
+    const size_t recorded_len = strlen(recorded_name);
+    const size_t source_len = strlen(source_name);
+    if (source_len > recorded_len)
+        return false;
+    const size_t offset = recorded_len - source_len;
+    return strcmp(recorded_name + offset, source_name) == 0 && (offset == 0 || (offset >= 2 && recorded_name[offset - 1] == ':' && recorded_name[offset - 2] == ':'));
+}
+
+// Only keep queued tests affected by changes since 'rev'.
+static void TestSuite_FilterQueueByChanges(TestSuiteApp* app, const char* rev)
+{
+    ImGuiTestEngine* engine = app->TestEngine;
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(engine, &tests);
+    ImGuiTestEngine_UpdateTestsSourceLines(engine);
+
+    ImGuiStorage affected_tests;
+    bool affect_all = false;
+
+    // Test engine/suite repository
+    Str64 suite_repo_path;
+    if (ImFileFindInParents("imgui_test_suite/", 4, &suite_repo_path) && TestSuite_GitRevExists(suite_repo_path.c_str(), rev))
+    {
+        TestSuiteDiff diff;
+        TestSuite_GitDiff(suite_repo_path.c_str(), rev, &diff);
+        for (int file_n = 0; file_n < diff.Files.Size && !affect_all; file_n++)
+        {
+            const char* file = diff.Files[file_n];
+            ImVector<ImGuiTest*> file_tests;
+            int file_first_line = INT_MAX;
+            int file_last_line = 0;
+            for (ImGuiTest* test : tests)
+                if (test->SourceFile != nullptr && TestSuite_SourceFileMatches(test->SourceFile, file))
+                {
+                    file_tests.push_back(test);
+                    file_first_line = ImMin(file_first_line, test->SourceLine);
+                    file_last_line = ImMax(file_last_line, test->SourceLine);
+                }
+            if (file_tests.empty())
+            {
+                // Any other source file may affect all tests
+                const char* ext = ImPathFindExtension(file);
+                if (strcmp(ext, ".cpp") == 0 || strcmp(ext, ".h") == 0 || strcmp(ext, ".c") == 0 || strcmp(ext, ".inl") == 0)
+                {
+                    printf("Changed: '%s' is not a test file, queuing all tests.\n", file);
+                    affect_all = true;
+                }
+                continue;
+            }
+            for (const TestSuiteDiffHunk& hunk : diff.Hunks)
+            {
+                if (hunk.FileIdx != file_n)
+                    continue;
+                for (ImGuiTest* test : file_tests)
+                {
+                    // Changes before first test (e.g. shared helpers) affect all tests of the file. Last test extends to end of file.
+                    const int test_line_min = (test->SourceLine == file_first_line) ? 1 : test->SourceLine;
+                    const int test_line_max = (test->SourceLine == file_last_line) ? INT_MAX : test->SourceLineEnd;
+                    if (hunk.LineMin <= test_line_max && hunk.LineMax >= test_line_min)
+                        affected_tests.SetBool(ImHashStr(test->Name, 0, ImHashStr(test->Category)), true);
+                }
+            }
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Changed: unable to find revision '%s' in test suite repository, queuing all tests.\n", rev);
+        affect_all = true;
+    }
+
+    // Dear ImGui repository
+    Str64 imgui_repo_path;
+    ImVector<char*> changed_funcs;
+    int unmapped_hunks = 0;
+    if (!affect_all && ImFileFindInParents("imgui/", 4, &imgui_repo_path))
+    {
+        TestSuiteDiff diff;
+        if (TestSuite_GitRevExists(imgui_repo_path.c_str(), rev))
+        {
+            TestSuite_GitDiff(imgui_repo_path.c_str(), rev, &diff);
+        }
+        else
+        {
+            printf("Changed: revision '%s' not found in imgui repository, queuing all tests.\n", rev);
+            affect_all = true;
+        }
+        for (int file_n = 0; file_n < diff.Files.Size && !affect_all; file_n++)
+        {
+            // Only consider core library at the root of repository
+            const char* file = diff.Files[file_n];
+            if (strchr(file, '/') != nullptr)
+                continue;
+            const char* ext = ImPathFindExtension(file);
+            if (strcmp(ext, ".h") == 0)
+            {
+                printf("Changed: '%s' is a header file, queuing all tests.\n", file);
+                affect_all = true;
+            }
+            else if (strcmp(ext, ".cpp") == 0)
+            {
+                Str256f path("%s%s", imgui_repo_path.c_str(), file);
+                if (!TestSuite_FindChangedFunctions(path.c_str(), diff.Hunks, file_n, &changed_funcs, &unmapped_hunks))
+                {
+                    printf("Changed: '%s' was deleted, queuing all tests.\n", file);
+                    affect_all = true;
+                }
+            }
+        }
+    }
+    if (!affect_all && unmapped_hunks > 0)
+    {
+        // e.g. changes to static data, macros or type declarations: we cannot tell which tests they affect
+        printf("Changed: %d hunks in imgui/*.cpp are outside of functions, queuing all tests.\n", unmapped_hunks);
+        affect_all = true;
+    }
+
+    // Map changed core functions to tests using coverage of a previous run
+    if (!affect_all && !changed_funcs.empty())
+    {
+        TestSuiteCoverageDb db;
+        if (!db.Load(TEST_SUITE_COVERAGE_FILENAME))
+        {
+            printf("Changed: %d functions in imgui/*.cpp but no coverage data ('%s'), queuing all tests. Record with -record-coverage.\n", changed_funcs.Size, TEST_SUITE_COVERAGE_FILENAME);
+            affect_all = true;
+        }
+        else
+        {
+            ImVector<bool> db_funcs_changed;
+            db_funcs_changed.resize(db.Funcs.Size, false);
+            for (char* changed_func : changed_funcs)
+            {
+                bool covered = false;
+                for (int func_n = 0; func_n < db.Funcs.Size; func_n++)
+                    if (TestSuite_FunctionNameMatches(db.Funcs[func_n], changed_func))
+                        db_funcs_changed[func_n] = covered = true;
+                printf("Changed: %s()%s\n", changed_func, covered ? "" : " (not called by any recorded test)");
+            }
+            for (TestSuiteCoverageDbTest& db_test : db.Tests)
+                for (int n = 0; n < db_test.FuncsCount; n++)
+                    if (db_funcs_changed[db.TestsFuncs[db_test.FuncsOffset + n]])
+                    {
+                        affected_tests.SetBool(ImHashStr(db_test.Name, 0, ImHashStr(db_test.Category)), true);
+                        break;
+                    }
+        }
+    }
+    for (char* changed_func : changed_funcs)
+        IM_FREE(changed_func);
+    if (affect_all)
+        return;
+
+    // Requeue affected tests, preserving order
+    ImVector<ImGuiTestRunTask> queue;
+    ImGuiTestEngine_GetTestQueue(engine, &queue);
+    ImGuiTestEngine_ClearTestQueue(engine);
+    int queued_count = 0;
+    for (ImGuiTestRunTask& run_task : queue)
+        if (affected_tests.GetBool(ImHashStr(run_task.Test->Name, 0, ImHashStr(run_task.Test->Category))))
+        {
+            ImGuiTestEngine_QueueTest(engine, run_task.Test, run_task.RunFlags);
+            queued_count++;
+        }
+    printf("Changed since '%s': queued %d/%d tests.\n", rev, queued_count, queue.Size);
+}
+
 // Win32 Debug CRT to help catch leaks. Replace parameter in main()'s 'DebugCrtInit(0)' call to track a given allocation from the ID given in leak report.
 #ifdef DEBUG_CRT
 static inline void DebugCrtInit(long break_alloc)
@@ -427,6 +1475,43 @@ int main(int argc, char** argv)
     }
     argv = nullptr;
 
+    // Convert perf log and exit
+    if (!app->OptPerfLogConvertSrc.empty())
+    {
+        if (!ImGuiTestEngine_PerfToolConvertLog(app->OptPerfLogConvertSrc.c_str(), app->OptPerfLogConvertDst.c_str()))
+        {
+            fprintf(stderr, "Unable to convert perf log '%s' to '%s'.\n", app->OptPerfLogConvertSrc.c_str(), app->OptPerfLogConvertDst.c_str());
+            return ImGuiTestAppErrorCode_CommandLineError;
+        }
+        return ImGuiTestAppErrorCode_Success;
+    }
+
+    // Check perf log for regressions and exit
+    if (app->OptPerfCheck)
+    {
+        ImGuiPerfTool perftool;
+        if (!perftool.LoadDefaultLog())
+        {
+            fprintf(stderr, "Unable to load perf log '%s' or '%s'.\n", IMGUI_PERFLOG_BINARY_DEFAULT_FILENAME, IMGUI_PERFLOG_DEFAULT_FILENAME);
+            return ImGuiTestAppErrorCode_CommandLineError;
+        }
+        ImVector<ImGuiPerfToolCheckResult> results;
+        const int num_regressions = ImGuiTestEngine_PerfToolCheckRegressions(&perftool, &results, app->OptPerfCheckWindow, app->OptPerfCheckMinDelta);
+        for (const ImGuiPerfToolCheckResult& result : results)
+        {
+            if (!result.Regressed)
+                continue;
+            const ImGuiPerfToolEntry& entry = result.Entry;
+            printf("- %s (%s %s %s %s %s): %+.1f%% median (%.4f ms -> %.4f ms), p = %.4f, r = %.2f\n", entry.TestName,
+                entry.GitBranchName, entry.BuildType, entry.Cpu, entry.OS, entry.Compiler,
+                result.DeltaPercent, result.PreviousMedianMs, result.RecentMedianMs, result.PValue, result.RankBiserial);
+        }
+        printf("Perf check: %d regressed out of %d checked perf tests.\n", num_regressions, results.Size);
+        if (!app->OptExportFilename.empty() && !ImGuiTestEngine_PerfToolExportCheckResults(results, app->OptExportFilename.c_str()))
+            fprintf(stderr, "Writing '%s' failed.\n", app->OptExportFilename.c_str());
+        return (num_regressions > 0) ? ImGuiTestAppErrorCode_TestFailed : ImGuiTestAppErrorCode_Success;
+    }
+
     // Default verbose levels differs whether we are in in GUI or Command-Line mode
     if (app->OptGui)
     {
@@ -489,12 +1574,24 @@ int main(int argc, char** argv)
     test_io.ConfigVerboseLevel = app->OptVerboseLevelBasic;
     test_io.ConfigVerboseLevelOnError = app->OptVerboseLevelError;
     test_io.ConfigNoThrottle = app->OptNoThrottle;
+    test_io.ConfigSkipRender = app->OptSkipRender && !app->OptGui;
+    test_io.ConfigUiContextSnapshot = app->OptUiContextSnapshot;
+    test_io.ConfigVirtualClock = app->OptVirtualClock;
+    test_io.ConfigLogDeferredFormatting = app->OptLogDeferredFormatting;
+    test_io.ConfigLogAsyncOutput = app->OptLogAsyncOutput;
+    test_io.ConfigPerfCounters = app->OptPerfCounters;
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+    if (app->OptNoThrottle)
+        Coroutine_ImplStdThread_SetHandoffPolicy(ImGuiTestCoroutineHandoffPolicy_SpinThenPark); // Lower per-frame overhead of std::thread coroutine when not throttling
+#endif
     test_io.PerfStressAmount = app->OptStressAmount;
     test_io.ConfigCaptureEnabled = app->OptCaptureEnabled;
     FindVideoEncoder(test_io.VideoCaptureEncoderPath, IM_ARRAYSIZE(test_io.VideoCaptureEncoderPath));
     ImStrncpy(test_io.VideoCaptureEncoderParams, IMGUI_CAPTURE_DEFAULT_VIDEO_PARAMS_FOR_FFMPEG, IM_ARRAYSIZE(test_io.VideoCaptureEncoderParams));
     ImStrncpy(test_io.GifCaptureEncoderParams, IMGUI_CAPTURE_DEFAULT_GIF_PARAMS_FOR_FFMPEG, IM_ARRAYSIZE(test_io.GifCaptureEncoderParams));
     test_io.CheckDrawDataIntegrity = true;
+    test_io.TimingHistoryFilename = TEST_SUITE_TIMING_HISTORY_FILENAME; // Saved by ImGuiTestEngine_Stop(): never by -list (exits before starting engine) nor by -jobs workers (cleared in TestSuite_RunJobs())
+    test_io.ConfigSchedulePolicy = app->OptSchedulePolicy;
 
     if (app->OptGui)
     {
@@ -549,7 +1646,9 @@ int main(int argc, char** argv)
     if (app->OptGuiFunc)
         test_run_flags |= ImGuiTestRunFlags_GuiFuncOnly;
     TestSuite_QueueTests(app, test_run_flags);
-    const bool exit_after_tests = !ImGuiTestEngine_IsTestQueueEmpty(engine) && !app->OptPauseOnExit;
+    if (!app->OptChangedSince.empty())
+        TestSuite_FilterQueueByChanges(app, app->OptChangedSince.c_str());
+    bool exit_after_tests = !ImGuiTestEngine_IsTestQueueEmpty(engine) && !app->OptPauseOnExit;
 
     // Retrieve Git branch name, store in annotation field by default
     Str64 git_repo_path;
@@ -568,12 +1667,32 @@ int main(int argc, char** argv)
     if (app->OptListTests)
     {
         ImVector<ImGuiTestRunTask> tests;
-        ImGuiTestEngine_GetTestQueue(engine, &tests);
+        float predicted_total = 0.0f;
+        ImGuiTestEngine_GetTestQueue(engine, &tests, &predicted_total);
         for (ImGuiTestRunTask& test_task : tests)
             printf("Test: '%s' '%s'\n", test_task.Test->Category, test_task.Test->Name);
+        printf("Predicted duration: %.1f sec\n", predicted_total);
         return 0;
     }
 
+    // Coverage recording needs all tests to run in this process
+    if (app->OptRecordCoverage)
+    {
+        if (app->OptJobs > 1)
+            fprintf(stderr, "-jobs is ignored when recording coverage.\n");
+        app->OptJobs = 1;
+        ImGuiTestEngine_GetTestList(engine, &app->CoverageTestList);
+    }
+
+    // Parallel jobs: main process returns after workers are done (with merged results and an empty queue), workers continue with their share of the queue
+    if (app->OptJobs > 1)
+    {
+        if (app->OptGui)
+            fprintf(stderr, "-jobs is ignored in interactive runs.\n");
+        else if (!TestSuite_RunJobs(app))
+            exit_after_tests = true; // Worker process
+    }
+
     // Start engine
     ImGuiTestEngine_Start(engine, ImGui::GetCurrentContext());
     ImGuiTestEngine_InstallDefaultCrashHandler();
@@ -590,6 +1709,7 @@ int main(int argc, char** argv)
     {
         // Backend update
         // (stop updating them once we started aborting, as e.g. closed windows will have zero size etc.)
+        app_window->FixedDeltaTime = test_io.IsUsingVirtualClock ? test_io.ConfigVirtualClockDeltaTime : 0.0f;
         if (!aborted && !app_window->NewFrame(app_window))
             aborted = true;
 
@@ -601,6 +1721,8 @@ int main(int argc, char** argv)
             break;
 
         ImGui::NewFrame();
+        if (app->OptRecordCoverage)
+            TestSuite_CoverageUpdate(app);
         TestSuite_ShowUI(app);
 
         // Optionally draw a non-ambiguous mouse cursor when simulated inputs are running
@@ -610,24 +1732,39 @@ int main(int argc, char** argv)
             //ImGui::RenderMouseCursor(io.MousePos, 1.2f, ImGui::GetMouseCursor(), IM_COL32(255, 255, 120, 255), IM_COL32(0, 0, 0, 255), IM_COL32(0, 0, 0, 60)); // Custom yellow cursor
 #endif
 
-        ImGui::Render();
+        // Test engine may let us skip rendering (with -skiprender). IsRequestingSkipRender is updated by ImGui::EndFrame().
+        ImGui::EndFrame();
+        if (app->JobsWorkerResultsFile)
+            TestSuite_JobWriteResults(app); // Send results of tests which ended this frame to main process (parallel jobs)
+        const bool skip_render = test_io.IsRequestingSkipRender;
+        if (!skip_render)
+            ImGui::Render();
 
         if (!app->OptGui && !test_io.IsRunningTests)
             break;
 
-        app_window->Vsync = test_io.IsRequestingMaxAppSpeed ? false : true;
-        app_window->ClearColor = app->ClearColor;
-        app_window->Render(app_window);
+        if (!skip_render)
+        {
+            app_window->Vsync = test_io.IsRequestingMaxAppSpeed ? false : true;
+            app_window->ClearColor = app->ClearColor;
+            app_window->Render(app_window);
+        }
 
         // Post-swap handler is REQUIRED in order to support screen capture
         ImGuiTestEngine_PostSwap(engine);
     }
 
     ImGuiTestEngine_Stop(engine);
+    if (app->OptRecordCoverage)
+        TestSuite_CoverageSave(app);
+
+    // Send remaining results to main process (parallel jobs)
+    if (app->JobsWorkerResultsFile)
+        TestSuite_JobWriteResults(app);
 
     // Print results (command-line mode)
     ImGuiTestAppErrorCode error_code = ImGuiTestAppErrorCode_Success;
-    if (!aborted)
+    if (!aborted && app->JobsWorkerResultsFile == nullptr)
     {
         ImGuiTestEngineResultSummary summary;
         ImGuiTestEngine_GetResultSummary(engine, &summary);
@@ -3,8 +3,32 @@
 
 #pragma once
 
+#include "imgui_test_engine/imgui_te_engine.h"      // ImGuiTestEngineIO
+
 #define TEST_SUITE_ALT_FONT_NAME   "Roboto-Medium.ttf"      // Prefix
 
 // Tests Registration Functions
 struct ImGuiTestEngine;
 extern void RegisterTests_All(ImGuiTestEngine* e);          // imgui_tests_core.cpp
+
+// Tests Helpers
+// Restore test engine options modified by a test on every exit, including early return of a failing IM_CHECK().
+// Usage: 'TestSuiteEngineIOBackup backup_engine_io(ctx->EngineIO);' before modifying ctx->EngineIO.
+struct TestSuiteEngineIOBackup
+{
+    ImGuiTestEngineIO*  EngineIO;
+    ImGuiTestEngineIO   Backup;
+
+    TestSuiteEngineIOBackup(ImGuiTestEngineIO* engine_io) : EngineIO(engine_io), Backup(*engine_io) {}
+    ~TestSuiteEngineIOBackup()
+    {
+        // Restore options, keep output state
+        ImGuiTestEngineIO output = *EngineIO;
+        *EngineIO = Backup;
+        EngineIO->IsRunningTests = output.IsRunningTests;
+        EngineIO->IsRequestingMaxAppSpeed = output.IsRequestingMaxAppSpeed;
+        EngineIO->IsUsingVirtualClock = output.IsUsingVirtualClock;
+        EngineIO->IsRequestingSkipRender = output.IsRequestingSkipRender;
+        EngineIO->IsCapturing = output.IsCapturing;
+    }
+};
@@ -24,6 +24,10 @@
 // In your own application you may want to implement them using your own facilities (own thread or coroutine)
 #define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL 1
 
+// Enable coroutine implementation using ucontext on Linux (used instead of std::thread one, which is still compiled for comparison in perf_coroutine_yields)
+// Opt-in (uncomment or add -DIMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL=1 to compiler flags): std::thread implementation is better supported by debuggers and sanitizers.
+//#define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL 1
+
 // Enable plotting of perflog data for comparing performance of different runs. This feature requires ImPlot.
 #ifndef IMGUI_TEST_ENGINE_ENABLE_IMPLOT
 #define IMGUI_TEST_ENGINE_ENABLE_IMPLOT 1
@@ -9,6 +9,7 @@
 #include "imgui_test_suite.h"
 #include "imgui_test_engine/imgui_te_engine.h"      // IM_REGISTER_TEST()
 #include "imgui_test_engine/imgui_te_context.h"
+#include "imgui_test_engine/imgui_te_internal.h"   // ImGuiTestUiContextSnapshot
 #include "imgui_test_engine/imgui_te_utils.h"       // ImHashDecoratedPath()
 #include "imgui_test_engine/imgui_capture_tool.h"
 #include "imgui_test_engine/thirdparty/Str/Str.h"
@@ -5153,6 +5154,71 @@ void RegisterTests_Misc(ImGuiTestEngine* e)
         IM_CHECK_STR_EQ(text.c_str(), "A thing somewhere");
     };
 
+    // ## Test statistics helpers used by PerfCapture()
+    t = IM_REGISTER_TEST(e, "misc", "misc_stats_summary");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        // 1..99 + one outlier, shuffled
+        ImVector<double> samples;
+        for (int n = 1; n < 100; n++)
+            samples.push_back((double)((n * 37) % 99 + 1));
+        samples.push_back(1000.0);
+
+        ImStatsSummary stats;
+        ImStatsCalcSummary(samples.Data, samples.Size, &stats);
+        IM_CHECK_EQ(stats.Count, 100);
+        IM_CHECK_EQ(stats.OutlierCount, 1);
+        IM_CHECK_EQ(stats.Min, 1.0);
+        IM_CHECK_EQ(stats.Max, 1000.0);
+        IM_CHECK_EQ(stats.Median, 50.5);
+        IM_CHECK(ImFabs((float)(stats.P90 - 90.1)) < 0.0001f);
+        IM_CHECK_EQ(stats.MAD, 25.0);
+        IM_CHECK_EQ(stats.Mean, 50.0);
+        IM_CHECK(stats.CI95 > 0.0 && stats.CI95 < 10.0);
+        IM_CHECK_EQ(samples[0], 1.0); // Sorted in place
+
+        // No rejection when all samples are equal
+        for (double& sample : samples)
+            sample = 2.0;
+        ImStatsCalcSummary(samples.Data, samples.Size, &stats);
+        IM_CHECK_EQ(stats.OutlierCount, 0);
+        IM_CHECK_EQ(stats.Mean, 2.0);
+        IM_CHECK_EQ(stats.P99, 2.0);
+        IM_CHECK_EQ(stats.CI95, 0.0);
+    };
+
+    // ## Test CPU time and hardware counters helpers used by PerfCapture() (see ConfigPerfCounters)
+    t = IM_REGISTER_TEST(e, "misc", "misc_perf_counters");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImPerfCounterGroup group;
+        const bool has_counters = group.Open();
+        ImU64 values_start[ImPerfCounter_COUNT] = {};
+        ImU64 values_end[ImPerfCounter_COUNT] = {};
+        IM_CHECK_EQ(group.Read(values_start), has_counters);
+
+        const uint64_t cpu_time_start = ImThreadGetCpuTimeInNanoseconds();
+        volatile ImU32 hash = 0;
+        for (int n = 0; n < 1000000; n++)
+            hash = ImHashData(&n, sizeof(n), hash);
+        const uint64_t cpu_time_end = ImThreadGetCpuTimeInNanoseconds();
+        if (cpu_time_start != 0)
+            IM_CHECK_GE(cpu_time_end, cpu_time_start); // May not advance on Windows, where GetThreadTimes() is updated on scheduler ticks
+
+        IM_CHECK_EQ(group.Read(values_end), has_counters);
+        if (has_counters)
+        {
+            IM_CHECK_GE(values_end[ImPerfCounter_Cycles], values_start[ImPerfCounter_Cycles]);
+            IM_CHECK_GT(values_end[ImPerfCounter_Instructions] - values_start[ImPerfCounter_Instructions], (ImU64)1000000);
+        }
+        else
+        {
+            ctx->LogInfo("Hardware performance counters not available.");
+        }
+        group.Close();
+        IM_CHECK(!group.IsOpen());
+    };
+
 #if IMGUI_VERSION_NUM >= 19054
     t = IM_REGISTER_TEST(e, "misc", "misc_text_funcs");
     t->TestFunc = [](ImGuiTestContext* ctx)
@@ -6238,6 +6304,220 @@ void RegisterTests_TestEngine(ImGuiTestEngine* e)
         //IM_CHECK(false);
     };
 
+    // ## Test ImGuiTestUiContextSnapshot (used instead of post-test yields when ConfigUiContextSnapshot is set)
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_ui_context_snapshot");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        auto& vars = ctx->GenericVars;
+        if (vars.Step == 0)
+            return;
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        if (ImGui::IsWindowAppearing())
+            vars.Count++;
+        ImGui::Button("Button");
+        if (ImGui::Button("Open"))
+            ImGui::OpenPopup("Popup");
+        if (ImGui::BeginPopup("Popup"))
+        {
+            ImGui::Text("Popup");
+            ImGui::EndPopup();
+        }
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiContext& g = *ctx->UiContext;
+        auto& vars = ctx->GenericVars;
+
+        // Create window then hide it, so it exists in snapshot
+        vars.Step = 1;
+        ctx->Yield(2);
+        ImGuiWindow* window = ctx->GetWindowByRef("Test Window");
+        IM_CHECK(window != NULL);
+        vars.Step = 0;
+        ctx->Yield(2);
+        IM_CHECK(!window->WasActive);
+
+        ImGuiTestUiContextSnapshot snapshot;
+        ImGuiTestEngine_UiContextSnapshotCapture(ctx->UiContext, &snapshot);
+        const ImVec2 backup_pos = window->Pos;
+        const int backup_popup_count = g.OpenPopupStack.Size;
+        ImGuiWindow* backup_nav_window = g.NavWindow;
+
+        // Disturb state: move window, open popup, hold a button
+        vars.Step = 1;
+        ctx->Yield();
+        ctx->SetRef("Test Window");
+        ctx->WindowMove("", backup_pos + ImVec2(50.0f, 50.0f));
+        ctx->ItemClick("Open");
+        IM_CHECK_EQ(g.OpenPopupStack.Size, backup_popup_count + 1);
+        ImGui::SetActiveID(ctx->GetID("Button"), window);
+        IM_CHECK_NE(g.ActiveId, 0u);
+        IM_CHECK(window->Pos.x != backup_pos.x || window->Pos.y != backup_pos.y);
+
+        // Restore between frames (as done at the end of a test)
+        vars.Step = 0;
+        ctx->Engine->UiContextSnapshotToRestore = &snapshot;
+        ctx->Yield();
+        IM_CHECK(ctx->Engine->UiContextSnapshotToRestore == NULL);
+        IM_CHECK_EQ(g.ActiveId, 0u);
+        IM_CHECK_EQ(g.OpenPopupStack.Size, backup_popup_count);
+        IM_CHECK_EQ(window->Pos, backup_pos);
+        IM_CHECK(g.NavWindow == backup_nav_window);
+
+        // Window submitted in the frame preceding the restore is appearing in the frame following it
+        vars.Step = 1;
+        ctx->Yield(2);
+        const int appearing_count = vars.Count;
+        ctx->Engine->UiContextSnapshotToRestore = &snapshot;
+        ctx->Yield();
+        IM_CHECK_EQ(vars.Count, appearing_count + 1);
+        vars.Step = 0;
+    };
+
+    // ## Test virtual clock: Sleep() at normal speed takes a fixed number of frames
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_virtual_clock");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiContext& g = *ctx->UiContext;
+        ImGuiTestEngineIO* engine_io = ctx->EngineIO;
+        TestSuiteEngineIOBackup backup_engine_io(engine_io);
+        engine_io->ConfigRunSpeed = ImGuiTestRunSpeed_Normal;
+        engine_io->ConfigVirtualClock = true;
+        engine_io->ConfigVirtualClockDeltaTime = 1.0f / 64.0f; // Exactly representable
+        ctx->Yield(2);
+        IM_CHECK(engine_io->IsUsingVirtualClock);
+        IM_CHECK_EQ(g.IO.DeltaTime, 1.0f / 64.0f);
+
+        const int frame_count = g.FrameCount;
+        const double time = g.Time;
+        ctx->Sleep(0.25f);
+        IM_CHECK_EQ(g.FrameCount - frame_count, 16);
+        IM_CHECK_EQ(g.Time - time, 0.25);
+    };
+
+    // ## Test timestamped input queue: typing faster than framerate applies several characters per frame, in order
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_input_queue_timestamps");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::InputText("Input", ctx->GenericVars.Str1, IM_ARRAYSIZE(ctx->GenericVars.Str1));
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiContext& g = *ctx->UiContext;
+        ImGuiTestEngineIO* engine_io = ctx->EngineIO;
+        TestSuiteEngineIOBackup backup_engine_io(engine_io);
+        engine_io->ConfigRunSpeed = ImGuiTestRunSpeed_Normal;
+        engine_io->ConfigVirtualClock = true;
+        engine_io->ConfigVirtualClockDeltaTime = 1.0f / 64.0f;
+        engine_io->TypingSpeed = 64.0f * 4.0f; // 4 characters per frame
+
+        ctx->SetRef("Test Window");
+        ctx->ItemClick("Input");
+        const int frame_count = g.FrameCount;
+        ctx->KeyChars("abcdefghijklmnop");
+        IM_CHECK_STR_EQ(ctx->GenericVars.Str1, "abcdefghijklmnop");
+        IM_CHECK_LE(g.FrameCount - frame_count, 4 + 2);
+
+        // Fast mode: everything applied on next frame
+        engine_io->ConfigRunSpeed = ImGuiTestRunSpeed_Fast;
+        ctx->KeyCharsAppend("qrst");
+        IM_CHECK_STR_EQ(ctx->GenericVars.Str1, "abcdefghijklmnopqrst");
+    };
+
+    // ## Test deferred log formatting: output is identical, arguments are captured at the time of logging
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_log_deferred");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestEngineIO* engine_io = ctx->EngineIO;
+        ImGuiTestLog* log = &ctx->TestOutput->Log;
+        TestSuiteEngineIOBackup backup_engine_io(engine_io);
+        engine_io->ConfigLogDeferredFormatting = true;
+
+        char str[16] = "temporary";
+        ctx->LogInfo("Deferred: %d %s %.2f %%", 42, str, 1.5f);
+        strcpy(str, "modified");
+        ctx->LogInfo("Deferred: %.*s|%-4s|%*d|%s", 3, "abcdef", "x", 3, 7, (const char*)NULL);
+        ctx->LogInfo("Deferred: %lld %zu %c %08X", (long long)-5, (size_t)99, 'z', 0xBEEF);
+
+        ImGuiTextBuffer buf;
+        log->ExtractLinesForVerboseLevels(ImGuiTestVerboseLevel_Info, ImGuiTestVerboseLevel_Info, &buf);
+        IM_CHECK(log->DeferredData.empty());
+        IM_CHECK(strstr(buf.c_str(), "Deferred: 42 temporary 1.50 %\n") != NULL);
+        IM_CHECK(strstr(buf.c_str(), "Deferred: abc|x   |  7|(null)\n") != NULL);
+        IM_CHECK(strstr(buf.c_str(), "Deferred: -5 99 z 0000BEEF\n") != NULL);
+    };
+
+    // ## Test asynchronous log output queue: pushing never blocks, flushing writes everything
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_log_async_output");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestEngine* engine = ctx->Engine;
+        ImGuiTestLogOutputQueue* queue = &engine->LogOutput;
+        ImGuiTestEngine_FlushLogOutput(engine);
+        IM_CHECK(queue->IsEmpty());
+
+        // Use debugger target to avoid cluttering console output
+        for (int n = 0; n < 100; n++)
+            ImGuiTestEngine_PushLogOutput(engine, ImGuiTestLogOutputTarget_Debugger, ImGuiTestVerboseLevel_Debug, "[debug] ", "testengine_log_async_output\n");
+        IM_CHECK(queue->Thread != nullptr);
+        ImGuiTestEngine_FlushLogOutput(engine);
+        IM_CHECK(queue->IsEmpty());
+        IM_CHECK(queue->Tail == &queue->Stub);
+    };
+
+    // ## Test arena allocator used for transient per-test allocations
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_arena");
+    struct ArenaTestVars { int Value = 42; ImVector<int> Values; };
+    t->SetVarsDataType<ArenaTestVars>();
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        // UserVars are constructed in the arena
+        ArenaTestVars& vars = ctx->GetVars<ArenaTestVars>();
+        IM_CHECK(ctx->Arena->Contains(&vars));
+        IM_CHECK_EQ(vars.Value, 42);
+        vars.Values.push_back(1); // Freed by destructor
+
+        ImGuiTestArena arena;
+        arena._ChunkSize = 1024;
+        void* p1 = arena.Alloc(10);
+        void* p2 = arena.Alloc(4, 4);
+        IM_CHECK(((size_t)p1 & 15) == 0 && ((size_t)p2 & 3) == 0);
+        IM_CHECK(p1 != p2);
+        IM_CHECK_EQ(arena.AllocCount, 2);
+        IM_CHECK_EQ(arena.ChunkAllocCount, 1);
+
+        // Rewind to marker: same storage is reused
+        ImGuiTestArenaMarker marker = arena.GetMarker();
+        void* p3 = arena.Alloc(100);
+        arena.ResetToMarker(marker);
+        IM_CHECK(arena.Alloc(100) == p3);
+
+        // Large allocation gets its own chunk
+        IM_CHECK(arena.Alloc(4096) != nullptr);
+        IM_CHECK_EQ(arena.ChunkAllocCount, 2);
+
+        // Reset: chunks are kept, no more heap allocations
+        const size_t peak_bytes = arena.PeakBytes;
+        arena.Reset();
+        IM_CHECK_EQ(arena.GetUsedBytes(), (size_t)0);
+        IM_CHECK(arena.Alloc(10) == p1);
+        IM_CHECK(arena.Alloc(2000) != nullptr);
+        IM_CHECK(arena.Alloc(2000) != nullptr);
+        IM_CHECK_EQ(arena.ChunkAllocCount, 2);
+        IM_CHECK_EQ(arena.PeakBytes, peak_bytes);
+
+        // Trim: chunk dedicated to large allocation is released
+        arena.Reset();
+        arena.Trim();
+        IM_CHECK_EQ(arena.GetReservedBytes(), arena._ChunkSize);
+        IM_CHECK(arena.Alloc(10) == p1);
+        arena.Clear();
+        IM_CHECK_EQ(arena.GetReservedBytes(), (size_t)0);
+    };
+
     // ## Test using Item functions on windows
 #if IMGUI_VERSION_NUM >= 18616
     t = IM_REGISTER_TEST(e, "testengine", "testengine_ref_window");
@@ -6377,6 +6657,93 @@ void RegisterTests_TestEngine(ImGuiTestEngine* e)
 #endif
     };
 
+    // ## Test wildcard search on clipped items, without scrolling
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_ref_wildcard_clipped");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::SetNextWindowSize(ImVec2(300, 200));
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::BeginChild("Child", ImVec2(0, 80), ImGuiChildFlags_Borders);
+        for (int n = 0; n < 50; n++)
+            ImGui::Button(Str16f("Button %d", n).c_str());
+        ImGui::EndChild();
+        ImGuiListClipper clipper;
+        clipper.Begin(1000);
+        while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+                ImGui::Selectable(Str16f("Item %d", n).c_str());
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->SetRef("Test Window");
+        ImGuiWindow* window = ctx->GetWindowByRef("");
+        ImGuiWindow* child_window = ctx->WindowInfo("Child").Window;
+        IM_CHECK_SILENT(window != NULL && child_window != NULL);
+
+        const int frame_count_start = ctx->UiContext->FrameCount;
+        ImGuiTestItemInfo item = ctx->ItemInfo("**/Item 900");
+        IM_CHECK_EQ(item.ID, ctx->GetID("Item 900"));
+        item = ctx->ItemInfo("**/Button 45");
+        IM_CHECK_EQ(item.ID, ctx->GetID("Button 45", child_window->ID));
+        IM_CHECK_LE(ctx->UiContext->FrameCount - frame_count_start, 20);
+        IM_CHECK_EQ(window->Scroll.y, 0.0f);
+        IM_CHECK_EQ(child_window->Scroll.y, 0.0f);
+        IM_CHECK(ctx->UiContext->LogEnabled == false);
+    };
+
+    // ## Test wildcard search resolved from label index (io.ConfigLabelIndex)
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_ref_wildcard_label_index");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        auto& vars = ctx->GenericVars;
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::PushID("node");
+        ImGui::Checkbox("Unique", &vars.Bool1);
+        ImGui::PopID();
+        for (int n = 0; n < 2; n++)
+        {
+            ImGui::PushID(n);
+            ImGui::Checkbox("Twice", &vars.Bool2);
+            ImGui::PopID();
+        }
+        ImGui::End();
+
+        if (vars.Step == 0)
+        {
+            ImGui::Begin("Other Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+            ImGui::Button("Other");
+            ImGui::End();
+        }
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        auto& vars = ctx->GenericVars;
+        const bool backup_label_index = ctx->EngineIO->ConfigLabelIndex;
+        ctx->EngineIO->ConfigLabelIndex = true;
+        ctx->Yield(2);
+
+        ctx->SetRef("Test Window");
+        IM_CHECK_EQ(ctx->ItemInfo("**/Unique").ID, ctx->GetID("node/Unique"));
+
+        // Second query: wildcard resolved from label index + ItemInfo() result already available = no yield
+        const int frame_count_start = ctx->UiContext->FrameCount;
+        IM_CHECK_EQ(ctx->ItemInfo("**/node/Unique").ID, ctx->GetID("node/Unique"));
+        IM_CHECK_EQ(ctx->UiContext->FrameCount - frame_count_start, 0);
+
+        // Ambiguous: resolved by regular search, which returns first submitted item
+        IM_CHECK_EQ(ctx->ItemInfo("**/Twice").ID, ctx->GetID("$$0/Twice"));
+
+        // Closed window are invalidated
+        ctx->SetRef("");
+        IM_CHECK_NE(ctx->ItemInfo("//Other Window/**/Other").ID, 0u);
+        vars.Step = 1;
+        ctx->Yield(2);
+        IM_CHECK_EQ(ctx->ItemInfo("//Other Window/**/Other", ImGuiTestOpFlags_NoError).ID, 0u);
+
+        ctx->EngineIO->ConfigLabelIndex = backup_label_index;
+    };
+
     // ## Test ctx->WindowInfo().
     t = IM_REGISTER_TEST(e, "testengine", "testengine_ref_windowinfo");
     t->GuiFunc = [](ImGuiTestContext* ctx)
@@ -6781,6 +7148,58 @@ void RegisterTests_TestEngine(ImGuiTestEngine* e)
         IM_CHECK_STR_EQ(buf_large, "Hello World");
     };
 
+    // ## Test ItemInfoBatch() resolving many items in a constant number of frames
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_ref_batch");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        for (int n = 0; n < 100; n++)
+        {
+            ImGui::PushID(n);
+            ImGui::Button("Button");
+            ImGui::PopID();
+        }
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->SetRef("Test Window");
+        ctx->Yield();
+
+        ImGuiTestRef refs[102];
+        ImGuiTestItemInfo items[IM_ARRAYSIZE(refs)];
+        for (int n = 0; n < 100; n++)
+            refs[n] = ctx->GetID("Button", ctx->GetIDByInt(n));
+        refs[100] = "**/Button";
+        refs[101] = "Missing";
+
+        const int frame_count_start = ctx->UiContext->FrameCount;
+        int found_count = ctx->ItemInfoBatch(refs, 100, items);
+        IM_CHECK_EQ(found_count, 100);
+        IM_CHECK_LE(ctx->UiContext->FrameCount - frame_count_start, 3);
+        ImGuiWindow* window = ctx->GetWindowByRef("");
+        for (int n = 0; n < 100; n++)
+        {
+            IM_CHECK_EQ(items[n].ID, refs[n].ID);
+            IM_CHECK(items[n].Window == window);
+        }
+
+        // Wildcard refs and missing items
+        found_count = ctx->ItemInfoBatch(refs + 98, 4, items, ImGuiTestOpFlags_NoError);
+        IM_CHECK_EQ(found_count, 3);
+        IM_CHECK_EQ(items[2].ID, ctx->GetID("Button", ctx->GetIDByInt(0))); // First match
+        IM_CHECK_EQ(items[3].ID, 0u);
+        IM_CHECK(!ctx->IsError());
+
+        // Missing items are given up on after as many frames as with ItemInfo()
+        int frame_count_before = ctx->UiContext->FrameCount;
+        IM_CHECK_EQ(ctx->ItemInfo(refs[101], ImGuiTestOpFlags_NoError).ID, 0u);
+        const int item_info_frames = ctx->UiContext->FrameCount - frame_count_before;
+        frame_count_before = ctx->UiContext->FrameCount;
+        IM_CHECK_EQ(ctx->ItemInfoBatch(refs + 101, 1, items, ImGuiTestOpFlags_NoError), 0);
+        IM_CHECK_EQ(ctx->UiContext->FrameCount - frame_count_before, item_info_frames);
+    };
+
     // ## Test hash functions and ##/### operators
     t = IM_REGISTER_TEST(e, "testengine", "testengine_hash_001");
     t->TestFunc = [](ImGuiTestContext* ctx)
@@ -6983,6 +7402,47 @@ void RegisterTests_TestEngine(ImGuiTestEngine* e)
         }
     };
 
+    // ## Test GatherItemsBatch() and concurrent wildcard queries in ItemInfoBatch()
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_gather_batch");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings);
+        for (int n = 0; n < 3; n++)
+        {
+            ImGui::PushID(n);
+            if (ImGui::TreeNodeEx("Node", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                ImGui::Button(Str16f("Button%d", n).c_str());
+                ImGui::Button("Common");
+                ImGui::TreePop();
+            }
+            ImGui::PopID();
+        }
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->SetRef("Test Window");
+        const ImGuiTestRef parents[3] = { ctx->GetID("$$0/Node"), ctx->GetID("$$1/Node"), ctx->GetID("$$2/Node") };
+        ImGuiTestItemList lists[3];
+        ctx->GatherItemsBatch(lists, parents, 3, 1);
+        for (int n = 0; n < 3; n++)
+        {
+            ctx->LogItemList(&lists[n]);
+            IM_CHECK_EQ(lists[n].GetSize(), 2);
+            IM_CHECK(lists[n].GetByID(ctx->GetID(Str16f("$$%d/Node/Button%d", n, n).c_str())) != NULL);
+            IM_CHECK(lists[n].GetByID(ctx->GetID(Str16f("$$%d/Node/Common", n).c_str())) != NULL);
+        }
+
+        const ImGuiTestRef refs[3] = { "**/Button0", "**/Button1", "**/Button2" };
+        ImGuiTestItemInfo items[3];
+        const int frame_count_start = ctx->UiContext->FrameCount;
+        IM_CHECK_EQ(ctx->ItemInfoBatch(refs, 3, items), 3);
+        IM_CHECK_LE(ctx->UiContext->FrameCount - frame_count_start, 4);
+        for (int n = 0; n < 3; n++)
+            IM_CHECK_EQ(items[n].ID, ctx->GetID(Str16f("$$%d/Node/Button%d", n, n).c_str()));
+    };
+
     // ## Test for combo functions
     t = IM_REGISTER_TEST(e, "testengine", "testengine_combo");
     t->GuiFunc = [](ImGuiTestContext* ctx)
@@ -6,8 +6,11 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "imgui.h"
 #include "imgui_internal.h"
+#include "imgui_test_suite.h"
 #include "imgui_test_engine/imgui_te_engine.h"      // IM_REGISTER_TEST()
 #include "imgui_test_engine/imgui_te_context.h"
+#include "imgui_test_engine/imgui_te_coroutine.h"
+#include "imgui_test_engine/imgui_te_utils.h"       // ImTimeGetInMicroseconds()
 #include "imgui_test_engine/thirdparty/Str/Str.h"
 
 // Warnings
@@ -392,6 +395,121 @@ void RegisterTests_Perf(ImGuiTestEngine* e)
     };
     t->TestFunc = PerfCaptureFunc;
 
+    // ## Measure the cost of test engine hooks on simple Button() calls, without then with an active query
+    // (without queries the hooks are disabled, with a query every item goes through ItemAdd/ItemInfo hooks)
+    auto HooksGuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Func", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        if (ctx->GenericVars.Bool1)
+            ImGuiTestEngine_FindItemDebugLabel(ctx->UiContext, ImGui::GetID("Never Submitted")); // Keep an info query alive
+        int loop_count = 1000 * ctx->PerfStressAmount;
+        for (int n = 0; n < loop_count; n++)
+            ImGui::Button("Hello, world");
+        ImGui::End();
+    };
+    t = IM_REGISTER_TEST(e, "perf", "perf_stress_hooks_no_queries");
+    t->GuiFunc = HooksGuiFunc;
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->GenericVars.Bool1 = false;
+        ctx->PerfCapture();
+    };
+
+    t = IM_REGISTER_TEST(e, "perf", "perf_stress_hooks_with_queries");
+    t->GuiFunc = HooksGuiFunc;
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->GenericVars.Bool1 = true;
+        ctx->PerfCapture();
+        IM_CHECK(ctx->UiContext->TestEngineHookItems);
+    };
+
+    // ## Measure Run()+Yield() round-trips per second of available coroutine implementations
+    // (test engine does one round-trip per frame for the test queue coroutine)
+    t = IM_REGISTER_TEST(e, "perf", "perf_coroutine_yields");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        struct BenchData { ImGuiTestCoroutineInterface* Intf; int Remaining; };
+        struct BenchImpl { const char* Name; ImGuiTestCoroutineInterface* Intf; };
+        const BenchImpl impls[] =
+        {
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+            { "StdThread", Coroutine_ImplStdThread_GetInterface() },
+#endif
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+            { "UContext", Coroutine_ImplUContext_GetInterface() },
+#endif
+            { "Current", ctx->EngineIO->CoroutineFuncs },           // Only measured when application provides its own implementation
+        };
+        const int yields_count = 20000 * ctx->PerfStressAmount;
+        for (int impl_n = 0; impl_n < IM_ARRAYSIZE(impls); impl_n++)
+        {
+            // Don't measure the same implementation twice
+            const BenchImpl& impl = impls[impl_n];
+            bool is_duplicate = false;
+            for (int prev_impl_n = 0; prev_impl_n < impl_n; prev_impl_n++)
+                is_duplicate |= (impls[prev_impl_n].Intf->RunFunc == impl.Intf->RunFunc);
+            if (is_duplicate)
+                continue;
+
+            BenchData data = { impl.Intf, yields_count };
+            ImGuiTestCoroutineHandle handle = impl.Intf->CreateFunc([](void* user_data)
+            {
+                BenchData* data = (BenchData*)user_data;
+                while (data->Remaining-- > 0)
+                    data->Intf->YieldFunc();
+            }, "Bench Coroutine", &data);
+            IM_CHECK_SILENT(handle != NULL);
+
+            int run_count = 0;
+            const ImU64 t0 = ImTimeGetInMicroseconds();
+            while (impl.Intf->RunFunc(handle))
+                run_count++;
+            const ImU64 t1 = ImTimeGetInMicroseconds();
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+            if (impl.Intf->RunFunc == Coroutine_ImplStdThread_GetInterface()->RunFunc)
+            {
+                ImGuiTestCoroutineHandoffStats stats;
+                Coroutine_ImplStdThread_GetHandoffStats(handle, &stats);
+                ctx->LogInfo("[PERF] Coroutine %-10s: %llu handoffs (%llu spin, %llu park), latency avg %.0f ns, max %.0f ns", impl.Name,
+                    stats.HandoffCount, stats.SpinHandoffCount, stats.ParkHandoffCount, (double)stats.LatencyTotalNs / ImMax(stats.HandoffCount, (ImU64)1), (double)stats.LatencyMaxNs);
+            }
+#endif
+            impl.Intf->DestroyFunc(handle);
+
+            IM_CHECK_EQ(run_count, yields_count);
+            const double elapsed_sec = ImMax((double)(t1 - t0), 1.0) / 1000000.0;
+            ctx->LogInfo("[PERF] Coroutine %-10s: %d yields in %.3f ms, %.0f yields/sec", impl.Name, run_count, elapsed_sec * 1000.0, run_count / elapsed_sec);
+        }
+    };
+
+    // ## Measure wall time of a fixed batch of tests with and without skipping rendering of frames which don't need rendered output
+    // (requires application to honor ImGuiTestEngineIO::IsRequestingSkipRender, as our test suite does. Most visible with null backend + -nothrottle)
+    t = IM_REGISTER_TEST(e, "perf", "perf_skip_render");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        static const char* batch_test_names[] =
+        {
+            "widgets_button_press", "widgets_button_mouse_buttons", "widgets_button_status", "widgets_checkbox_001",
+            "widgets_dragslider_clamp", "widgets_inputscalar_step", "widgets_tabbar_select", "widgets_tabbar_order",
+        };
+        TestSuiteEngineIOBackup backup_engine_io(ctx->EngineIO);
+        const int batch_count = IM_ARRAYSIZE(batch_test_names) * ctx->PerfStressAmount;
+        double elapsed_ms[2] = {};
+        for (int pass = 0; pass < 2; pass++)
+        {
+            ctx->EngineIO->ConfigSkipRender = (pass == 1);
+            const ImU64 t0 = ImTimeGetInMicroseconds();
+            for (int repeat_n = 0; repeat_n < ctx->PerfStressAmount; repeat_n++)
+                for (const char* test_name : batch_test_names)
+                    IM_CHECK(ctx->RunChildTest(test_name) == ImGuiTestStatus_Success);
+            const ImU64 t1 = ImTimeGetInMicroseconds();
+            elapsed_ms[pass] = (double)(t1 - t0) / 1000.0;
+            ctx->LogInfo("[PERF] Skip render %-3s: %d tests in %.3f ms", pass ? "on" : "off", batch_count, elapsed_ms[pass]);
+        }
+        ctx->LogInfo("[PERF] Skip render: x%.2f speedup", elapsed_ms[0] / ImMax(elapsed_ms[1], 0.001));
+    };
+
     // ## Measure the cost of simple Button() calls + BeginDisabled()/EndDisabled()
     t = IM_REGISTER_TEST(e, "perf", "perf_stress_button_disabled");
     t->GuiFunc = [](ImGuiTestContext* ctx)
@@ -6,6 +6,7 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "imgui.h"
 #include "imgui_internal.h"
+#include "imgui_test_suite.h"
 #include "imgui_test_engine/imgui_te_engine.h"      // IM_REGISTER_TEST()
 #include "imgui_test_engine/imgui_te_context.h"
 #include "imgui_test_engine/imgui_te_utils.h"       // InputText() with Str
@@ -1761,6 +1762,48 @@ void RegisterTests_WidgetsInputText(ImGuiTestEngine* e)
             ctx->KeyPress(ImGuiKey_Escape);
         }
     };
+
+    // ## Measure injecting a large text (1 MB) with KeyChars(), then the cost of a frame with it in an InputTextMultiline()
+    t = IM_REGISTER_TEST(e, "perf", "perf_inputtext_multiline_large_input");
+    t->SetVarsDataType<StrVars>();
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        StrVars& vars = ctx->GetVars<StrVars>();
+        ImGui::SetNextWindowSize(ImVec2(ImGui::GetFontSize() * 50, 0.0f));
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::InputTextMultiline("Field", &vars.str, ImVec2(-1, ImGui::GetFontSize() * 20));
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        StrVars& vars = ctx->GetVars<StrVars>();
+
+        // Build text. Codepoints above 0xFFFF are only preserved with IMGUI_USE_WCHAR32.
+        ImGuiTextBuffer text;
+        text.reserve(1024 * 1024 + 128);
+        for (int line_n = 0; text.size() < 1024 * 1024; line_n++)
+#ifdef IMGUI_USE_WCHAR32
+            text.appendf("Line %06d: The quick brown fox jumps over the lazy dog \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\n", line_n);
+#else
+            text.appendf("Line %06d: The quick brown fox jumps over the lazy dog \xC3\xA9\xE2\x82\xAC\n", line_n);
+#endif
+
+        // Inject in fast mode, as typing 1 MB at TypingSpeed would take hours
+        {
+            TestSuiteEngineIOBackup backup_engine_io(ctx->EngineIO);
+            ctx->EngineIO->ConfigRunSpeed = ImGuiTestRunSpeed_Fast;
+            ctx->SetRef("Test Window");
+            ctx->ItemClick("Field");
+            const ImU64 t0 = ImTimeGetInMicroseconds();
+            ctx->KeyChars(text.c_str());
+            const ImU64 t1 = ImTimeGetInMicroseconds();
+            ctx->LogInfo("KeyChars(): injected %d bytes in %.2f ms", text.size(), (t1 - t0) / 1000.0);
+        }
+        IM_CHECK_EQ(vars.str.length(), text.size());
+        IM_CHECK(strcmp(vars.str.c_str(), text.c_str()) == 0);
+
+        ctx->PerfCapture();
+    };
 }
 
 #if IMGUI_VERSION_NUM < 19143
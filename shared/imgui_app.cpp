@@ -178,6 +178,14 @@ static bool ImGuiApp_ImplNull_NewFrame(ImGuiApp* app_opaque)
     //int height = 0;
     //io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
 
+    // Virtual clock
+    if (app->FixedDeltaTime > 0.0f)
+    {
+        io.DeltaTime = app->FixedDeltaTime;
+        app->LastTime = 0;
+        return true;
+    }
+
     uint64_t time = ImGuiApp_GetTimeInMicroseconds();
     if (app->LastTime == 0)
         app->LastTime = time;
@@ -28,6 +28,7 @@ struct ImGuiApp
     bool    Quit = false;                               // [In]  NewFrame()
     ImVec4  ClearColor = { 0.f, 0.f, 0.f, 1.f };        // [In]  Render()
     bool    MockViewports = false;                      // [In]  InitBackends()
+    float   FixedDeltaTime = 0.0f;                      // [In]  NewFrame() Null backend: use as io.DeltaTime instead of measuring wall clock, when non-zero
     float   DpiScale = 1.0f;                            // [Out] InitCreateWindow() / NewFrame()
     bool    Vsync = true;                               // [Out] Render()
 